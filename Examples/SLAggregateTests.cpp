@@ -0,0 +1,148 @@
+//
+// Aggregate list tests
+//
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "SwiftyAggregateList.hpp"
+
+/**
+ * Keeps first and last value of the range, checks that blocks are combined in logical order
+ */
+struct EndsMonoid {
+    struct Value {
+        int    first;
+        int    last;
+        size_t count;
+    };
+
+    static Value identity() { return {0, 0, 0}; }
+
+    static Value of(const int &value) { return {value, value, 1}; }
+
+    static Value combine(const Value &left, const Value &right) {
+        if (left.count == 0)
+            return right;
+        if (right.count == 0)
+            return left;
+        return {left.first, right.last, left.count + right.count};
+    }
+};
+
+TEST(SwiftyAggregateListTests, rangeSums) {
+    SwiftyAggregateList<long long> list;
+    std::vector<long long> reference;
+    for (long long i = 0; i < 1000; i++) {
+        list.pushBack(i);
+        reference.push_back(i);
+    }
+    long long sum = 0;
+    EXPECT_TRUE(list.aggregate(0, 1000, &sum) == LIST_OP_OK);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+    EXPECT_TRUE(list.aggregate(10, 20, &sum) == LIST_OP_OK);
+    EXPECT_EQ(sum, 145);
+    EXPECT_TRUE(list.aggregate(5, 5, &sum) == LIST_OP_OK);
+    EXPECT_EQ(sum, 0);
+    EXPECT_TRUE(list.aggregate(5, 1001, &sum) == LIST_OP_OVERFLOW);
+    EXPECT_TRUE(list.aggregate(6, 5, &sum) == LIST_OP_OVERFLOW);
+
+    EXPECT_TRUE(list.setLogic(500, -1000) == LIST_OP_OK);
+    EXPECT_TRUE(list.aggregate(499, 502, &sum) == LIST_OP_OK);
+    EXPECT_EQ(sum, 499 - 1000 + 501);
+    EXPECT_TRUE(list.removeLogic(0) == LIST_OP_OK);
+    long long value = 0;
+    EXPECT_TRUE(list.getLogic(0, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(list.getLogic(999, &value) == LIST_OP_OVERFLOW);
+    EXPECT_TRUE(list.clear() == LIST_OP_OK);
+    EXPECT_TRUE(list.aggregate(0, 0, &sum) == LIST_OP_OK);
+    EXPECT_EQ(sum, 0);
+}
+
+TEST(SwiftyAggregateListTests, randomAgainstReference) {
+    std::mt19937 rnd(11);
+    SwiftyAggregateList<int, SwiftyMinMonoid<int>> minList;
+    SwiftyAggregateList<int, EndsMonoid> endsList;
+    std::vector<int> reference;
+
+    for (int step = 0; step < 20000; step++) {
+        size_t size = reference.size();
+        int op = rnd() % 10;
+        int value = (int) (rnd() % 100000);
+        if (op < 5 || size == 0) {
+            size_t logic = size == 0 ? 0 : rnd() % (size + 1);
+            size_t minPos = 0, endsPos = 0;
+            if (logic == 0) {
+                ASSERT_TRUE(minList.pushFront(value, &minPos) == LIST_OP_OK);
+                ASSERT_TRUE(endsList.pushFront(value, &endsPos) == LIST_OP_OK);
+            } else {
+                size_t after = 0;
+                minList.logicToPhysic(logic - 1, &after);
+                ASSERT_TRUE(minList.insertAfter(after, value, &minPos) == LIST_OP_OK);
+                endsList.logicToPhysic(logic - 1, &after);
+                ASSERT_TRUE(endsList.insertAfter(after, value, &endsPos) == LIST_OP_OK);
+            }
+            reference.insert(reference.begin() + logic, value);
+        } else if (op < 7) {
+            size_t logic = rnd() % size;
+            size_t pos = 0;
+            int popped = 0;
+            minList.logicToPhysic(logic, &pos);
+            ASSERT_TRUE(minList.pop(pos, &popped) == LIST_OP_OK);
+            EXPECT_EQ(popped, reference[logic]);
+            ASSERT_TRUE(endsList.removeLogic(logic) == LIST_OP_OK);
+            reference.erase(reference.begin() + logic);
+        } else if (op < 8) {
+            size_t logic = rnd() % size;
+            size_t pos = 0;
+            minList.logicToPhysic(logic, &pos);
+            ASSERT_TRUE(minList.set(pos, value) == LIST_OP_OK);
+            ASSERT_TRUE(endsList.setLogic(logic, value) == LIST_OP_OK);
+            reference[logic] = value;
+        } else if (op < 9) {
+            size_t first = rnd() % size, second = rnd() % size;
+            size_t firstPos = 0, secondPos = 0;
+            minList.logicToPhysic(first, &firstPos);
+            minList.logicToPhysic(second, &secondPos);
+            ASSERT_TRUE(minList.swap(firstPos, secondPos) == LIST_OP_OK);
+            endsList.logicToPhysic(first, &firstPos);
+            endsList.logicToPhysic(second, &secondPos);
+            ASSERT_TRUE(endsList.swap(firstPos, secondPos) == LIST_OP_OK);
+            std::swap(reference[first], reference[second]);
+        } else if (step % 500 == 9) {
+            ASSERT_TRUE(minList.optimize() == LIST_OP_OK);
+        }
+
+        if (reference.empty())
+            continue;
+        size_t from = rnd() % reference.size();
+        size_t to = from + rnd() % (reference.size() - from) + 1;
+        int min = 0;
+        ASSERT_TRUE(minList.aggregate(from, to, &min) == LIST_OP_OK);
+        ASSERT_EQ(min, *std::min_element(reference.begin() + from, reference.begin() + to)) << "step " << step;
+        EndsMonoid::Value ends = {};
+        ASSERT_TRUE(endsList.aggregate(from, to, &ends) == LIST_OP_OK);
+        ASSERT_EQ(ends.count, to - from);
+        ASSERT_EQ(ends.first, reference[from]);
+        ASSERT_EQ(ends.last, reference[to - 1]);
+    }
+    EXPECT_EQ(minList.getSize(), reference.size());
+    for (size_t i = 0; i < reference.size(); i++) {
+        int value = 0;
+        ASSERT_TRUE(endsList.getLogic(i, &value) == LIST_OP_OK);
+        ASSERT_EQ(value, reference[i]);
+    }
+    EXPECT_TRUE(minList.getList().checkUp() == LIST_OP_OK);
+
+    // draining shrinks blocks back
+    while (reference.size() > 10) {
+        size_t logic = rnd() % reference.size();
+        ASSERT_TRUE(minList.removeLogic(logic) == LIST_OP_OK);
+        reference.erase(reference.begin() + logic);
+        int min = 0;
+        ASSERT_TRUE(minList.aggregate(0, reference.size(), &min) == LIST_OP_OK);
+        ASSERT_EQ(min, *std::min_element(reference.begin(), reference.end()));
+    }
+}
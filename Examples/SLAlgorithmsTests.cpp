@@ -0,0 +1,177 @@
+//
+// Parallel algorithms tests
+//
+
+#include "gtest/gtest.h"
+#include <string>
+#include "SwiftyParallel.hpp"
+
+static void fillMixed(SwiftyList<int> &list, int count) {
+    for (int i = 0; i < count; i++) {
+        if (i % 2 == 1)
+            list.pushBack(i);
+        else
+            list.pushFront(i);
+    }
+}
+
+TEST(SwiftyParallelAlgorithmsTests, threadPool) {
+    SwiftyThreadPool pool(3);
+    EXPECT_EQ(pool.getThreadsCount(), 3);
+    std::atomic<size_t> done(0);
+    {
+        SwiftyThreadPool::TaskGroup group(pool);
+        for (size_t i = 0; i < 1000; i++) {
+            group.run([&]() {
+                SwiftyThreadPool::TaskGroup nested(pool);
+                nested.run([&]() { done++; });
+                nested.wait();
+            });
+        }
+        group.wait();
+    }
+    EXPECT_EQ(done.load(), 1000);
+}
+
+TEST(SwiftyParallelAlgorithmsTests, bothModes) {
+    SwiftyThreadPool pool(4);
+    for (int size : {0, 1, 100, 5000, 100000}) {
+        SwiftyList<int> list(0, 0, nullptr, false);
+        fillMixed(list, size);
+        for (int mode = 0; mode < 2; mode++) {
+            if (mode == 1)
+                list.optimize();
+            EXPECT_EQ(list.isOptimized(), mode == 1 || size < 3);
+
+            long long sum = -1;
+            EXPECT_TRUE(parallelReduce(list, &sum, 0LL, [](long long a, long long b) { return a + b; }, pool)
+                        == LIST_OP_OK);
+            EXPECT_EQ(sum, (long long) size * (size - 1) / 2);
+
+            size_t even = 0;
+            EXPECT_TRUE(parallelCountIf(list, &even, [](int v) { return v % 2 == 0; }, pool) == LIST_OP_OK);
+            EXPECT_EQ(even, (size_t) (size + 1) / 2);
+
+            std::string order;
+            std::string expected;
+            if (size <= 5000) {
+                parallelReduce(list, &order, std::string(), [](const std::string &a, const auto &b) {
+                    if constexpr (std::is_same<std::decay_t<decltype(b)>, int>::value)
+                        return a + std::to_string(b) + ",";
+                    else
+                        return a + b;
+                }, pool);
+                size_t iterator = list.begin();
+                for (int i = 0; i < size; i++) {
+                    int value = 0;
+                    list.get(iterator, &value);
+                    expected += std::to_string(value) + ",";
+                    iterator = list.nextIterator(iterator);
+                }
+                EXPECT_EQ(order, expected);
+            }
+
+            parallelTransform(list, [](int v) { return v * 2; }, pool);
+            parallelForEach(list, [](int &v) { v /= 2; }, pool);
+            sum = 0;
+            parallelReduce(list, &sum, 0LL, [](long long a, long long b) { return a + b; }, pool);
+            EXPECT_EQ(sum, (long long) size * (size - 1) / 2);
+        }
+        list.DestructList();
+    }
+}
+
+/**
+ * Key and insertion order of a sorted element
+ */
+struct SortItem {
+    int first;
+    int second;
+};
+
+TEST(SwiftyParallelAlgorithmsTests, sort) {
+    SwiftyThreadPool pool(4);
+    for (int size : {10, 5000, 100000}) {
+        SwiftyList<SortItem> list(0, 0, nullptr, false);
+        for (int i = 0; i < size; i++)
+            list.pushBack({rand() % 1000, i});
+        list.insertAfter(list.begin(), {-1, -1});
+        EXPECT_FALSE(list.isOptimized());
+
+        EXPECT_TRUE(parallelSort(list, [](const SortItem &a, const SortItem &b) {
+            return a.first < b.first;
+        }, pool) == LIST_OP_OK);
+        EXPECT_TRUE(list.isOptimized());
+        EXPECT_EQ(list.getSize(), (size_t) size + 1);
+        SortItem previous = {-2, -2};
+        for (int i = 0; i <= size; i++) {
+            SortItem value = {};
+            list.getLogic(i, &value);
+            EXPECT_TRUE(previous.first < value.first || (previous.first == value.first && previous.second < value.second));
+            previous = value;
+        }
+        list.DestructList();
+    }
+}
+
+/**
+ * Heap storage whose nodes the test can corrupt, laid out as SwiftyList<int> nodes
+ */
+struct CorruptibleStorage : SwiftyListStorageSource {
+    struct Node {
+        int    value;
+        size_t next;
+        size_t previous;
+        bool   valid;
+    };
+
+    Node *nodes = nullptr;
+
+    void *allocate(size_t bytes, size_t *actualBytes) override {
+        *actualBytes = bytes;
+        this->nodes = (Node *) malloc(bytes);
+        return this->nodes;
+    }
+
+    void release(void *storage) override {
+        free(storage);
+    }
+};
+
+TEST(SwiftyParallelAlgorithmsTests, validate) {
+    SwiftyThreadPool pool(4);
+    for (SwiftyListAllocPolicy policy : {LIST_ALLOC_LIFO, LIST_ALLOC_NEAREST}) {
+        CorruptibleStorage source;
+        SwiftyList<int> list(0, 0, nullptr, false);
+        ASSERT_TRUE(list.setStorageSource(&source) == LIST_OP_OK);
+        list.setAllocPolicy(policy);
+        fillMixed(list, 100000);
+        for (size_t pos = 1; pos <= 100000; pos += 5)
+            list.remove(pos);
+        for (int i = 0; i < 5000; i++)
+            list.pushBack(i);
+
+        SwiftyListValidation report = {LIST_INVARIANT_CAPACITY, 1};
+        EXPECT_TRUE(list.validate() == LIST_OP_OK);
+        EXPECT_TRUE(parallelValidate(list, &report, pool) == LIST_OP_OK);
+        EXPECT_EQ(report.invariant, LIST_INVARIANT_NONE);
+
+        // the lowest corrupted cell is reported even if a later chunk finishes first
+        size_t first = list.begin(), last = list.end();
+        size_t low = std::min(first, last), high = std::max(first, last);
+        source.nodes[high].previous = high;
+        source.nodes[low].next = low;
+        EXPECT_TRUE(parallelValidate(list, &report, pool) == LIST_OP_CORRUPTED);
+        EXPECT_EQ(report.invariant, LIST_INVARIANT_LINK_SYMMETRY);
+        SwiftyListValidation sequential = {};
+        list.validate(&sequential);
+        EXPECT_EQ(report.invariant, sequential.invariant);
+        EXPECT_EQ(report.pos, sequential.pos);
+        list.DestructList();
+    }
+
+    SwiftyList<int> optimized(0, 0, nullptr, false);
+    for (int i = 0; i < 100000; i++)
+        optimized.pushBack(i);
+    EXPECT_TRUE(parallelValidate(optimized, nullptr, pool) == LIST_OP_OK);
+}
@@ -0,0 +1,862 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "SwiftyList.hpp"
+#include "SwiftyPerfCounters.hpp"
+#include "SwiftyForwardList.hpp"
+#include "SwiftyFrozenList.hpp"
+#include "SwiftyLRU.hpp"
+#include "SwiftyStaticList.hpp"
+#include "SwiftyUnrolledList.hpp"
+
+const size_t benchMinSize     = 100;
+const size_t benchMaxSize     = 100000000;
+const size_t benchDefaultSize = 1000000;
+const size_t benchBatch       = 1024;
+const size_t benchIndexes     = 4096;
+const size_t benchLRUKeys     = 1 << 20;
+
+/**
+ * Cache line sized element
+ */
+struct Pod64 {
+    int64_t data[8];
+
+    bool operator==(const Pod64 &other) const {
+        return this->data[0] == other.data[0];
+    }
+
+    bool operator<(const Pod64 &other) const {
+        return this->data[0] < other.data[0];
+    }
+};
+
+template<typename T>
+T makeValue(size_t i);
+
+template<>
+int makeValue<int>(size_t i) {
+    return (int) i;
+}
+
+template<>
+Pod64 makeValue<Pod64>(size_t i) {
+    Pod64 value = {};
+    for (int64_t &word : value.data)
+        word = (int64_t) i;
+    return value;
+}
+
+template<typename T>
+const char *typeName();
+
+template<>
+const char *typeName<int>() {
+    return "int";
+}
+
+template<>
+const char *typeName<Pod64>() {
+    return "Pod64";
+}
+
+/**
+ * Random positions below size, generated once so that generation is not measured
+ */
+static std::vector<size_t> randomIndexes(size_t size, size_t count = benchIndexes) {
+    std::mt19937_64 generator(size);
+    std::vector<size_t> indexes(count);
+    for (size_t &index : indexes)
+        index = generator() % size;
+    return indexes;
+}
+
+/**
+ * Builds a list of size elements. De-optimized list is built by alternating
+ * pushFront and pushBack, so logical neighbours are far apart in the storage.
+ */
+template<typename T>
+static void fillList(SwiftyList<T> &list, size_t size, bool optimized) {
+    for (size_t i = 0; i < size; i++) {
+        if (optimized || i % 2 == 0)
+            list.pushBack(makeValue<T>(i));
+        else
+            list.pushFront(makeValue<T>(i));
+    }
+}
+
+/**
+ * Physical positions of the list elements in logical order
+ */
+template<typename T>
+static std::vector<size_t> physicalPositions(SwiftyList<T> &list) {
+    std::vector<size_t> positions;
+    size_t iterator = list.begin();
+    for (size_t i = 0; i < list.getSize(); i++) {
+        positions.push_back(iterator);
+        iterator = list.nextIterator(iterator);
+    }
+    return positions;
+}
+
+/**
+ * Hardware counters, opened in main() when SWIFTY_BENCH_PERF is set
+ */
+static SwiftyPerfCounters *benchCounters = nullptr;
+
+/**
+ * Counts hardware events of the benchmark loop and reports them per iteration.
+ * pause() and resume() also pause and resume benchmark timing.
+ */
+struct BenchPerf {
+    benchmark::State &state;
+    SwiftyPerfTotals totals;
+    SwiftyPerfSample begin;
+
+    explicit BenchPerf(benchmark::State &state) : state(state), totals(), begin() {
+        this->start();
+    }
+
+    ~BenchPerf() {
+        this->stop();
+        for (size_t i = 0; i < PERF_COUNTERS_COUNT; i++) {
+            if (this->totals.valid[i])
+                this->state.counters[perfCounterName((SwiftyPerfCounter) i)] =
+                        benchmark::Counter(this->totals.value[i], benchmark::Counter::kAvgIterations);
+        }
+    }
+
+    void start() {
+        if (benchCounters != nullptr)
+            benchCounters->sample(&this->begin);
+    }
+
+    void stop() {
+        if (benchCounters == nullptr)
+            return;
+        SwiftyPerfSample end;
+        benchCounters->sample(&end);
+        this->totals.add(this->begin, end);
+    }
+
+    void pause() {
+        this->stop();
+        this->state.PauseTiming();
+    }
+
+    void resume() {
+        this->state.ResumeTiming();
+        this->start();
+    }
+};
+
+template<typename T>
+static void listPushBack(benchmark::State &state, bool) {
+    size_t size = state.range(0);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        SwiftyList<T> list(0, 0, nullptr, false);
+        for (size_t i = 0; i < size; i++)
+            list.pushBack(makeValue<T>(i));
+        benchmark::DoNotOptimize(list.getSize());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename T>
+static void listPushFront(benchmark::State &state, bool) {
+    size_t size = state.range(0);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        SwiftyList<T> list(0, 0, nullptr, false);
+        for (size_t i = 0; i < size; i++)
+            list.pushFront(makeValue<T>(i));
+        benchmark::DoNotOptimize(list.getSize());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename T>
+static void listGet(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    std::vector<size_t> positions = physicalPositions(list);
+    std::vector<size_t> indexes = randomIndexes(positions.size());
+    size_t i = 0;
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.get(positions[indexes[i++ % benchIndexes]], &value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+static void listGetLogic(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    std::vector<size_t> indexes = randomIndexes(list.getSize());
+    size_t i = 0;
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.getLogic(indexes[i++ % benchIndexes], &value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+static void listSetLogic(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    std::vector<size_t> indexes = randomIndexes(list.getSize());
+    size_t i = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.setLogic(indexes[i % benchIndexes], makeValue<T>(i));
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+static void listGetLogicBatch(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    std::vector<size_t> indexes = randomIndexes(list.getSize(), benchBatch);
+    std::vector<T> values(benchBatch);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.getLogicBatch(indexes.data(), benchBatch, values.data());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * benchBatch);
+}
+
+template<typename T>
+static void listInsertRemove(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    std::vector<size_t> positions = physicalPositions(list);
+    std::vector<size_t> indexes = randomIndexes(positions.size());
+    size_t i = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        size_t inserted = 0;
+        size_t after = positions[indexes[i % benchIndexes]];
+        list.insertAfter(after, makeValue<T>(i), &inserted);
+        list.remove(inserted);
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename T>
+static void listInsertRemoveLogic(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    std::vector<size_t> indexes = randomIndexes(list.getSize());
+    size_t i = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        size_t pos = indexes[i++ % benchIndexes];
+        list.insertAfterLogic(pos, makeValue<T>(i));
+        list.removeLogic(pos + 1);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename T>
+static void listPopPushBack(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.popBack(&value);
+        list.pushBack(value);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename T>
+static void listPopPushFront(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.popFront(&value);
+        list.pushFront(value);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename T>
+static void listIterate(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        size_t iterator = list.begin();
+        for (size_t i = 0; i < list.getSize(); i++) {
+            list.get(iterator, &value);
+            benchmark::DoNotOptimize(value);
+            iterator = list.nextIterator(iterator);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename T>
+static void listSearch(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    T missing = makeValue<T>(list.getSize() + 1);
+    size_t pos = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.search(&pos, missing));
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename T>
+static void listCheckUp(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.checkUp());
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename T>
+static void listValidate(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.validate());
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename T>
+static void frozenSearch(benchmark::State &state, bool packed) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), true);
+    FrozenSwiftyList<T> frozen;
+    list.freeze(&frozen, packed);
+    T missing = makeValue<T>(list.getSize() + 1);
+    size_t pos = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frozen.searchLogic(&pos, missing));
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename T>
+static void frozenIterate(benchmark::State &state, bool packed) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), true);
+    FrozenSwiftyList<T> frozen;
+    list.freeze(&frozen, packed);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        frozen.forEach([](const T &value) { benchmark::DoNotOptimize(value); });
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename T>
+static void listOptimize(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        perf.pause();
+        list.clear();
+        fillList(list, state.range(0), optimized);
+        perf.resume();
+        list.optimize();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename T>
+static void listSort(benchmark::State &state, bool optimized) {
+    SwiftyList<T> source(0, 0, nullptr, false);
+    std::vector<size_t> indexes = randomIndexes(state.range(0), state.range(0));
+    for (size_t i = 0; i < indexes.size(); i++) {
+        if (optimized || i % 2 == 0)
+            source.pushBack(makeValue<T>(indexes[i]));
+        else
+            source.pushFront(makeValue<T>(indexes[i]));
+    }
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        perf.pause();
+        SwiftyList<T> list(source);
+        perf.resume();
+        list.sort();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Unrolled list built the same way as the de-optimized SwiftyList
+ */
+template<typename T>
+static void fillUnrolled(SwiftyUnrolledList<T> &list, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (i % 2 == 0)
+            list.pushBack(makeValue<T>(i));
+        else
+            list.pushFront(makeValue<T>(i));
+    }
+}
+
+template<typename T>
+static void unrolledGetLogic(benchmark::State &state) {
+    SwiftyUnrolledList<T> list(0, false);
+    fillUnrolled(list, state.range(0));
+    std::vector<size_t> indexes = randomIndexes(list.getSize());
+    size_t i = 0;
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.getLogic(indexes[i++ % benchIndexes], &value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+static void unrolledInsertRemoveLogic(benchmark::State &state) {
+    SwiftyUnrolledList<T> list(0, false);
+    fillUnrolled(list, state.range(0));
+    std::vector<size_t> indexes = randomIndexes(list.getSize());
+    size_t i = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        size_t pos = indexes[i++ % benchIndexes];
+        list.insertAfterLogic(pos, makeValue<T>(i));
+        list.removeLogic(pos + 1);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename T>
+static void unrolledIterate(benchmark::State &state) {
+    SwiftyUnrolledList<T> list(0, false);
+    fillUnrolled(list, state.range(0));
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        for (size_t pos = list.begin(); pos != 0; pos = list.nextIterator(pos)) {
+            list.get(pos, &value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename T>
+static void listQueue(benchmark::State &state, bool optimized) {
+    SwiftyList<T> list(0, 0, nullptr, false);
+    fillList(list, state.range(0), optimized);
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.popFront(&value);
+        list.pushBack(value);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename T>
+static void forwardPushBack(benchmark::State &state) {
+    size_t size = state.range(0);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        SwiftyForwardList<T> list(0, false);
+        for (size_t i = 0; i < size; i++)
+            list.pushBack(makeValue<T>(i));
+        benchmark::DoNotOptimize(list.getSize());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename T>
+static void forwardQueue(benchmark::State &state) {
+    SwiftyForwardList<T> list(0, false);
+    for (size_t i = 0; i < (size_t) state.range(0); i++)
+        list.pushBack(makeValue<T>(i));
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        list.popFront(&value);
+        list.pushBack(value);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename T>
+static void forwardIterate(benchmark::State &state) {
+    SwiftyForwardList<T> list(0, false);
+    for (size_t i = 0; i < (size_t) state.range(0); i++)
+        list.pushBack(makeValue<T>(i));
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        for (size_t pos = list.begin(); pos != 0; pos = list.nextIterator(pos)) {
+            list.get(pos, &value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * list.getSize());
+}
+
+template<typename Container>
+static void containerPushBack(benchmark::State &state) {
+    using T = typename Container::value_type;
+    size_t size = state.range(0);
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        Container container;
+        for (size_t i = 0; i < size; i++)
+            container.push_back(makeValue<T>(i));
+        benchmark::DoNotOptimize(container.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Container>
+static void containerPopPushFront(benchmark::State &state) {
+    using T = typename Container::value_type;
+    Container container;
+    for (size_t i = 0; i < (size_t) state.range(0); i++)
+        container.push_back(makeValue<T>(i));
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        T value = container.front();
+        container.erase(container.begin());
+        container.insert(container.begin(), value);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename Container>
+static void containerGetLogic(benchmark::State &state) {
+    using T = typename Container::value_type;
+    Container container;
+    for (size_t i = 0; i < (size_t) state.range(0); i++)
+        container.push_back(makeValue<T>(i));
+    std::vector<size_t> indexes = randomIndexes(container.size());
+    size_t i = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        auto iterator = container.begin();
+        std::advance(iterator, indexes[i++ % benchIndexes]);
+        benchmark::DoNotOptimize(*iterator);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Container>
+static void containerInsertRemoveLogic(benchmark::State &state) {
+    using T = typename Container::value_type;
+    Container container;
+    for (size_t i = 0; i < (size_t) state.range(0); i++)
+        container.push_back(makeValue<T>(i));
+    std::vector<size_t> indexes = randomIndexes(container.size());
+    size_t i = 0;
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        auto iterator = container.begin();
+        std::advance(iterator, indexes[i++ % benchIndexes] + 1);
+        iterator = container.insert(iterator, makeValue<T>(i));
+        container.erase(iterator);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename Container>
+static void containerIterate(benchmark::State &state) {
+    using T = typename Container::value_type;
+    Container container;
+    for (size_t i = 0; i < (size_t) state.range(0); i++)
+        container.push_back(makeValue<T>(i));
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        for (const T &value : container)
+            benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * container.size());
+}
+
+/**
+ * Builds a list of benchMinSize elements per iteration, compare with SwiftyList pushBack of the same size
+ */
+template<typename T>
+static void staticPushBack(benchmark::State &state) {
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        SwiftyStaticList<T, benchMinSize> list;
+        for (size_t i = 0; i < benchMinSize; i++)
+            list.pushBack(makeValue<T>(i));
+        benchmark::DoNotOptimize(list);
+    }
+    state.SetItemsProcessed(state.iterations() * benchMinSize);
+}
+
+/**
+ * Reference LRU cache: std::list in recency order and std::unordered_map of its iterators
+ */
+template<typename T>
+struct StdLRU {
+    std::list<std::pair<size_t, T>> order;
+    std::unordered_map<size_t, typename std::list<std::pair<size_t, T>>::iterator> index;
+    size_t capacity;
+
+    explicit StdLRU(size_t capacity) : capacity(capacity) {
+        this->index.reserve(capacity);
+    }
+
+    bool get(size_t key, T *value) {
+        auto it = this->index.find(key);
+        if (it == this->index.end())
+            return false;
+        this->order.splice(this->order.begin(), this->order, it->second);
+        *value = it->second->second;
+        return true;
+    }
+
+    void put(size_t key, const T &value) {
+        auto it = this->index.find(key);
+        if (it != this->index.end()) {
+            it->second->second = value;
+            this->order.splice(this->order.begin(), this->order, it->second);
+            return;
+        }
+        if (this->order.size() == this->capacity) {
+            this->index.erase(this->order.back().first);
+            this->order.pop_back();
+        }
+        this->order.emplace_front(key, value);
+        this->index[key] = this->order.begin();
+    }
+};
+
+static bool lruHit(bool found) {
+    return found;
+}
+
+static bool lruHit(ListOpResult result) {
+    return result == LIST_OP_OK;
+}
+
+/**
+ * Cache of size range(0) with keys drawn from twice as many, about half of lookups miss and put the key
+ */
+template<typename Cache, typename T>
+static void runLRU(benchmark::State &state, Cache &cache) {
+    size_t capacity = state.range(0);
+    for (size_t i = 0; i < capacity; i++)
+        cache.put(i * 2, makeValue<T>(i));
+    std::vector<size_t> keys = randomIndexes(capacity * 2, benchLRUKeys);
+    size_t i = 0;
+    T value = {};
+    BenchPerf perf(state);
+    for (auto _ : state) {
+        size_t key = keys[i++ % benchLRUKeys];
+        if (!lruHit(cache.get(key, &value)))
+            cache.put(key, makeValue<T>(key));
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+static void swiftyLRU(benchmark::State &state) {
+    SwiftyLRU<size_t, T> cache(state.range(0));
+    runLRU<SwiftyLRU<size_t, T>, T>(state, cache);
+}
+
+template<typename T>
+static void stdLRU(benchmark::State &state) {
+    StdLRU<T> cache(state.range(0));
+    runLRU<StdLRU<T>, T>(state, cache);
+}
+
+/**
+ * Registers benchmark for sizes benchMinSize, 10 * benchMinSize, ... up to maxSize
+ */
+template<typename Func>
+static void registerSizes(const std::string &name, size_t maxSize, Func func) {
+    benchmark::internal::Benchmark *bench = benchmark::RegisterBenchmark(name.c_str(), func);
+    for (size_t size = benchMinSize; size <= maxSize; size *= 10)
+        bench->Arg((int64_t) size);
+}
+
+/**
+ * Modes a list benchmark is registered in. Operations that de-optimize the list on their
+ * first iteration are measured in de-optimized mode only.
+ */
+enum BenchModes {
+    BENCH_OPTIMIZED,
+    BENCH_DEOPTIMIZED,
+    BENCH_BOTH_MODES
+};
+
+template<typename T>
+static void registerList(size_t maxSize) {
+    using Bench = void (*)(benchmark::State &, bool);
+    const struct {
+        const char *name;
+        Bench      bench;
+        BenchModes modes;
+    } operations[] = {
+            {"pushBack",            listPushBack<T>,          BENCH_OPTIMIZED},
+            {"pushFront",           listPushFront<T>,         BENCH_OPTIMIZED},
+            {"get",                 listGet<T>,               BENCH_BOTH_MODES},
+            {"getLogic",            listGetLogic<T>,          BENCH_BOTH_MODES},
+            {"setLogic",            listSetLogic<T>,          BENCH_BOTH_MODES},
+            {"getLogicBatch",       listGetLogicBatch<T>,     BENCH_BOTH_MODES},
+            {"insertRemove",        listInsertRemove<T>,      BENCH_DEOPTIMIZED},
+            {"insertRemoveLogic",   listInsertRemoveLogic<T>, BENCH_DEOPTIMIZED},
+            {"popPushBack",         listPopPushBack<T>,       BENCH_BOTH_MODES},
+            {"popPushFront",        listPopPushFront<T>,      BENCH_DEOPTIMIZED},
+            {"queue",               listQueue<T>,             BENCH_DEOPTIMIZED},
+            {"iterate",             listIterate<T>,           BENCH_BOTH_MODES},
+            {"search",              listSearch<T>,            BENCH_BOTH_MODES},
+            {"checkUp",             listCheckUp<T>,           BENCH_BOTH_MODES},
+            {"validate",            listValidate<T>,          BENCH_BOTH_MODES},
+            {"optimize",            listOptimize<T>,          BENCH_BOTH_MODES},
+            {"sort",                listSort<T>,              BENCH_BOTH_MODES},
+    };
+    for (const auto &operation : operations) {
+        for (int optimized = 1; optimized >= 0; optimized--) {
+            if (operation.modes != BENCH_BOTH_MODES && (operation.modes == BENCH_OPTIMIZED) != (optimized != 0))
+                continue;
+            std::string name = std::string("SwiftyList<") + typeName<T>() + ">/" +
+                               (optimized ? "optimized/" : "deoptimized/") + operation.name;
+            Bench bench = operation.bench;
+            registerSizes(name, maxSize, [bench, optimized](benchmark::State &state) {
+                bench(state, optimized != 0);
+            });
+        }
+    }
+}
+
+template<typename Container>
+static void registerContainer(const std::string &container, size_t maxSize) {
+    using T = typename Container::value_type;
+    std::string prefix = container + "<" + typeName<T>() + ">/";
+    registerSizes(prefix + "pushBack", maxSize, containerPushBack<Container>);
+    registerSizes(prefix + "popPushFront", maxSize, containerPopPushFront<Container>);
+    registerSizes(prefix + "getLogic", maxSize, containerGetLogic<Container>);
+    registerSizes(prefix + "insertRemoveLogic", maxSize, containerInsertRemoveLogic<Container>);
+    registerSizes(prefix + "iterate", maxSize, containerIterate<Container>);
+}
+
+template<typename T>
+static void registerUnrolled(size_t maxSize) {
+    std::string prefix = std::string("SwiftyUnrolledList<") + typeName<T>() + ">/deoptimized/";
+    registerSizes(prefix + "getLogic", maxSize, unrolledGetLogic<T>);
+    registerSizes(prefix + "insertRemoveLogic", maxSize, unrolledInsertRemoveLogic<T>);
+    registerSizes(prefix + "iterate", maxSize, unrolledIterate<T>);
+}
+
+template<typename T>
+static void registerForward(size_t maxSize) {
+    std::string prefix = std::string("SwiftyForwardList<") + typeName<T>() + ">/";
+    registerSizes(prefix + "pushBack", maxSize, forwardPushBack<T>);
+    registerSizes(prefix + "queue", maxSize, forwardQueue<T>);
+    registerSizes(prefix + "iterate", maxSize, forwardIterate<T>);
+}
+
+template<typename T>
+static void registerFrozen(size_t maxSize) {
+    for (bool packed : {false, true}) {
+        std::string prefix = std::string("FrozenSwiftyList<") + typeName<T>() + ">/" + (packed ? "packed/" : "");
+        registerSizes(prefix + "search", maxSize, [packed](benchmark::State &state) {
+            frozenSearch<T>(state, packed);
+        });
+        registerSizes(prefix + "iterate", maxSize, [packed](benchmark::State &state) {
+            frozenIterate<T>(state, packed);
+        });
+    }
+}
+
+template<typename T>
+static void registerStatic() {
+    std::string name = std::string("SwiftyStaticList<") + typeName<T>() + ">/pushBack/" + std::to_string(benchMinSize);
+    benchmark::RegisterBenchmark(name.c_str(), staticPushBack<T>);
+}
+
+template<typename T>
+static void registerLRU(size_t maxSize) {
+    registerSizes(std::string("SwiftyLRU<") + typeName<T>() + ">/getPut", maxSize, swiftyLRU<T>);
+    registerSizes(std::string("std::list+unordered_map<") + typeName<T>() + ">/getPut", maxSize, stdLRU<T>);
+}
+
+template<typename T>
+static void registerType(size_t maxSize) {
+    registerList<T>(maxSize);
+    registerUnrolled<T>(maxSize);
+    registerForward<T>(maxSize);
+    registerFrozen<T>(maxSize);
+    registerStatic<T>();
+    registerLRU<T>(maxSize);
+    registerContainer<std::vector<T>>("std::vector", maxSize);
+    registerContainer<std::deque<T>>("std::deque", maxSize);
+    registerContainer<std::list<T>>("std::list", maxSize);
+}
+
+/**
+ * Largest size is taken from SWIFTY_BENCH_MAX_SIZE, 1e6 by default and 1e8 at most.
+ * With SWIFTY_BENCH_PERF set hardware counters are reported per iteration.
+ * Use --benchmark_out=result.json to store results for Tools/compare_bench.py.
+ */
+int main(int argc, char **argv) {
+    size_t maxSize = benchDefaultSize;
+    const char *maxSizeEnv = getenv("SWIFTY_BENCH_MAX_SIZE");
+    if (maxSizeEnv != nullptr)
+        maxSize = strtoull(maxSizeEnv, nullptr, 10);
+    if (maxSize < benchMinSize)
+        maxSize = benchMinSize;
+    if (maxSize > benchMaxSize)
+        maxSize = benchMaxSize;
+
+    SwiftyPerfCounters counters;
+    if (getenv("SWIFTY_BENCH_PERF") != nullptr) {
+        if (counters.anyAvailable())
+            benchCounters = &counters;
+        else
+            fprintf(stderr, "Hardware performance counters are not available\n");
+    }
+
+    registerType<int>(maxSize);
+    registerType<Pod64>(maxSize);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
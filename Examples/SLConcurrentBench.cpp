@@ -0,0 +1,218 @@
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SwiftyConcurrentList.hpp"
+#include "SwiftySPSCList.hpp"
+
+const size_t benchElements = 1000000;
+const double benchSeconds  = 1.0;
+const size_t queueElements = 2000000;
+const size_t queueCapacity = 4096;
+const size_t queueBatch    = 64;
+
+/**
+ * Global mutex around every call, the way SwiftyList is shared today
+ */
+struct MutexList {
+    SwiftyList<int> list;
+    std::mutex      mutex;
+
+    MutexList() : list(0, 0, nullptr, false) {}
+
+    ListOpResult getLogic(size_t pos, int *value) {
+        std::lock_guard<std::mutex> guard(this->mutex);
+        return this->list.getLogic(pos, value);
+    }
+
+    ListOpResult setLogic(size_t pos, int value) {
+        std::lock_guard<std::mutex> guard(this->mutex);
+        return this->list.setLogic(pos, value);
+    }
+
+    ListOpResult pushBack(int value) {
+        std::lock_guard<std::mutex> guard(this->mutex);
+        return this->list.pushBack(value);
+    }
+
+    ~MutexList() {
+        this->list.DestructList();
+    }
+};
+
+/**
+ * Mutex-wrapped list used as a queue
+ */
+struct MutexQueue {
+    SwiftyList<uint64_t> list;
+    std::mutex           mutex;
+
+    MutexQueue() : list(queueCapacity, 0, nullptr, false) {}
+
+    ListOpResult pushBack(uint64_t value) {
+        std::lock_guard<std::mutex> guard(this->mutex);
+        if (this->list.getSize() >= queueCapacity)
+            return LIST_OP_OVERFLOW;
+        return this->list.pushBack(value);
+    }
+
+    ListOpResult popFront(uint64_t *value) {
+        std::lock_guard<std::mutex> guard(this->mutex);
+        if (this->list.isEmpty())
+            return LIST_OP_UNDERFLOW;
+        return this->list.popFront(value);
+    }
+
+    ~MutexQueue() {
+        this->list.DestructList();
+    }
+};
+
+static uint64_t nowNs() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Producer pushes timestamps, consumer pops them and records latency.
+ * Prints throughput and latency percentiles.
+ */
+template<typename Queue, typename Push, typename Pop>
+void measureQueue(const char *name, Queue &queue, Push push, Pop pop) {
+    std::vector<uint64_t> latencies;
+    latencies.reserve(queueElements);
+    uint64_t begin = nowNs();
+    std::thread producer([&]() {
+        size_t sent = 0;
+        while (sent < queueElements) {
+            size_t pushed = push(queue, nowNs(), queueElements - sent);
+            if (pushed == 0)
+                std::this_thread::yield();
+            sent += pushed;
+        }
+    });
+    uint64_t batch[queueBatch];
+    while (latencies.size() < queueElements) {
+        size_t popped = pop(queue, batch);
+        if (popped == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t now = nowNs();
+        for (size_t i = 0; i < popped; i++)
+            latencies.push_back(now - batch[i]);
+    }
+    producer.join();
+    double elapsed = double(nowNs() - begin) / 1e9;
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return double(latencies[(size_t) (p * double(latencies.size() - 1))]) / 1e3;
+    };
+    printf("%-22s %10.2lf %10.2lf %10.2lf %10.2lf\n", name, double(queueElements) / elapsed / 1e6,
+           percentile(0.5), percentile(0.99), percentile(0.999));
+}
+
+void queueBenchmarks() {
+    printf("\n%-22s %10s %10s %10s %10s\n", "queue", "Mops/s", "p50 us", "p99 us", "p99.9 us");
+    {
+        MutexQueue queue;
+        measureQueue("mutex SwiftyList", queue,
+                     [](MutexQueue &q, uint64_t stamp, size_t) {
+                         return (size_t) (q.pushBack(stamp) == LIST_OP_OK);
+                     },
+                     [](MutexQueue &q, uint64_t *out) {
+                         return (size_t) (q.popFront(out) == LIST_OP_OK);
+                     });
+    }
+    {
+        SwiftySPSCList<uint64_t> queue(queueCapacity);
+        measureQueue("SwiftySPSCList", queue,
+                     [](SwiftySPSCList<uint64_t> &q, uint64_t stamp, size_t) {
+                         return (size_t) (q.pushBack(stamp) == LIST_OP_OK);
+                     },
+                     [](SwiftySPSCList<uint64_t> &q, uint64_t *out) {
+                         return (size_t) (q.popFront(out) == LIST_OP_OK);
+                     });
+    }
+    {
+        SwiftySPSCList<uint64_t> queue(queueCapacity);
+        measureQueue("SwiftySPSCList batch", queue,
+                     [](SwiftySPSCList<uint64_t> &q, uint64_t stamp, size_t left) {
+                         uint64_t stamps[queueBatch];
+                         size_t count = (left < queueBatch) ? left : queueBatch;
+                         for (size_t i = 0; i < count; i++)
+                             stamps[i] = stamp;
+                         size_t pushed = 0;
+                         q.pushBackBatch(stamps, count, &pushed);
+                         return pushed;
+                     },
+                     [](SwiftySPSCList<uint64_t> &q, uint64_t *out) {
+                         size_t popped = 0;
+                         q.popFrontBatch(out, queueBatch, &popped);
+                         return popped;
+                     });
+    }
+}
+
+/**
+ * Readers do random getLogic, one writer does random setLogic.
+ * @return reads per second
+ */
+template<typename List>
+double measure(List &list, size_t readersCount) {
+    std::atomic<bool> finished(false);
+    std::atomic<size_t> reads(0);
+    std::vector<std::thread> threads;
+    for (size_t r = 0; r < readersCount; r++) {
+        threads.emplace_back([&, r]() {
+            unsigned seed = (unsigned) r + 1;
+            size_t done = 0;
+            int value = 0;
+            while (!finished.load(std::memory_order_relaxed)) {
+                seed = seed * 1103515245 + 12345;
+                list.getLogic(seed % benchElements, &value);
+                done++;
+            }
+            reads += done;
+        });
+    }
+    threads.emplace_back([&]() {
+        unsigned seed = 7;
+        while (!finished.load(std::memory_order_relaxed)) {
+            seed = seed * 1103515245 + 12345;
+            list.setLogic(seed % benchElements, (int) seed);
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(benchSeconds));
+    finished.store(true);
+    for (auto &thread : threads)
+        thread.join();
+    return double(reads.load()) / benchSeconds;
+}
+
+int main() {
+    MutexList mutexList;
+    SwiftyConcurrentList<int> concurrentList(0, 0, nullptr, false);
+    for (size_t i = 0; i < benchElements; i++) {
+        mutexList.pushBack((int) i);
+        concurrentList.pushBack((int) i);
+    }
+
+    printf("%8s %18s %18s\n", "readers", "mutex Mreads/s", "seqlock Mreads/s");
+    size_t maxReaders = std::thread::hardware_concurrency();
+    if (maxReaders < 2)
+        maxReaders = 2;
+    for (size_t readers = 1; readers < maxReaders; readers *= 2) {
+        double mutexRate = measure(mutexList, readers);
+        double concurrentRate = measure(concurrentList, readers);
+        printf("%8zu %18.2lf %18.2lf\n", readers, mutexRate / 1e6, concurrentRate / 1e6);
+    }
+
+    queueBenchmarks();
+    return 0;
+}
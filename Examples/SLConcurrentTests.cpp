@@ -0,0 +1,128 @@
+//
+// SwiftyConcurrentList tests
+//
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "SwiftyConcurrentList.hpp"
+
+TEST(SwiftyConcurrentListTests, singleThread) {
+    SwiftyConcurrentList<int> list(0, 0, nullptr, false);
+    for (int i = 0; i < 1000; i++) {
+        if (i % 2 == 1)
+            EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+        else
+            EXPECT_TRUE(list.pushFront(i) == LIST_OP_OK);
+    }
+    EXPECT_FALSE(list.isOptimized());
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+    int first = 0, last = 0;
+    EXPECT_TRUE(list.getLogic(0, &first) == LIST_OP_OK);
+    EXPECT_TRUE(list.getLogic(999, &last) == LIST_OP_OK);
+    EXPECT_EQ(first, 998);
+    EXPECT_EQ(last, 999);
+    EXPECT_TRUE(list.getLogic(1000, &last) == LIST_OP_OVERFLOW);
+
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    for (int i = 0; i < 1000; i++) {
+        int expected = (i < 500) ? 998 - 2 * i : 2 * (i - 500) + 1;
+        int value = -1;
+        EXPECT_TRUE(list.getLogic(i, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, expected);
+        size_t pos = 0;
+        EXPECT_TRUE(list.searchLogic(&pos, expected) == LIST_OP_OK);
+        EXPECT_EQ(pos, i);
+    }
+
+    long long sum = 0;
+    size_t count = 0;
+    list.forEach([&](int value) {
+        sum += value;
+        count++;
+    });
+    EXPECT_EQ(count, 1000);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+
+    EXPECT_TRUE(list.pushBack(5000) == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    int value = 0;
+    EXPECT_TRUE(list.popBack(&value) == LIST_OP_OK);
+    EXPECT_EQ(value, 5000);
+    EXPECT_TRUE(list.clear() == LIST_OP_OK);
+    EXPECT_TRUE(list.isEmpty());
+}
+
+TEST(SwiftyConcurrentListTests, forEachCallsWriters) {
+    SwiftyConcurrentList<int> list(0, 0, nullptr, false);
+    for (int i = 0; i < 1000; i++)
+        EXPECT_TRUE(list.pushFront(999 - i) == LIST_OP_OK);
+    EXPECT_TRUE(list.deOptimize() == LIST_OP_OK);
+    for (int pass = 0; pass < 2; pass++) {
+        long long sum = 0;
+        size_t count = 0;
+        list.forEach([&](int value) {
+            if (count == 0) {
+                EXPECT_TRUE(list.pushBack(-1) == LIST_OP_OK);
+            }
+            EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+            sum += value;
+            count++;
+        });
+        EXPECT_EQ(count, 1001 + pass);
+        EXPECT_EQ(sum, 999 * 1000 / 2 - 1 - pass);
+    }
+    size_t pos = 0;
+    EXPECT_TRUE(list.searchLogic(&pos, 500) == LIST_OP_OK);
+    EXPECT_EQ(pos, 500);
+}
+
+TEST(SwiftyConcurrentListTests, readersWithWriter) {
+    const size_t readersCount = 4;
+    const long long elements = 200000;
+    SwiftyConcurrentList<long long> list(0, 0, nullptr, false);
+    std::atomic<bool> finished(false);
+    std::atomic<size_t> failures(0);
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < readersCount; r++) {
+        readers.emplace_back([&, r]() {
+            unsigned seed = (unsigned) r + 1;
+            while (!finished.load()) {
+                size_t size = list.getSize();
+                if (size == 0)
+                    continue;
+                seed = seed * 1103515245 + 12345;
+                size_t pos = seed % size;
+                long long value = -1;
+                ListOpResult res = list.getLogic(pos, &value);
+                if (res == LIST_OP_OK && value != (long long) pos)
+                    failures++;
+                if (res != LIST_OP_OK && res != LIST_OP_OVERFLOW)
+                    failures++;
+            }
+        });
+    }
+
+    for (long long i = 0; i < elements; i++) {
+        list.pushBack(i);
+        if (i % 1000 == 999) {
+            long long tmp = 0;
+            list.popBack(&tmp);
+            list.pushBack(tmp);
+        }
+        if (i % 50000 == 49999) {
+            list.deOptimize();
+            list.optimize();
+        }
+    }
+    finished.store(true);
+    for (auto &reader : readers)
+        reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(list.getSize(), elements);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+}
@@ -0,0 +1,115 @@
+//
+// Forward list tests
+//
+
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include "SwiftyForwardList.hpp"
+
+TEST(SwiftyForwardListTests, queue) {
+    SwiftyForwardList<int> list(0, true);
+    for (int i = 0; i < 100; i++)
+        EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    int value = -1;
+    EXPECT_TRUE(list.getLogic(42, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 42);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(list.popFront(&value) == LIST_OP_OK);
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(list.pushBack(i + 100) == LIST_OP_OK);
+    }
+    EXPECT_FALSE(list.isOptimized());
+    EXPECT_EQ(list.getSize(), 100);
+    EXPECT_LE(list.getCapacity(), 128);
+
+    int expected = 1000;
+    for (size_t pos = list.begin(); pos != 0; pos = list.nextIterator(pos)) {
+        EXPECT_TRUE(list.get(pos, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_TRUE(list.getLogic(99, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 1099);
+    EXPECT_TRUE(list.get(list.end(), &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 1099);
+
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    EXPECT_EQ(list.begin(), 1);
+    EXPECT_TRUE(list.get(50, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 1049);
+    EXPECT_TRUE(list.clear() == LIST_OP_OK);
+    EXPECT_TRUE(list.popFront(&value) == LIST_OP_UNDERFLOW);
+}
+
+TEST(SwiftyForwardListTests, physicalPositions) {
+    SwiftyForwardList<int> list(0, true);
+    size_t first = 0, second = 0, third = 0;
+    EXPECT_TRUE(list.pushBack(1, &first) == LIST_OP_OK);
+    EXPECT_TRUE(list.insertAfter(first, 3, &third) == LIST_OP_OK);
+    EXPECT_TRUE(list.insertAfter(first, 2, &second) == LIST_OP_OK);
+    EXPECT_TRUE(list.pushFront(0) == LIST_OP_OK);
+    EXPECT_EQ(list.end(), third);
+
+    int value = 0;
+    EXPECT_TRUE(list.popAfter(second, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 3);
+    EXPECT_EQ(list.end(), second);
+    EXPECT_TRUE(list.popAfter(second, &value) == LIST_OP_OVERFLOW);
+    EXPECT_TRUE(list.get(third, &value) == LIST_OP_SEGFAULT);
+    EXPECT_TRUE(list.removeAfter(first) == LIST_OP_OK);
+    EXPECT_TRUE(list.set(first, 10) == LIST_OP_OK);
+
+    size_t found = 0;
+    EXPECT_TRUE(list.search(&found, 10) == LIST_OP_OK);
+    EXPECT_EQ(found, first);
+    EXPECT_TRUE(list.searchLogic(&found, 10) == LIST_OP_OK);
+    EXPECT_EQ(found, 1);
+    EXPECT_TRUE(list.searchLogic(&found, 2) == LIST_OP_NOTFOUND);
+    EXPECT_EQ(list.getSize(), 2);
+}
+
+TEST(SwiftyForwardListTests, randomAgainstVector) {
+    SwiftyForwardList<int> list(0, true);
+    std::vector<int> expected;
+    std::mt19937 generator(11);
+    for (int i = 0; i < 20000; i++) {
+        size_t size = expected.size();
+        int op = generator() % 7;
+        int value = (int) generator();
+        if (size == 0 || op == 0) {
+            EXPECT_TRUE(list.pushBack(value) == LIST_OP_OK);
+            expected.push_back(value);
+        } else if (op == 1) {
+            EXPECT_TRUE(list.pushFront(value) == LIST_OP_OK);
+            expected.insert(expected.begin(), value);
+        } else if (op == 2) {
+            size_t pos = generator() % size;
+            EXPECT_TRUE(list.insertAfterLogic(pos, value) == LIST_OP_OK);
+            expected.insert(expected.begin() + pos + 1, value);
+        } else if (op == 3 || op == 4) {
+            size_t pos = generator() % size;
+            int popped = 0;
+            EXPECT_TRUE(list.popLogic(pos, &popped) == LIST_OP_OK);
+            EXPECT_EQ(popped, expected[pos]);
+            expected.erase(expected.begin() + pos);
+        } else if (op == 5) {
+            size_t first = generator() % size, second = generator() % size;
+            EXPECT_TRUE(list.swapLogic(first, second) == LIST_OP_OK);
+            std::swap(expected[first], expected[second]);
+        } else if (i % 500 == 6) {
+            EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+        } else {
+            size_t pos = generator() % size;
+            EXPECT_TRUE(list.setLogic(pos, value) == LIST_OP_OK);
+            expected[pos] = value;
+        }
+        ASSERT_EQ(list.getSize(), expected.size());
+    }
+    for (size_t i = 0; i < expected.size(); i++) {
+        int value = 0;
+        list.getLogic(i, &value);
+        ASSERT_EQ(value, expected[i]);
+    }
+}
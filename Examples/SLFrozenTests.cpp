@@ -0,0 +1,118 @@
+//
+// Frozen list tests
+//
+
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include "SwiftyFrozenList.hpp"
+
+static void expectSame(const FrozenSwiftyList<long long> &frozen, const std::vector<long long> &reference) {
+    ASSERT_EQ(frozen.getSize(), reference.size());
+    for (size_t i = 0; i < reference.size(); i++) {
+        long long value = 0;
+        ASSERT_TRUE(frozen.getLogic(i, &value) == LIST_OP_OK);
+        ASSERT_EQ(value, reference[i]) << "at " << i;
+    }
+    std::vector<long long> iterated;
+    frozen.forEach([&iterated](long long value) { iterated.push_back(value); });
+    EXPECT_EQ(iterated, reference);
+    EXPECT_TRUE(frozen.getLogic(reference.size(), nullptr) == LIST_OP_OVERFLOW);
+}
+
+TEST(SwiftyFrozenListTests, freezeAndThaw) {
+    std::mt19937 rnd(7);
+    SwiftyList<long long> list(0, 0, nullptr, false);
+    std::vector<long long> reference;
+    for (int i = 0; i < 1000; i++) {
+        long long value = (long long) (rnd() % 100000) - 50000;
+        if (i % 3 == 0) {
+            list.pushFront(value);
+            reference.insert(reference.begin(), value);
+        } else {
+            list.pushBack(value);
+            reference.push_back(value);
+        }
+    }
+    list.removeLogic(10);
+    reference.erase(reference.begin() + 10);
+    EXPECT_FALSE(list.isOptimized());
+
+    for (bool packed : {false, true}) {
+        FrozenSwiftyList<long long> frozen;
+        EXPECT_TRUE(list.freeze(&frozen, packed) == LIST_OP_OK);
+        EXPECT_EQ(frozen.isPacked(), packed);
+        expectSame(frozen, reference);
+
+        std::vector<long long> range(20);
+        EXPECT_TRUE(frozen.getLogicRange(120, 20, range.data()) == LIST_OP_OK);
+        EXPECT_TRUE(std::equal(range.begin(), range.end(), reference.begin() + 120));
+        EXPECT_TRUE(frozen.getLogicRange(reference.size() - 5, 6, range.data()) == LIST_OP_OVERFLOW);
+
+        for (size_t i = 0; i < reference.size(); i += 37) {
+            size_t pos = 0;
+            EXPECT_TRUE(frozen.searchLogic(&pos, reference[i]) == LIST_OP_OK);
+            EXPECT_EQ(pos, size_t(std::find(reference.begin(), reference.end(), reference[i]) - reference.begin()));
+        }
+        size_t pos = 0;
+        EXPECT_TRUE(frozen.searchLogic(&pos, 1000000) == LIST_OP_NOTFOUND);
+
+        SwiftyList<long long> thawed(0, 0, nullptr, true);
+        thawed.pushBack(42);
+        EXPECT_TRUE(frozen.thaw(&thawed) == LIST_OP_OK);
+        EXPECT_TRUE(thawed.isOptimized());
+        EXPECT_TRUE(thawed.checkUp() == LIST_OP_OK);
+        ASSERT_EQ(thawed.getSize(), reference.size());
+        for (size_t i = 0; i < reference.size(); i++) {
+            long long value = 0;
+            thawed.getLogic(i, &value);
+            ASSERT_EQ(value, reference[i]);
+        }
+        EXPECT_TRUE(thawed.pushBack(1) == LIST_OP_OK);
+    }
+}
+
+TEST(SwiftyFrozenListTests, packing) {
+    SwiftyList<long long> list(0, 0, nullptr, false);
+    std::vector<long long> reference;
+    // sorted timestamps, a constant run and full-range values in separate blocks
+    for (long long i = 0; i < 4096; i++)
+        reference.push_back(1700000000000LL + i * 3);
+    for (int i = 0; i < 300; i++)
+        reference.push_back(-5);
+    reference.push_back(INT64_MIN);
+    reference.push_back(INT64_MAX);
+    reference.push_back(0);
+    for (long long value : reference)
+        list.pushBack(value);
+
+    FrozenSwiftyList<long long> plain, packed;
+    EXPECT_TRUE(list.freeze(&plain) == LIST_OP_OK);
+    EXPECT_TRUE(list.freeze(&packed, true) == LIST_OP_OK);
+    expectSame(packed, reference);
+    EXPECT_EQ(plain.getMemoryBytes(), reference.size() * sizeof(long long));
+    EXPECT_LT(packed.getMemoryBytes() * 4, plain.getMemoryBytes());
+
+    size_t pos = 0;
+    EXPECT_TRUE(packed.searchLogic(&pos, INT64_MIN) == LIST_OP_OK);
+    EXPECT_EQ(pos, reference.size() - 3);
+    EXPECT_TRUE(packed.searchLogic(&pos, -5) == LIST_OP_OK);
+    EXPECT_EQ(pos, 4096u);
+
+    FrozenSwiftyList<long long> empty;
+    SwiftyList<long long> emptyList(0, 0, nullptr, false);
+    EXPECT_TRUE(emptyList.freeze(&empty, true) == LIST_OP_OK);
+    EXPECT_TRUE(empty.isEmpty());
+    EXPECT_TRUE(empty.searchLogic(&pos, 0) == LIST_OP_NOTFOUND);
+    EXPECT_TRUE(empty.thaw(&list) == LIST_OP_OK);
+    EXPECT_TRUE(list.isEmpty());
+
+    SwiftyList<double> doubles(0, 0, nullptr, false);
+    doubles.pushBack(0.5);
+    doubles.pushBack(1.5);
+    FrozenSwiftyList<double> frozenDoubles;
+    EXPECT_TRUE(doubles.freeze(&frozenDoubles, true) == LIST_OP_OK);
+    EXPECT_FALSE(frozenDoubles.isPacked());
+    EXPECT_TRUE(frozenDoubles.searchLogic(&pos, 1.5) == LIST_OP_OK);
+    EXPECT_EQ(pos, 1u);
+}
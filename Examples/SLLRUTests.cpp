@@ -0,0 +1,134 @@
+//
+// LRU cache tests
+//
+
+#include "gtest/gtest.h"
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "SwiftyLRU.hpp"
+
+TEST(SwiftyLRUTests, eviction) {
+    SwiftyLRU<int, int> cache(3);
+    size_t listCapacity = cache.getList().getCapacity();
+    EXPECT_TRUE(cache.put(1, 10) == LIST_OP_OK);
+    EXPECT_TRUE(cache.put(2, 20) == LIST_OP_OK);
+    EXPECT_TRUE(cache.put(3, 30) == LIST_OP_OK);
+    int value = 0;
+    EXPECT_TRUE(cache.get(1, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 10);
+    EXPECT_TRUE(cache.put(4, 40) == LIST_OP_OK);
+    EXPECT_EQ(cache.getSize(), 3);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.get(2, &value) == LIST_OP_NOTFOUND);
+
+    int key = 0;
+    EXPECT_TRUE(cache.lruKey(&key) == LIST_OP_OK);
+    EXPECT_EQ(key, 3);
+    EXPECT_TRUE(cache.peek(3, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 30);
+    EXPECT_TRUE(cache.lruKey(&key) == LIST_OP_OK);
+    EXPECT_EQ(key, 3);
+    EXPECT_TRUE(cache.put(3, 31) == LIST_OP_OK);
+    EXPECT_TRUE(cache.lruKey(&key) == LIST_OP_OK);
+    EXPECT_EQ(key, 1);
+
+    EXPECT_TRUE(cache.erase(4) == LIST_OP_OK);
+    EXPECT_TRUE(cache.erase(4) == LIST_OP_NOTFOUND);
+    EXPECT_EQ(cache.getSize(), 2);
+    EXPECT_TRUE(cache.put(5, 50) == LIST_OP_OK);
+    EXPECT_TRUE(cache.put(6, 60) == LIST_OP_OK);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.getList().getCapacity(), listCapacity);
+
+    int keys[] = {3, 1, 6};
+    int values[3] = {-1, -1, -1};
+    bool found[3] = {};
+    size_t hits = 0;
+    EXPECT_TRUE(cache.getBatch(keys, 3, values, found, &hits) == LIST_OP_OK);
+    EXPECT_EQ(hits, 2);
+    EXPECT_TRUE(found[0] && !found[1] && found[2]);
+    EXPECT_EQ(values[0], 31);
+    EXPECT_EQ(values[1], -1);
+    EXPECT_EQ(values[2], 60);
+
+    EXPECT_TRUE(cache.clear() == LIST_OP_OK);
+    EXPECT_EQ(cache.getSize(), 0);
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_TRUE(cache.lruKey(&key) == LIST_OP_UNDERFLOW);
+}
+
+TEST(SwiftyLRUTests, randomAgainstReference) {
+    const size_t capacity = 64;
+    SwiftyLRU<int, int> cache(capacity);
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> keys(0, 160);
+    std::uniform_int_distribution<int> ops(0, 9);
+
+    for (int i = 0; i < 50000; i++) {
+        int key = keys(gen);
+        int op = ops(gen);
+        auto it = index.find(key);
+        if (op < 5) {
+            int value = -1;
+            ListOpResult res = cache.get(key, &value);
+            if (it == index.end()) {
+                EXPECT_TRUE(res == LIST_OP_NOTFOUND);
+            } else {
+                EXPECT_TRUE(res == LIST_OP_OK);
+                EXPECT_EQ(value, it->second->second);
+                order.splice(order.begin(), order, it->second);
+            }
+        } else if (op < 9) {
+            EXPECT_TRUE(cache.put(key, i) == LIST_OP_OK);
+            if (it != index.end()) {
+                it->second->second = i;
+                order.splice(order.begin(), order, it->second);
+            } else {
+                if (order.size() == capacity) {
+                    index.erase(order.back().first);
+                    order.pop_back();
+                }
+                order.emplace_front(key, i);
+                index[key] = order.begin();
+            }
+        } else {
+            EXPECT_TRUE(cache.erase(key) == (it == index.end() ? LIST_OP_NOTFOUND : LIST_OP_OK));
+            if (it != index.end()) {
+                order.erase(it->second);
+                index.erase(it);
+            }
+        }
+        ASSERT_EQ(cache.getSize(), order.size());
+    }
+    int key = -1;
+    EXPECT_TRUE(cache.lruKey(&key) == LIST_OP_OK);
+    EXPECT_EQ(key, order.back().first);
+    for (const auto &entry : order) {
+        int value = -1;
+        EXPECT_TRUE(cache.peek(entry.first, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, entry.second);
+    }
+}
+
+TEST(SwiftyLRUTests, batchOverChunks) {
+    SwiftyLRU<int, int> cache(256);
+    for (int i = 0; i < 256; i += 2)
+        EXPECT_TRUE(cache.put(i, i * 10) == LIST_OP_OK);
+    std::vector<int> keys(3 * SWIFTY_LRU_BATCH_CHUNK + 5);
+    for (size_t i = 0; i < keys.size(); i++)
+        keys[i] = (int) i;
+    std::vector<int> values(keys.size(), -1);
+    bool found[3 * SWIFTY_LRU_BATCH_CHUNK + 5] = {};
+    size_t hits = 0;
+    EXPECT_TRUE(cache.getBatch(keys.data(), keys.size(), values.data(), found, &hits) == LIST_OP_OK);
+    EXPECT_EQ(hits, (keys.size() + 1) / 2);
+    for (size_t i = 0; i < keys.size(); i++) {
+        EXPECT_EQ(found[i], i % 2 == 0);
+        EXPECT_EQ(values[i], found[i] ? (int) i * 10 : -1);
+    }
+    EXPECT_TRUE(cache.getBatch(nullptr, 0, nullptr) == LIST_OP_OK);
+}
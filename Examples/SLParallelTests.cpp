@@ -0,0 +1,105 @@
+//
+// SwiftyParallelList tests
+//
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "SwiftyParallelList.hpp"
+
+TEST(SwiftyParallelListTests, singleThread) {
+    SwiftyParallelList<int> list;
+    auto worker = list.worker();
+    for (int i = 0; i < 5000; i++) {
+        if (i % 2 == 1)
+            EXPECT_TRUE(worker.pushBack(i) == LIST_OP_OK);
+        else
+            EXPECT_TRUE(worker.pushFront(i) == LIST_OP_OK);
+    }
+    EXPECT_EQ(list.getSize(), 5000);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+    int expected = 4998;
+    size_t iterator = list.begin();
+    for (size_t i = 0; i < 5000; i++) {
+        int value = -1;
+        EXPECT_TRUE(list.get(iterator, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, expected);
+        expected = (expected == 0) ? 1 : (expected % 2 == 0 ? expected - 2 : expected + 2);
+        iterator = list.nextIterator(iterator);
+    }
+    EXPECT_EQ(iterator, 0);
+
+    for (int i = 0; i < 5000; i++) {
+        int value = -1;
+        EXPECT_TRUE(worker.popFront(&value) == LIST_OP_OK);
+    }
+    int value = 0;
+    EXPECT_TRUE(worker.popFront(&value) == LIST_OP_UNDERFLOW);
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_TRUE(worker.pop(1) == LIST_OP_SEGFAULT);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+    size_t capacity = list.getCapacity();
+    for (int i = 0; i < 5000; i++)
+        worker.pushBack(i);
+    EXPECT_EQ(list.getCapacity(), capacity);
+}
+
+TEST(SwiftyParallelListTests, disjointRegions) {
+    const size_t threadsCount = 4;
+    const int perThread = 20000;
+    SwiftyParallelList<int> list;
+    std::vector<size_t> anchors(threadsCount);
+    {
+        auto worker = list.worker();
+        for (size_t t = 0; t < threadsCount; t++)
+            worker.pushBack(-1, &anchors[t]);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<size_t> failures(threadsCount, 0);
+    for (size_t t = 0; t < threadsCount; t++) {
+        threads.emplace_back([&, t]() {
+            auto worker = list.worker();
+            size_t last = anchors[t];
+            for (int i = 0; i < perThread; i++) {
+                int value = (int) t * perThread + i;
+                size_t pos = 0;
+                if (worker.insertAfter(last, value, &pos) != LIST_OP_OK)
+                    failures[t]++;
+                if (i % 4 == 3) {
+                    int popped = 0;
+                    if (worker.pop(pos, &popped) != LIST_OP_OK || popped != value)
+                        failures[t]++;
+                } else {
+                    last = pos;
+                }
+            }
+            for (int i = 0; i < perThread / 10; i++) {
+                worker.pushBack(-2);
+                worker.pushFront(-3);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < threadsCount; t++)
+        EXPECT_EQ(failures[t], 0);
+    size_t expectedSize = threadsCount * (1 + perThread - perThread / 4 + 2 * (perThread / 10));
+    EXPECT_EQ(list.getSize(), expectedSize);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+    for (size_t t = 0; t < threadsCount; t++) {
+        size_t iterator = list.nextIterator(anchors[t]);
+        for (int i = 0; i < perThread; i++) {
+            if (i % 4 == 3)
+                continue;
+            int value = 0;
+            list.get(iterator, &value);
+            EXPECT_EQ(value, (int) t * perThread + i);
+            iterator = list.nextIterator(iterator);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Hardware performance counters tests
+//
+
+#include "gtest/gtest.h"
+#include "SwiftyList.hpp"
+#include "SwiftyPerfCounters.hpp"
+
+TEST(SwiftyPerfCountersTests, totals) {
+    SwiftyPerfSample begin = {};
+    SwiftyPerfSample end = {};
+    end.value[PERF_COUNTER_CYCLES] = 1000;
+    end.enabled[PERF_COUNTER_CYCLES] = 100;
+    end.running[PERF_COUNTER_CYCLES] = 100;
+    end.value[PERF_COUNTER_LLC_MISSES] = 10;
+    end.enabled[PERF_COUNTER_LLC_MISSES] = 100;
+    end.running[PERF_COUNTER_LLC_MISSES] = 50;
+
+    SwiftyPerfTotals totals;
+    totals.add(begin, end, 10);
+    EXPECT_EQ(totals.operations, 10);
+    EXPECT_DOUBLE_EQ(totals.perOperation(PERF_COUNTER_CYCLES), 100);
+    EXPECT_DOUBLE_EQ(totals.perOperation(PERF_COUNTER_LLC_MISSES), 2);
+    EXPECT_LT(totals.perOperation(PERF_COUNTER_INSTRUCTIONS), 0);
+
+    totals.reset();
+    EXPECT_EQ(totals.operations, 0);
+    EXPECT_LT(totals.perOperation(PERF_COUNTER_CYCLES), 0);
+}
+
+TEST(SwiftyPerfCountersTests, scope) {
+    SwiftyPerfCounters counters;
+    SwiftyPerfTotals totals;
+    SwiftyList<int> list(0, 0, nullptr, false);
+    {
+        SwiftyPerfScope scope(counters, totals, 1000);
+        for (int i = 0; i < 1000; i++)
+            list.pushBack(i);
+    }
+    EXPECT_EQ(totals.operations, 1000);
+    for (size_t i = 0; i < PERF_COUNTERS_COUNT; i++) {
+        if (!counters.isAvailable((SwiftyPerfCounter) i)) {
+            EXPECT_FALSE(totals.valid[i]);
+        }
+    }
+    if (counters.isAvailable(PERF_COUNTER_INSTRUCTIONS) && totals.valid[PERF_COUNTER_INSTRUCTIONS]) {
+        EXPECT_GT(totals.perOperation(PERF_COUNTER_INSTRUCTIONS), 0);
+    }
+    EXPECT_STREQ(perfCounterName(PERF_COUNTER_DTLB_MISSES), "dTLB-misses");
+}
@@ -0,0 +1,127 @@
+//
+// List pool tests
+//
+
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include "SwiftyList.hpp"
+
+TEST(SwiftyListPoolTests, sizeClasses) {
+    SwiftyListPool pool(1 << 16);
+    for (size_t bytes = 1; bytes < 100000; bytes += 37) {
+        size_t actual = 0;
+        void *segment = pool.allocate(bytes, &actual);
+        ASSERT_NE(segment, nullptr);
+        EXPECT_GE(actual, bytes);
+        if (bytes > 64) {
+            EXPECT_LE(actual, bytes + bytes / 4 + 16);
+        }
+        EXPECT_EQ((uintptr_t) segment % alignof(std::max_align_t), 0);
+        memset(segment, 0xAB, actual);
+        pool.release(segment);
+        EXPECT_EQ(pool.allocate(bytes), segment);
+        pool.release(segment);
+    }
+    EXPECT_EQ(pool.getLiveBytes(), 0);
+    EXPECT_EQ(pool.getLiveSegments(), 0);
+
+    void *first = pool.allocate(1000);
+    void *second = pool.allocate(1000);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(pool.getLiveSegments(), 2);
+    EXPECT_GT(pool.occupancy(), 0);
+    size_t slabs = pool.getSlabsCount();
+    size_t reserved = pool.getReservedBytes();
+    pool.reset();
+    EXPECT_EQ(pool.getLiveBytes(), 0);
+    EXPECT_EQ(pool.occupancy(), 0);
+    for (int i = 0; i < 100; i++)
+        pool.allocate(1000);
+    EXPECT_EQ(pool.getSlabsCount(), slabs);
+    EXPECT_EQ(pool.getReservedBytes(), reserved);
+}
+
+TEST(SwiftyListPoolTests, pooledLists) {
+    SwiftyListPool pool;
+    std::vector<SwiftyList<int>> lists;
+    std::vector<std::vector<int>> models(200);
+    for (size_t i = 0; i < models.size(); i++) {
+        lists.emplace_back(0, 0, nullptr, false);
+        EXPECT_TRUE(lists.back().setPool(&pool) == LIST_OP_OK);
+    }
+    std::mt19937 gen(11);
+    for (int step = 0; step < 100000; step++) {
+        size_t index = gen() % lists.size();
+        SwiftyList<int> &list = lists[index];
+        std::vector<int> &model = models[index];
+        if (model.empty() || gen() % 3 != 0) {
+            size_t pos = model.empty() ? 0 : gen() % model.size();
+            if (model.empty()) {
+                EXPECT_TRUE(list.pushBack(step) == LIST_OP_OK);
+                model.push_back(step);
+            } else {
+                EXPECT_TRUE(list.insertAfter(list.logicToPhysic(pos), step) == LIST_OP_OK);
+                model.insert(model.begin() + pos + 1, step);
+            }
+        } else {
+            size_t pos = gen() % model.size();
+            EXPECT_TRUE(list.removeLogic(pos) == LIST_OP_OK);
+            model.erase(model.begin() + pos);
+        }
+        if (step % 10000 == 0) {
+            EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+        }
+    }
+    EXPECT_GT(pool.getLiveSegments(), 0);
+    EXPECT_GT(pool.occupancy(), 0);
+    EXPECT_LE(pool.getLiveBytes(), pool.getReservedBytes());
+    for (size_t i = 0; i < lists.size(); i++) {
+        EXPECT_TRUE(lists[i].checkUp() == LIST_OP_OK);
+        EXPECT_LE(lists[i].getCapacity(), 2 * models[i].size() + SWIFTY_LIST_INLINE_CAPACITY);
+        for (size_t j = 0; j < models[i].size(); j++) {
+            int value = -1;
+            EXPECT_TRUE(lists[i].getLogic(j, &value) == LIST_OP_OK);
+            EXPECT_EQ(value, models[i][j]);
+        }
+    }
+
+    EXPECT_TRUE(lists[0].setPool(nullptr) == LIST_OP_OK);
+    SwiftyListSnapshot<int> snapshot = lists[1].snapshot();
+    EXPECT_EQ(lists[1].getPool(), &pool);
+    EXPECT_EQ(snapshot.getSize(), models[1].size());
+    EXPECT_TRUE(lists[1].pushFront(-1) == LIST_OP_OK);
+    int value = 0;
+    EXPECT_TRUE(snapshot.getLogic(0, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, models[1][0]);
+    lists[0].DestructList();
+    lists[1].DestructList();
+
+    pool.reset();
+    EXPECT_EQ(pool.getLiveSegments(), 0);
+    lists.clear();
+    EXPECT_EQ(pool.getLiveSegments(), 0);
+}
+
+TEST(SwiftyListPoolTests, capacityOfSegment) {
+    SwiftyListPool pool;
+    SwiftyList<int> list(0, 0, nullptr, false);
+    EXPECT_TRUE(list.setPool(&pool) == LIST_OP_OK);
+    for (int i = 0; i < 1000; i++)
+        EXPECT_TRUE(list.pushFront(i) == LIST_OP_OK);
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    size_t segments = pool.getLiveSegments();
+    size_t capacity = list.getCapacity();
+    EXPECT_GT(capacity, list.getSize());
+    while (list.getSize() < capacity)
+        EXPECT_TRUE(list.pushBack(0) == LIST_OP_OK);
+    EXPECT_EQ(pool.getLiveSegments(), segments);
+    EXPECT_EQ(list.getCapacity(), capacity);
+
+    std::vector<char> buffer(list.getSize() * sizeof(int) + 1024);
+    size_t written = 0;
+    EXPECT_TRUE(list.serialize(buffer.data(), buffer.size(), &written) == LIST_OP_OK);
+    EXPECT_TRUE(list.deserialize(buffer.data(), written) == LIST_OP_OK);
+    EXPECT_GE(list.getCapacity(), list.getSize());
+    EXPECT_EQ(list.getCapacity(), capacity);
+}
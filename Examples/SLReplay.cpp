@@ -0,0 +1,406 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "SwiftyList.hpp"
+#include "SwiftyListTrace.hpp"
+#include "SwiftyPerfCounters.hpp"
+
+const size_t histogramBuckets = 64;
+
+/**
+ * Replay configuration, see usage()
+ */
+struct ReplayConfig {
+    const char            *tracePath;
+    bool                  useChecks;
+    SwiftyListAllocPolicy allocPolicy;
+    size_t                optimizeEvery;
+    size_t                optimizeAfterDeopt;
+    bool                  usePerf;
+};
+
+/**
+ * Element of the recorded size. Values are only copied and compared byte-wise.
+ */
+template<size_t N>
+struct Blob {
+    unsigned char bytes[N];
+
+    bool operator==(const Blob &other) const {
+        return memcmp(this->bytes, other.bytes, N) == 0;
+    }
+};
+
+/**
+ * Latency histogram with power of two buckets in nanoseconds
+ */
+struct LatencyHistogram {
+    size_t buckets[histogramBuckets];
+    size_t count;
+    double total;
+    size_t max;
+
+    LatencyHistogram() : buckets(), count(0), total(0), max(0) {}
+
+    void add(size_t nanoseconds) {
+        size_t bucket = 0;
+        while (bucket + 1 < histogramBuckets && (size_t(1) << (bucket + 1)) <= nanoseconds)
+            bucket++;
+        this->buckets[bucket]++;
+        this->count++;
+        this->total += (double) nanoseconds;
+        if (nanoseconds > this->max)
+            this->max = nanoseconds;
+    }
+
+    /**
+     * Upper bound of the bucket holding the given quantile
+     */
+    size_t quantile(double q) const {
+        size_t target = (size_t) (q * (double) this->count);
+        size_t seen = 0;
+        for (size_t bucket = 0; bucket < histogramBuckets; bucket++) {
+            seen += this->buckets[bucket];
+            if (seen > target)
+                return size_t(1) << (bucket + 1);
+        }
+        return this->max;
+    }
+};
+
+template<typename T>
+struct Replayer {
+    const ReplayConfig   &config;
+    SwiftyList<T>        list;
+    std::vector<size_t>  positions;
+    LatencyHistogram     histograms[TRACE_OP_COUNT + 1];
+    SwiftyPerfCounters   *counters;
+    SwiftyPerfTotals     perfTotals[TRACE_OP_COUNT + 1];
+    size_t               opsSinceOptimize;
+    size_t               deoptLogicOps;
+    size_t               failedOps;
+
+    Replayer(const ReplayConfig &config, SwiftyPerfCounters *counters) :
+            config(config), list(0, 0, nullptr, config.useChecks), counters(counters), opsSinceOptimize(0),
+            deoptLogicOps(0), failedOps(0) {
+        this->list.setAllocPolicy(config.allocPolicy);
+    }
+
+    /**
+     * Physical position in the replayed list for the recorded one
+     */
+    size_t translate(size_t recorded) const {
+        if (recorded < this->positions.size() && this->positions[recorded] != 0)
+            return this->positions[recorded];
+        return recorded;
+    }
+
+    void remember(size_t recorded, size_t replayed) {
+        if (recorded >= this->positions.size())
+            this->positions.resize(recorded + 1, 0);
+        this->positions[recorded] = replayed;
+    }
+
+    /**
+     * Optimizes the replayed list on its own. Recorded positions are moved
+     * to the new places of their elements.
+     */
+    void policyOptimize() {
+        std::vector<size_t> rank(this->list.getSize() + this->list.getCapacity() + 2, 0);
+        size_t iterator = this->list.begin();
+        for (size_t i = 0; i < this->list.getSize(); i++) {
+            rank[iterator] = i + 1;
+            iterator = this->list.nextIterator(iterator);
+        }
+        if (this->positions.size() < rank.size())
+            this->positions.resize(rank.size(), 0);
+        for (size_t recorded = 1; recorded < this->positions.size(); recorded++) {
+            size_t replayed = this->translate(recorded);
+            this->positions[recorded] = (replayed < rank.size()) ? rank[replayed] : 0;
+        }
+        SwiftyPerfSample perfBegin, perfEnd;
+        this->samplePerf(&perfBegin);
+        auto begin = std::chrono::steady_clock::now();
+        this->list.optimize();
+        auto end = std::chrono::steady_clock::now();
+        this->samplePerf(&perfEnd);
+        this->addPerf(TRACE_OP_COUNT, perfBegin, perfEnd);
+        this->histograms[TRACE_OP_COUNT].add(
+                (size_t) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        this->opsSinceOptimize = 0;
+        this->deoptLogicOps = 0;
+    }
+
+    void samplePerf(SwiftyPerfSample *sample) const {
+        if (this->counters != nullptr)
+            this->counters->sample(sample);
+    }
+
+    void addPerf(size_t op, const SwiftyPerfSample &begin, const SwiftyPerfSample &end) {
+        if (this->counters != nullptr)
+            this->perfTotals[op].add(begin, end);
+    }
+
+    ListOpResult apply(const SwiftyListTraceRecord &record) {
+        T value = {};
+        if (record.value != nullptr)
+            memcpy(&value, record.value, sizeof(T));
+        size_t inserted = 0;
+        size_t pos = 0;
+        switch (record.op) {
+            case TRACE_OP_INITIAL: {
+                ListOpResult res = this->list.pushBack(value, &inserted);
+                this->remember(record.second, inserted);
+                return res;
+            }
+            case TRACE_OP_INSERT_AFTER:
+                return this->inserted(record, this->list.insertAfter(this->translate(record.first), value, &inserted),
+                                      inserted);
+            case TRACE_OP_INSERT_AFTER_LOGIC:
+                return this->inserted(record, this->list.insertAfterLogic(record.first, value, &inserted), inserted);
+            case TRACE_OP_INSERT_BEFORE:
+                return this->inserted(record, this->list.insertBefore(this->translate(record.first), value, &inserted),
+                                      inserted);
+            case TRACE_OP_INSERT_BEFORE_LOGIC:
+                return this->inserted(record, this->list.insertBeforeLogic(record.first, value, &inserted), inserted);
+            case TRACE_OP_PUSH_FRONT:
+                return this->inserted(record, this->list.pushFront(value, &inserted), inserted);
+            case TRACE_OP_PUSH_BACK:
+                return this->inserted(record, this->list.pushBack(value, &inserted), inserted);
+            case TRACE_OP_SET:
+                return this->list.set(this->translate(record.first), value);
+            case TRACE_OP_SET_LOGIC:
+                return this->list.setLogic(record.first, value);
+            case TRACE_OP_GET:
+                return this->list.get(this->translate(record.first), &value);
+            case TRACE_OP_GET_LOGIC:
+                return this->list.getLogic(record.first, &value);
+            case TRACE_OP_POP:
+                return this->list.pop(this->translate(record.first), &value);
+            case TRACE_OP_POP_FRONT:
+                return this->list.popFront(&value);
+            case TRACE_OP_POP_BACK:
+                return this->list.popBack(&value);
+            case TRACE_OP_POP_LOGIC:
+                return this->list.popLogic(record.first, &value);
+            case TRACE_OP_REMOVE:
+                return this->list.remove(this->translate(record.first));
+            case TRACE_OP_REMOVE_LOGIC:
+                return this->list.removeLogic(record.first);
+            case TRACE_OP_SWAP:
+                return this->list.swap(this->translate(record.first), this->translate(record.second));
+            case TRACE_OP_SWAP_LOGIC:
+                return this->list.swapLogic(record.first, record.second);
+            case TRACE_OP_CLEAR:
+                this->positions.clear();
+                return this->list.clear();
+            case TRACE_OP_OPTIMIZE: {
+                this->positions.clear();
+                this->opsSinceOptimize = 0;
+                this->deoptLogicOps = 0;
+                return this->list.optimize();
+            }
+            case TRACE_OP_SEARCH:
+                return this->list.search(&pos, value);
+            case TRACE_OP_SEARCH_LOGIC:
+                return this->list.searchLogic(&pos, value);
+            case TRACE_OP_MOVE_AFTER:
+                return this->list.moveAfter(this->translate(record.first), this->translate(record.second));
+            default:
+                return LIST_OP_CORRUPTED;
+        }
+    }
+
+    ListOpResult inserted(const SwiftyListTraceRecord &record, ListOpResult res, size_t inserted) {
+        if (res == LIST_OP_OK)
+            this->remember(record.second, inserted);
+        return res;
+    }
+
+    static bool isLogic(SwiftyListTraceOp op) {
+        return op == TRACE_OP_INSERT_AFTER_LOGIC || op == TRACE_OP_INSERT_BEFORE_LOGIC || op == TRACE_OP_SET_LOGIC ||
+               op == TRACE_OP_GET_LOGIC || op == TRACE_OP_POP_LOGIC || op == TRACE_OP_REMOVE_LOGIC ||
+               op == TRACE_OP_SWAP_LOGIC;
+    }
+
+    int run(SwiftyListTraceReader &reader) {
+        SwiftyListTraceRecord record = {};
+        ListOpResult res;
+        size_t records = 0;
+        auto started = std::chrono::steady_clock::now();
+        while ((res = reader.next(&record)) == LIST_OP_OK) {
+            if (record.op == TRACE_OP_UNRECORDED) {
+                fprintf(stderr, "Trace has an unrecorded mutation after %zu records, it cannot be replayed\n",
+                        records);
+                return 1;
+            }
+            SwiftyPerfSample perfBegin, perfEnd;
+            this->samplePerf(&perfBegin);
+            auto begin = std::chrono::steady_clock::now();
+            ListOpResult opRes = this->apply(record);
+            auto end = std::chrono::steady_clock::now();
+            this->samplePerf(&perfEnd);
+            if (record.op != TRACE_OP_INITIAL) {
+                this->histograms[record.op].add(
+                        (size_t) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+                this->addPerf(record.op, perfBegin, perfEnd);
+            }
+            if (opRes != LIST_OP_OK && opRes != LIST_OP_NOTFOUND)
+                this->failedOps++;
+            records++;
+
+            this->opsSinceOptimize++;
+            if (!this->list.isOptimized() && isLogic(record.op))
+                this->deoptLogicOps++;
+            if ((this->config.optimizeEvery != 0 && this->opsSinceOptimize >= this->config.optimizeEvery) ||
+                (this->config.optimizeAfterDeopt != 0 && this->deoptLogicOps >= this->config.optimizeAfterDeopt))
+                this->policyOptimize();
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        if (res != LIST_OP_UNDERFLOW) {
+            fprintf(stderr, "Trace is corrupted after %zu records\n", records);
+            return 1;
+        }
+
+        printf("Replayed %zu records in %.3lf sec, %zu failed operations, final size %zu\n",
+               records, elapsed, this->failedOps, this->list.getSize());
+        printf("%-20s %12s %12s %12s %12s %12s\n", "operation", "count", "mean ns", "p50 ns", "p99 ns", "max ns");
+        for (size_t op = 0; op <= TRACE_OP_COUNT; op++) {
+            const LatencyHistogram &histogram = this->histograms[op];
+            if (histogram.count == 0)
+                continue;
+            printf("%-20s %12zu %12.1lf %12zu %12zu %12zu\n", opName(op), histogram.count,
+                   histogram.total / (double) histogram.count, histogram.quantile(0.5), histogram.quantile(0.99),
+                   histogram.max);
+        }
+        if (this->counters != nullptr)
+            this->printPerf();
+        return 0;
+    }
+
+    static const char *opName(size_t op) {
+        return (op == TRACE_OP_COUNT) ? "optimize (policy)" : traceOpInfo((SwiftyListTraceOp) op).name;
+    }
+
+    /**
+     * Hardware events per operation, n/a for unavailable counters
+     */
+    void printPerf() const {
+        printf("\n%-20s", "operation");
+        for (size_t i = 0; i < PERF_COUNTERS_COUNT; i++)
+            printf(" %14s", perfCounterName((SwiftyPerfCounter) i));
+        printf("\n");
+        for (size_t op = 0; op <= TRACE_OP_COUNT; op++) {
+            const SwiftyPerfTotals &totals = this->perfTotals[op];
+            if (totals.operations == 0)
+                continue;
+            printf("%-20s", opName(op));
+            for (size_t i = 0; i < PERF_COUNTERS_COUNT; i++) {
+                double value = totals.perOperation((SwiftyPerfCounter) i);
+                if (value < 0)
+                    printf(" %14s", "n/a");
+                else
+                    printf(" %14.1lf", value);
+            }
+            printf("\n");
+        }
+    }
+};
+
+template<size_t N>
+static int replay(const ReplayConfig &config, SwiftyListTraceReader &reader) {
+    SwiftyPerfCounters *counters = nullptr;
+    if (config.usePerf) {
+        counters = new SwiftyPerfCounters();
+        if (!counters->anyAvailable()) {
+            fprintf(stderr, "Hardware performance counters are not available\n");
+            delete counters;
+            counters = nullptr;
+        }
+    }
+    auto *replayer = new Replayer<Blob<N>>(config, counters);
+    int res = replayer->run(reader);
+    delete replayer;
+    delete counters;
+    return res;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "Usage: %s trace [--checks] [--alloc lifo|nearest] [--optimize never|every=N|deopt=N] [--perf]\n"
+                    "  --checks         check list integrity on every operation\n"
+                    "  --alloc          free cell allocation policy, lifo by default\n"
+                    "  --optimize       call optimize() every N operations or after N logical operations\n"
+                    "                   on de-optimized list, never by default\n"
+                    "  --perf           report hardware events per operation\n", name);
+}
+
+static bool parseArgs(int argc, char **argv, ReplayConfig *config) {
+    *config = {nullptr, false, LIST_ALLOC_LIFO, 0, 0, false};
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--checks") {
+            config->useChecks = true;
+        } else if (arg == "--perf") {
+            config->usePerf = true;
+        } else if (arg == "--alloc" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy == "nearest")
+                config->allocPolicy = LIST_ALLOC_NEAREST;
+            else if (policy != "lifo")
+                return false;
+        } else if (arg == "--optimize" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy.compare(0, 6, "every=") == 0)
+                config->optimizeEvery = strtoull(policy.c_str() + 6, nullptr, 10);
+            else if (policy.compare(0, 6, "deopt=") == 0)
+                config->optimizeAfterDeopt = strtoull(policy.c_str() + 6, nullptr, 10);
+            else if (policy != "never")
+                return false;
+        } else if (config->tracePath == nullptr && arg[0] != '-') {
+            config->tracePath = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return config->tracePath != nullptr;
+}
+
+int main(int argc, char **argv) {
+    ReplayConfig config = {};
+    if (!parseArgs(argc, argv, &config)) {
+        usage(argv[0]);
+        return 2;
+    }
+    FILE *file = fopen(config.tracePath, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "Can not open %s\n", config.tracePath);
+        return 1;
+    }
+    SwiftyListTraceReader reader(file);
+    if (reader.open() != LIST_OP_OK) {
+        fprintf(stderr, "%s is not a SwiftyList trace\n", config.tracePath);
+        fclose(file);
+        return 1;
+    }
+    int res;
+    switch (reader.getElemSize()) {
+        case 1:   res = replay<1>(config, reader);   break;
+        case 2:   res = replay<2>(config, reader);   break;
+        case 4:   res = replay<4>(config, reader);   break;
+        case 8:   res = replay<8>(config, reader);   break;
+        case 16:  res = replay<16>(config, reader);  break;
+        case 32:  res = replay<32>(config, reader);  break;
+        case 64:  res = replay<64>(config, reader);  break;
+        case 128: res = replay<128>(config, reader); break;
+        case 256: res = replay<256>(config, reader); break;
+        default:
+            fprintf(stderr, "Unsupported element size %zu\n", reader.getElemSize());
+            res = 1;
+    }
+    fclose(file);
+    return res;
+}
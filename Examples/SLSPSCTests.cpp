@@ -0,0 +1,92 @@
+//
+// SwiftySPSCList tests
+//
+
+#include "gtest/gtest.h"
+#include <thread>
+#include "SwiftySPSCList.hpp"
+
+TEST(SwiftySPSCListTests, singleThread) {
+    SwiftySPSCList<int> list(10);
+    EXPECT_EQ(list.getCapacity(), 16);
+    EXPECT_TRUE(list.isEmpty());
+    int value = 0;
+    EXPECT_TRUE(list.popFront(&value) == LIST_OP_UNDERFLOW);
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 16; i++)
+            EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+        EXPECT_TRUE(list.pushBack(16) == LIST_OP_OVERFLOW);
+        for (int i = 0; i < 11; i++) {
+            EXPECT_TRUE(list.popFront(&value) == LIST_OP_OK);
+            EXPECT_EQ(value, i);
+        }
+        for (int i = 11; i < 16; i++) {
+            EXPECT_TRUE(list.popFront(&value) == LIST_OP_OK);
+            EXPECT_EQ(value, i);
+        }
+        EXPECT_TRUE(list.isEmpty());
+    }
+}
+
+TEST(SwiftySPSCListTests, batches) {
+    SwiftySPSCList<int> list(8);
+    int input[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    int output[12] = {};
+    size_t done = 0;
+    EXPECT_TRUE(list.pushBackBatch(input, 5, &done) == LIST_OP_OK);
+    EXPECT_EQ(done, 5);
+    EXPECT_TRUE(list.popFrontBatch(output, 3, &done) == LIST_OP_OK);
+    EXPECT_EQ(done, 3);
+    EXPECT_TRUE(list.pushBackBatch(input + 5, 7, &done) == LIST_OP_OVERFLOW);
+    EXPECT_EQ(done, 6);
+    EXPECT_TRUE(list.popFrontBatch(output + 3, 12, &done) == LIST_OP_OK);
+    EXPECT_EQ(done, 8);
+    for (int i = 0; i < 11; i++)
+        EXPECT_EQ(output[i], i);
+    EXPECT_TRUE(list.popFrontBatch(output, 1, &done) == LIST_OP_UNDERFLOW);
+    EXPECT_EQ(done, 0);
+    EXPECT_TRUE(list.pushBackBatch(nullptr, 0, &done) == LIST_OP_OK);
+    EXPECT_TRUE(list.popFrontBatch(nullptr, 0, &done) == LIST_OP_OK);
+    EXPECT_EQ(done, 0);
+}
+
+TEST(SwiftySPSCListTests, producerConsumer) {
+    const long long elements = 200000;
+    SwiftySPSCList<long long> list(1024);
+    std::thread producer([&]() {
+        long long batch[7];
+        long long next = 0;
+        while (next < elements) {
+            if (next % 3 == 0) {
+                while (list.pushBack(next) != LIST_OP_OK)
+                    std::this_thread::yield();
+                next++;
+                continue;
+            }
+            size_t count = 0;
+            for (; count < 7 && next + (long long) count < elements; count++)
+                batch[count] = next + (long long) count;
+            size_t pushed = 0;
+            list.pushBackBatch(batch, count, &pushed);
+            next += (long long) pushed;
+        }
+    });
+
+    long long expected = 0;
+    size_t mismatches = 0;
+    long long batch[5];
+    while (expected < elements) {
+        size_t popped = 0;
+        list.popFrontBatch(batch, 5, &popped);
+        for (size_t i = 0; i < popped; i++)
+            mismatches += batch[i] != expected++;
+        long long value = 0;
+        if (list.popFront(&value) == LIST_OP_OK)
+            mismatches += value != expected++;
+        else if (popped == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_TRUE(list.isEmpty());
+}
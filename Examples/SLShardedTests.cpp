@@ -0,0 +1,106 @@
+//
+// SwiftyShardedList tests
+//
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "SwiftyShardedList.hpp"
+
+TEST(SwiftyShardedListTests, routing) {
+    SwiftyShardedList<int> list(5, 0, 0, nullptr, false);
+    EXPECT_EQ(list.getShardsCount(), 5);
+    int value = 0;
+    EXPECT_TRUE(list.getLogic(0, &value) == LIST_OP_OVERFLOW);
+    for (int shard = 0; shard < 5; shard++)
+        for (int i = 0; i < 100; i++)
+            EXPECT_TRUE(list.pushBackShard(shard, shard * 100 + i) == LIST_OP_OK);
+    EXPECT_EQ(list.getSize(), 500);
+    for (int i = 0; i < 500; i++) {
+        EXPECT_TRUE(list.getLogic(i, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(list.getLogic(500, &value) == LIST_OP_OVERFLOW);
+
+    EXPECT_TRUE(list.removeLogic(150) == LIST_OP_OK);
+    EXPECT_TRUE(list.insertAfterLogic(148, 150) == LIST_OP_OK);
+    EXPECT_TRUE(list.popLogic(150, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 149);
+    EXPECT_TRUE(list.insertAfterLogic(148, 149) == LIST_OP_OK);
+    EXPECT_TRUE(list.setLogic(499, -1) == LIST_OP_OK);
+    EXPECT_TRUE(list.pushFront(-2) == LIST_OP_OK);
+    EXPECT_TRUE(list.pushBack(-3) == LIST_OP_OK);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+    std::vector<int> values;
+    list.forEach([&](int v) { values.push_back(v); });
+    EXPECT_EQ(values.size(), 502);
+    EXPECT_EQ(values.front(), -2);
+    EXPECT_EQ(values.back(), -3);
+    EXPECT_EQ(values[500], -1);
+    for (int i = 0; i < 499; i++)
+        EXPECT_EQ(values[i + 1], i);
+
+    EXPECT_TRUE(list.optimize(3) == LIST_OP_OK);
+    EXPECT_TRUE(list.popFront(&value) == LIST_OP_OK);
+    EXPECT_EQ(value, -2);
+    EXPECT_TRUE(list.popBack(&value) == LIST_OP_OK);
+    EXPECT_EQ(value, -3);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+}
+
+TEST(SwiftyShardedListTests, spreadAppends) {
+    const size_t threadsCount = 4;
+    const int perThread = 50000;
+    SwiftyShardedList<int> list(threadsCount, 0, 0, nullptr, false);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadsCount; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; i++)
+                list.pushBackSpread((int) t);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(list.getSize(), threadsCount * perThread);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+    std::thread reader([&]() {
+        for (size_t i = 0; i < 1000; i++) {
+            int value = 0;
+            EXPECT_TRUE(list.getLogic(i * 13 % list.getSize(), &value) == LIST_OP_OK);
+        }
+    });
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    reader.join();
+
+    long long sum = 0;
+    list.forEach([&](int v) { sum += v; });
+    EXPECT_EQ(sum, (long long) perThread * (threadsCount * (threadsCount - 1) / 2));
+}
+
+TEST(SwiftyShardedListTests, contendedRouting) {
+    SwiftyShardedList<int> list(4, 0, 0, nullptr, false);
+    for (size_t shard = 0; shard < 4; shard++) {
+        for (int i = 0; i < 1000; i++)
+            list.pushBackShard(shard, (int) shard);
+    }
+    // the first shard keeps changing size, positions below 4000 stay valid all the time
+    std::atomic<bool> done(false);
+    std::thread churn([&]() {
+        while (!done.load()) {
+            list.pushFront(-1);
+            list.popFront(nullptr);
+        }
+    });
+    size_t failed = 0;
+    for (size_t i = 0; i < 200000; i++) {
+        int value = 0;
+        failed += list.getLogic(1000 + i % 3000, &value) != LIST_OP_OK;
+    }
+    done.store(true);
+    churn.join();
+    EXPECT_EQ(failed, 0u);
+    int value = 0;
+    EXPECT_TRUE(list.getLogic(4000, &value) == LIST_OP_OVERFLOW);
+}
@@ -0,0 +1,124 @@
+//
+// Shared memory list tests
+//
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include "SwiftySharedList.hpp"
+
+static std::string sharedName(const char *test) {
+    return std::string("/swifty_") + test + "_" + std::to_string(getpid());
+}
+
+TEST(SwiftySharedListTests, readerSeesWriter) {
+    std::string name = sharedName("reader");
+    SwiftySharedList<int> writer;
+    writer.pushBack(-1);
+    ASSERT_TRUE(writer.create(name.c_str()) == LIST_OP_OK);
+    EXPECT_TRUE(writer.getList().getStorageSource() != nullptr);
+
+    SwiftySharedListView<int> view;
+    ASSERT_TRUE(view.open(name.c_str()) == LIST_OP_OK);
+    SwiftySharedListView<long long> wrongType;
+    EXPECT_TRUE(wrongType.open(name.c_str()) == LIST_OP_CORRUPTED);
+    EXPECT_EQ(view.getSize(), 1u);
+
+    // storage grows many times, every growth is a new shared memory object
+    for (int i = 0; i < 10000; i++)
+        ASSERT_TRUE(writer.pushBack(i) == LIST_OP_OK);
+    EXPECT_EQ(view.getSize(), 10001u);
+    int value = 0;
+    EXPECT_TRUE(view.getLogic(5000, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 4999);
+    EXPECT_TRUE(view.getLogic(10001, &value) == LIST_OP_OVERFLOW);
+    int range[4] = {};
+    EXPECT_TRUE(view.getLogicRange(0, 4, range) == LIST_OP_OK);
+    EXPECT_EQ(range[0], -1);
+    EXPECT_EQ(range[3], 2);
+
+    uint64_t version = view.getVersion();
+    size_t front = 0;
+    ASSERT_TRUE(writer.pushFront(-2, &front) == LIST_OP_OK);
+    ASSERT_TRUE(writer.removeLogic(100) == LIST_OP_OK);
+    EXPECT_EQ(view.getVersion(), version + 4);
+    EXPECT_FALSE(writer.getList().isOptimized());
+    EXPECT_TRUE(view.get(front, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, -2);
+    EXPECT_TRUE(view.getLogic(100, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 99);
+    size_t pos = 0;
+    EXPECT_TRUE(view.searchLogic(&pos, 500) == LIST_OP_OK);
+    EXPECT_EQ(pos, 501u);
+    EXPECT_TRUE(view.searchLogic(&pos, 98) == LIST_OP_NOTFOUND);
+
+    ASSERT_TRUE(writer.batch([](SwiftyList<int> &list) {
+        list.clear();
+        for (int i = 0; i < 100; i++)
+            list.pushBack(i * 2);
+        return LIST_OP_OK;
+    }) == LIST_OP_OK);
+    EXPECT_EQ(view.getSize(), 100u);
+    EXPECT_TRUE(view.getLogic(99, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 198);
+
+    // readers keep the last state after the writer stops sharing
+    ASSERT_TRUE(writer.close() == LIST_OP_OK);
+    EXPECT_EQ(writer.getList().getSize(), 100u);
+    EXPECT_TRUE(view.getLogic(50, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 100);
+    SwiftySharedListView<int> late;
+    EXPECT_TRUE(late.open(name.c_str()) == LIST_OP_IOERROR);
+}
+
+TEST(SwiftySharedListTests, consistentReadsWhileWriting) {
+    std::string name = sharedName("consistent");
+    SwiftySharedList<int> writer;
+    ASSERT_TRUE(writer.create(name.c_str()) == LIST_OP_OK);
+    SwiftySharedListView<int> view;
+    ASSERT_TRUE(view.open(name.c_str()) == LIST_OP_OK);
+
+    // the list always holds consecutive values, a torn read would break the sequence
+    std::atomic<bool> done(false);
+    std::thread reader([&view, &done]() {
+        int values[32];
+        while (!done.load()) {
+            if (view.getLogicRange(0, 32, values) != LIST_OP_OK)
+                continue;
+            for (int i = 1; i < 32; i++)
+                ASSERT_EQ(values[i], values[0] + i);
+        }
+    });
+    int next = 0;
+    for (int step = 0; step < 20000; step++) {
+        writer.pushBack(next++);
+        if (step % 3 == 0 && writer.getList().getSize() > 40)
+            writer.removeLogic(0);
+    }
+    done.store(true);
+    reader.join();
+}
+
+TEST(SwiftySharedListTests, otherProcessReads) {
+    std::string name = sharedName("process");
+    SwiftySharedList<long long> writer;
+    ASSERT_TRUE(writer.create(name.c_str()) == LIST_OP_OK);
+    for (long long i = 0; i < 1000; i++)
+        writer.pushBack(i * i);
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        SwiftySharedListView<long long> view;
+        long long value = 0;
+        bool ok = view.open(name.c_str()) == LIST_OP_OK && view.getSize() == 1000 &&
+                  view.getLogic(999, &value) == LIST_OP_OK && value == 999 * 999;
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
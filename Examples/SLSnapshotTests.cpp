@@ -0,0 +1,111 @@
+//
+// Copy semantics and snapshot tests
+//
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "SwiftyList.hpp"
+
+TEST(SwiftyListCopyTests, copy) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    for (int i = 0; i < 1000; i++) {
+        if (i % 2 == 0)
+            list.pushBack(i);
+        else
+            list.pushFront(i);
+    }
+    list.remove(list.begin());
+    SwiftyList<int> copy(list);
+    EXPECT_EQ(copy.getSize(), list.getSize());
+    EXPECT_EQ(copy.isOptimized(), list.isOptimized());
+    EXPECT_TRUE(copy.checkUp() == LIST_OP_OK);
+    copy.pushBack(-1);
+    copy.setLogic(0, -2);
+    int value = 0;
+    list.getLogic(0, &value);
+    EXPECT_NE(value, -2);
+    EXPECT_EQ(list.getSize(), 999);
+
+    SwiftyList<int> assigned(0, 0, nullptr, false);
+    assigned.pushBack(7);
+    assigned = copy;
+    assigned = assigned;
+    EXPECT_EQ(assigned.getSize(), 1000);
+    for (size_t i = 0; i < copy.getSize(); i++) {
+        int expected = 0;
+        copy.getLogic(i, &expected);
+        assigned.getLogic(i, &value);
+        EXPECT_EQ(value, expected);
+    }
+
+    SwiftyList<int> moved(std::move(assigned));
+    EXPECT_EQ(moved.getSize(), 1000);
+    EXPECT_EQ(assigned.getSize(), 0);
+    assigned = SwiftyList<int>(0, 0, nullptr, false);
+    assigned.pushBack(1);
+    EXPECT_EQ(assigned.getSize(), 1);
+    moved.DestructList();
+    moved.DestructList();
+}
+
+TEST(SwiftyListSnapshotTests, pointInTime) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    for (int i = 0; i < 1000; i++)
+        list.pushBack(i);
+    SwiftyListSnapshot<int> first = list.snapshot();
+    SwiftyListSnapshot<int> same = list.snapshot();
+    list.setLogic(0, -1);
+    list.pushFront(-2);
+    SwiftyListSnapshot<int> second = list.snapshot();
+    list.popBack(nullptr);
+
+    EXPECT_EQ(first.getSize(), 1000);
+    EXPECT_TRUE(first.isOptimized());
+    int value = 0;
+    EXPECT_TRUE(first.getLogic(0, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(first.getLogic(1000, &value) == LIST_OP_OVERFLOW);
+    same.getLogic(999, &value);
+    EXPECT_EQ(value, 999);
+
+    EXPECT_EQ(second.getSize(), 1001);
+    EXPECT_FALSE(second.isOptimized());
+    long long sum = 0;
+    second.forEach([&](int v) { sum += v; });
+    EXPECT_EQ(sum, 999LL * 1000 / 2 - 3);
+    second.getLogic(1000, &value);
+    EXPECT_EQ(value, 999);
+
+    SwiftyListSnapshot<int> copy = second;
+    second = SwiftyListSnapshot<int>();
+    EXPECT_TRUE(second.isEmpty());
+    list.DestructList();
+    copy.getLogic(0, &value);
+    EXPECT_EQ(value, -2);
+}
+
+TEST(SwiftyListSnapshotTests, concurrentReaders) {
+    SwiftyList<int> list(0, 0, nullptr, false);
+    for (int i = 0; i < 10000; i++)
+        list.pushBack(1);
+    std::vector<std::thread> readers;
+    std::atomic<bool> failed(false);
+    for (int r = 0; r < 3; r++) {
+        SwiftyListSnapshot<int> view = list.snapshot();
+        readers.emplace_back([view, &failed]() {
+            for (int round = 0; round < 20; round++) {
+                long long sum = 0;
+                view.forEach([&](int v) { sum += v; });
+                if (sum != (long long) view.getSize())
+                    failed = true;
+            }
+        });
+        for (int i = 0; i < 1000; i++)
+            list.insertAfter(list.begin(), 1);
+    }
+    for (auto &reader : readers)
+        reader.join();
+    EXPECT_FALSE(failed.load());
+    EXPECT_EQ(list.getSize(), 13000);
+}
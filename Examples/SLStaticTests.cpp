@@ -0,0 +1,115 @@
+//
+// Static list tests
+//
+
+#include "gtest/gtest.h"
+#include <list>
+#include <random>
+#include "SwiftyStaticList.hpp"
+
+static_assert(sizeof(SwiftyStaticList<int, 100>::Index) == 1, "100 cells fit one byte links");
+static_assert(sizeof(SwiftyStaticList<int, 255>::Index) == 2, "255 cells need two byte links");
+static_assert(sizeof(SwiftyStaticList<int, 70000>::Index) == 4, "70000 cells need four byte links");
+
+static constexpr SwiftyStaticList<int, 16> buildStatic() {
+    SwiftyStaticList<int, 16> list;
+    for (int i = 0; i < 10; i++)
+        list.pushBack(i);
+    list.pushFront(-1);
+    list.removeLogic(5);
+    list.optimize();
+    return list;
+}
+
+static constexpr SwiftyStaticList<int, 16> staticList = buildStatic();
+
+static constexpr int staticValue(size_t pos) {
+    int value = 0;
+    staticList.getLogic(pos, &value);
+    return value;
+}
+
+static_assert(staticList.getSize() == 10, "constexpr construction");
+static_assert(staticList.isOptimized(), "constexpr optimize");
+static_assert(staticValue(0) == -1 && staticValue(5) == 5 && staticValue(9) == 9, "constexpr values");
+
+TEST(SwiftyStaticListTests, constexprList) {
+    EXPECT_TRUE(staticList.checkUp() == LIST_OP_OK);
+    int expected[] = {-1, 0, 1, 2, 3, 5, 6, 7, 8, 9};
+    for (size_t i = 0; i < 10; i++) {
+        int value = 0;
+        EXPECT_TRUE(staticList.get(i + 1, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, expected[i]);
+    }
+}
+
+TEST(SwiftyStaticListTests, capacity) {
+    SwiftyStaticList<int, 4> list;
+    for (int i = 0; i < 4; i++)
+        EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+    EXPECT_TRUE(list.isFull());
+    EXPECT_TRUE(list.pushBack(4) == LIST_OP_NOMEM);
+    EXPECT_TRUE(list.insertAfterLogic(4, 4) == LIST_OP_OVERFLOW);
+    int value = 0;
+    EXPECT_TRUE(list.popFront(&value) == LIST_OP_OK);
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(list.get(1, &value) == LIST_OP_SEGFAULT);
+    EXPECT_TRUE(list.pushBack(4) == LIST_OP_OK);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+    EXPECT_FALSE(list.isOptimized());
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(list.get(i + 1, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, i + 1);
+    }
+    EXPECT_TRUE(list.clear() == LIST_OP_OK);
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_TRUE(list.popBack(&value) == LIST_OP_UNDERFLOW);
+}
+
+TEST(SwiftyStaticListTests, randomAgainstReference) {
+    const size_t capacity = 300;
+    SwiftyStaticList<int, capacity> list;
+    std::list<int> reference;
+    std::mt19937 gen(3);
+    for (int i = 0; i < 20000; i++) {
+        int op = gen() % 8;
+        size_t pos = reference.empty() ? 0 : gen() % reference.size();
+        auto it = reference.begin();
+        std::advance(it, pos);
+        if (op < 3 && reference.size() < capacity) {
+            if (reference.empty()) {
+                EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+                reference.push_back(i);
+            } else {
+                EXPECT_TRUE(list.insertBeforeLogic(pos, i) == LIST_OP_OK);
+                reference.insert(it, i);
+            }
+        } else if (op < 5 && !reference.empty()) {
+            int value = -1;
+            EXPECT_TRUE(list.popLogic(pos, &value) == LIST_OP_OK);
+            EXPECT_EQ(value, *it);
+            reference.erase(it);
+        } else if (op == 5) {
+            EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+            EXPECT_TRUE(list.isOptimized());
+        } else if (op == 6 && reference.size() < capacity) {
+            EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+            reference.push_back(i);
+        } else if (!reference.empty()) {
+            int value = -1;
+            EXPECT_TRUE(list.getLogic(pos, &value) == LIST_OP_OK);
+            EXPECT_EQ(value, *it);
+        }
+        ASSERT_TRUE(list.checkUp() == LIST_OP_OK);
+        ASSERT_EQ(list.getSize(), reference.size());
+    }
+    size_t pos = list.end();
+    for (auto it = reference.rbegin(); it != reference.rend(); ++it) {
+        int value = -1;
+        EXPECT_TRUE(list.get(pos, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, *it);
+        pos = list.prevIterator(pos);
+    }
+    EXPECT_EQ(pos, 0);
+}
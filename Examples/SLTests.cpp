@@ -4,6 +4,8 @@
 
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <algorithm>
+#include <vector>
 #include "SwiftyList.hpp"
 
 #define CAPACITY_RANGE 500
@@ -505,4 +507,658 @@ TEST(SwiftyListTests, iterators) {
             val++;
         }
     }
-}
\ No newline at end of file
+}
+TEST(SwiftyListTests, serializeBuffer) {
+    for (size_t testSize = 0; testSize < CAPACITY_RANGE; testSize += 7) {
+        SwiftyList<int> list(0, 0, nullptr, false);
+        for (size_t i = 0; i < testSize; i++) {
+            if (i % 2 == 1)
+                list.pushBack(i);
+            else
+                list.pushFront(i);
+        }
+        size_t bufferSize = list.serializedSize();
+        char *buffer = (char *) calloc(bufferSize, 1);
+        size_t written = 0;
+        EXPECT_TRUE(list.serialize(buffer, bufferSize, &written) == LIST_OP_OK);
+        EXPECT_EQ(written, bufferSize);
+
+        SwiftyList<int> restored(0, 0, nullptr, false);
+        restored.pushBack(42);
+        EXPECT_TRUE(restored.deserialize(buffer, bufferSize) == LIST_OP_OK);
+        EXPECT_TRUE(restored.checkUp() == LIST_OP_OK);
+        EXPECT_TRUE(restored.isOptimized());
+        EXPECT_EQ(restored.getSize(), testSize);
+        for (size_t i = 0; i < testSize; i++) {
+            int expected = 0, got = 0;
+            list.getLogic(i, &expected);
+            restored.getLogic(i, &got);
+            EXPECT_EQ(expected, got);
+        }
+        restored.pushBack(-1);
+        int last = 0;
+        restored.getLogic(testSize, &last);
+        EXPECT_EQ(last, -1);
+        free(buffer);
+        list.DestructList();
+        restored.DestructList();
+    }
+}
+
+TEST(SwiftyListTests, serializeStreams) {
+    SwiftyList<long long> list(0, 0, nullptr, false);
+    for (size_t i = 0; i < 100000; i++)
+        list.pushFront(i * 3);
+    list.optimize();
+    list.removeLogic(500);
+
+    FILE *file = tmpfile();
+    EXPECT_TRUE(list.serialize(file) == LIST_OP_OK);
+    rewind(file);
+    SwiftyList<long long> fromFile(0, 0, nullptr, false);
+    EXPECT_TRUE(fromFile.deserialize(file) == LIST_OP_OK);
+    fclose(file);
+
+    file = tmpfile();
+    EXPECT_TRUE(list.serialize(fileno(file)) == LIST_OP_OK);
+    lseek(fileno(file), 0, SEEK_SET);
+    SwiftyList<long long> fromFd(0, 0, nullptr, false);
+    EXPECT_TRUE(fromFd.deserialize(fileno(file)) == LIST_OP_OK);
+
+    lseek(fileno(file), 0, SEEK_SET);
+    SwiftyListReader<long long> reader(fileno(file));
+    EXPECT_TRUE(reader.open() == LIST_OP_OK);
+    EXPECT_EQ(reader.getSize(), list.getSize());
+
+    size_t iterator = list.begin();
+    long long value = 0;
+    size_t streamed = 0;
+    while (reader.next(&value) == LIST_OP_OK) {
+        long long expected = 0;
+        list.get(iterator, &expected);
+        EXPECT_EQ(value, expected);
+        iterator = list.nextIterator(iterator);
+        streamed++;
+    }
+    EXPECT_EQ(streamed, list.getSize());
+    fclose(file);
+
+    EXPECT_EQ(fromFile.getSize(), list.getSize());
+    EXPECT_EQ(fromFd.getSize(), list.getSize());
+    for (size_t i = 0; i < list.getSize(); i += 97) {
+        long long expected = 0, a = 0, b = 0;
+        list.getLogic(i, &expected);
+        fromFile.getLogic(i, &a);
+        fromFd.getLogic(i, &b);
+        EXPECT_EQ(expected, a);
+        EXPECT_EQ(expected, b);
+    }
+    list.DestructList();
+    fromFile.DestructList();
+    fromFd.DestructList();
+}
+
+TEST(SwiftyListTests, serializeCorrupted) {
+    SwiftyList<int> list(0, 0, nullptr, false);
+    for (size_t i = 0; i < 100; i++)
+        list.pushBack(i);
+    size_t bufferSize = list.serializedSize();
+    char *buffer = (char *) calloc(bufferSize, 1);
+    EXPECT_TRUE(list.serialize(buffer, bufferSize - 1) == LIST_OP_OVERFLOW);
+    EXPECT_TRUE(list.serialize(buffer, bufferSize) == LIST_OP_OK);
+
+    SwiftyList<int> restored(0, 0, nullptr, false);
+    restored.pushBack(7);
+    buffer[bufferSize - 1] ^= 1;
+    EXPECT_TRUE(restored.deserialize(buffer, bufferSize) == LIST_OP_CORRUPTED);
+    EXPECT_TRUE(restored.deserialize(buffer, bufferSize - 1) == LIST_OP_IOERROR);
+    EXPECT_EQ(restored.getSize(), 1);
+
+    // a huge size in a short buffer is rejected before storage is allocated
+    SwiftyListFileHeader header = {};
+    memcpy(&header, buffer, sizeof(header));
+    header.size = uint64_t(1) << 50;
+    memcpy(buffer, &header, sizeof(header));
+    EXPECT_TRUE(restored.deserialize(buffer, bufferSize) == LIST_OP_IOERROR);
+    EXPECT_EQ(restored.getSize(), 1);
+
+    SwiftyList<short> wrongType(0, 0, nullptr, false);
+    EXPECT_TRUE(wrongType.deserialize(buffer, bufferSize) == LIST_OP_CORRUPTED);
+    free(buffer);
+    list.DestructList();
+    restored.DestructList();
+    wrongType.DestructList();
+}
+
+/**
+ * Sort key with its insertion order. Lists take trivially copyable elements only, std::pair is not one.
+ */
+struct SortItem {
+    int first;
+    int second;
+
+    bool operator==(const SortItem &other) const {
+        return this->first == other.first && this->second == other.second;
+    }
+};
+
+TEST(SwiftyListTests, sort) {
+    auto byFirst = [](const SortItem &a, const SortItem &b) { return a.first < b.first; };
+    for (int mode = 0; mode < 2; mode++) {
+        SwiftyList<SortItem> list(0, 0, nullptr, true);
+        for (int i = 0; i < CAPACITY_RANGE; i++) {
+            SortItem value = {rand() % 50, i};
+            if (mode == 0)
+                list.pushBack(value);
+            else if (i % 2 == 0)
+                list.pushFront(value);
+            else
+                list.insertAfter(list.begin(), value);
+        }
+        EXPECT_EQ(list.isOptimized(), mode == 0);
+        std::vector<SortItem> expected;
+        size_t iterator = list.begin();
+        for (int i = 0; i < CAPACITY_RANGE; i++) {
+            SortItem value = {};
+            list.get(iterator, &value);
+            expected.push_back(value);
+            iterator = list.nextIterator(iterator);
+        }
+        std::stable_sort(expected.begin(), expected.end(), byFirst);
+
+        EXPECT_TRUE(list.sort(byFirst) == LIST_OP_OK);
+        EXPECT_TRUE(list.isOptimized());
+        EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+        EXPECT_EQ(list.getSize(), CAPACITY_RANGE);
+        for (int i = 0; i < CAPACITY_RANGE; i++) {
+            SortItem value = {};
+            list.getLogic(i, &value);
+            EXPECT_EQ(value, expected[i]);
+        }
+        list.DestructList();
+    }
+
+    SwiftyList<int> small(0, 0, nullptr, true);
+    small.pushFront(1);
+    small.pushFront(2);
+    small.popBack(nullptr);
+    EXPECT_FALSE(small.isOptimized());
+    EXPECT_TRUE(small.sort() == LIST_OP_OK);
+    EXPECT_TRUE(small.isOptimized());
+    int value = 0;
+    EXPECT_TRUE(small.getLogic(0, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 2);
+}
+
+TEST(SwiftyListTests, merge) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    SwiftyList<int> other(0, 0, nullptr, true);
+    for (int i = 0; i < CAPACITY_RANGE; i++) {
+        list.pushFront(CAPACITY_RANGE - 2 * i);
+        other.pushBack(3 * i);
+    }
+    EXPECT_TRUE(list.merge(other) == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+    EXPECT_TRUE(other.isEmpty());
+    EXPECT_EQ(list.getSize(), 2 * CAPACITY_RANGE);
+    int previous = 0;
+    list.getLogic(0, &previous);
+    for (int i = 1; i < 2 * CAPACITY_RANGE; i++) {
+        int value = 0;
+        list.getLogic(i, &value);
+        EXPECT_LE(previous, value);
+        previous = value;
+    }
+    size_t pos = 0;
+    other.pushBack(-1, &pos);
+    SwiftyListHandle merged = {}, kept = {};
+    EXPECT_TRUE(list.handleOf(list.begin(), &merged) == LIST_OP_OK);
+    EXPECT_TRUE(other.handleOf(pos, &kept) == LIST_OP_OK);
+    EXPECT_TRUE(other.merge(list, std::less<int>()) == LIST_OP_OK);
+    EXPECT_EQ(other.getSize(), 2 * CAPACITY_RANGE + 1);
+    EXPECT_TRUE(list.isEmpty());
+    // handles of the merged list are invalidated, handles of the target follow their elements
+    int value = 0;
+    EXPECT_TRUE(list.getByHandle(merged, &value) == LIST_OP_SEGFAULT);
+    EXPECT_TRUE(other.getByHandle(kept, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, -1);
+    list.DestructList();
+    other.DestructList();
+}
+
+TEST(SwiftyListTests, allocPolicy) {
+    for (int policy = 0; policy < 2; policy++) {
+        SwiftyList<int> list(0, 0, nullptr, true);
+        if (policy == 1) {
+            EXPECT_TRUE(list.setAllocPolicy(LIST_ALLOC_NEAREST) == LIST_OP_OK);
+        }
+        for (int i = 0; i < CAPACITY_RANGE; i++)
+            list.pushBack(i);
+        int value = 0;
+        list.popBack(&value);
+        list.remove(50);
+        size_t physPos = 0;
+        list.pushBack(value, &physPos);
+        EXPECT_EQ(physPos, (policy == 1) ? CAPACITY_RANGE : 50);
+
+        list.remove(300);
+        list.remove(100);
+        list.insertAfter(299, 299, &physPos);
+        EXPECT_EQ(physPos, (policy == 1) ? 300 : 100);
+        if (policy == 0) {
+            EXPECT_TRUE(list.setAllocPolicy(LIST_ALLOC_NEAREST) == LIST_OP_OK);
+        }
+        list.insertAfter(49, 49, &physPos);
+        EXPECT_EQ(physPos, (policy == 1) ? 50 : 300);
+        list.insertAfter(99, 99, &physPos);
+        EXPECT_EQ(physPos, (policy == 1) ? 100 : CAPACITY_RANGE);
+        EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+        std::vector<int> model;
+        for (int i = 0; i < CAPACITY_RANGE; i++) {
+            list.getLogic(i, &value);
+            model.push_back(value);
+        }
+        for (int i = 0; i < 20 * CAPACITY_RANGE; i++) {
+            size_t pos = rand() % model.size();
+            if (rand() % 2 == 0 && model.size() > 1) {
+                list.removeLogic(pos);
+                model.erase(model.begin() + pos);
+            } else {
+                list.insertAfterLogic(pos, i);
+                model.insert(model.begin() + pos + 1, i);
+            }
+        }
+        EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+        EXPECT_EQ(list.getSize(), model.size());
+        for (size_t i = 0; i < model.size(); i++) {
+            list.getLogic(i, &value);
+            EXPECT_EQ(value, model[i]);
+        }
+        EXPECT_TRUE(list.setAllocPolicy(LIST_ALLOC_LIFO) == LIST_OP_OK);
+        list.DestructList();
+    }
+}
+
+TEST(SwiftyListTests, optimizeRange) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    std::vector<int> model;
+    for (int i = 0; i < CAPACITY_RANGE; i++) {
+        size_t pos = model.empty() ? 0 : rand() % model.size();
+        if (model.empty())
+            list.pushBack(i);
+        else
+            list.insertAfterLogic(pos, i);
+        model.insert(model.begin() + (model.empty() ? 0 : pos + 1), i);
+    }
+    EXPECT_FALSE(list.isOptimized());
+    EXPECT_TRUE(list.optimizeRange(10, CAPACITY_RANGE + 1) == LIST_OP_OVERFLOW);
+    EXPECT_TRUE(list.optimizeRange(100, 300) == LIST_OP_OK);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+    EXPECT_FALSE(list.isOptimized());
+    size_t first = list.logicToPhysic(100);
+    for (size_t i = 0; i < 200; i++)
+        EXPECT_EQ(list.logicToPhysic(100 + i), first + i);
+    for (int i = 0; i < CAPACITY_RANGE; i++) {
+        int value = 0;
+        list.getLogic(i, &value);
+        EXPECT_EQ(value, model[i]);
+    }
+    size_t capacity = list.getCapacity();
+    EXPECT_TRUE(list.optimizeRange(100, 300) == LIST_OP_OK);
+    EXPECT_EQ(list.logicToPhysic(100), first);
+    EXPECT_EQ(list.getCapacity(), capacity);
+
+    // windows are laid out in place, so moving hot windows around never grows storage
+    SwiftyListHandle handle = {};
+    EXPECT_TRUE(list.handleOfLogic(150, &handle) == LIST_OP_OK);
+    for (int i = 0; i < 100; i += 3)
+        list.remove(list.logicToPhysic(rand() % list.getSize()));
+    list.pushBack(-1);
+    int held = 0;
+    EXPECT_TRUE(list.getByHandle(handle, &held) == LIST_OP_OK);
+    std::vector<int> values(list.getSize());
+    for (size_t i = 0; i < values.size(); i++)
+        list.getLogic(i, &values[i]);
+    capacity = list.getCapacity();
+    for (int round = 0; round < 200; round++) {
+        size_t from = rand() % (list.getSize() - 50);
+        size_t to = from + 2 + rand() % 48;
+        EXPECT_TRUE(list.optimizeRange(from, to) == LIST_OP_OK);
+        ASSERT_TRUE(list.validate() == LIST_OP_OK);
+        size_t start = list.logicToPhysic(from);
+        for (size_t i = from; i < to; i++)
+            ASSERT_EQ(list.logicToPhysic(i), start + i - from);
+    }
+    EXPECT_EQ(list.getCapacity(), capacity);
+    for (size_t i = 0; i < values.size(); i++) {
+        int value = 0;
+        list.getLogic(i, &value);
+        EXPECT_EQ(value, values[i]);
+    }
+    int followed = 0;
+    EXPECT_TRUE(list.getByHandle(handle, &followed) == LIST_OP_OK);
+    EXPECT_EQ(followed, held);
+    list.DestructList();
+}
+
+TEST(SwiftyListTests, compact) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    std::vector<int> model;
+    for (int i = 0; i < 4 * CAPACITY_RANGE; i++) {
+        list.pushBack(i);
+        model.push_back(i);
+    }
+    for (int i = 0; i < 3 * CAPACITY_RANGE; i++) {
+        size_t pos = rand() % model.size();
+        list.removeLogic(pos);
+        model.erase(model.begin() + pos);
+    }
+    EXPECT_TRUE(list.compact() == LIST_OP_OK);
+    EXPECT_EQ(list.getCapacity(), list.getSize());
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+    for (size_t i = 0; i < model.size(); i++) {
+        int value = 0;
+        list.getLogic(i, &value);
+        EXPECT_EQ(value, model[i]);
+        EXPECT_LE(list.logicToPhysic(i), list.getSize());
+    }
+    for (int i = 0; i < CAPACITY_RANGE; i++) {
+        list.pushFront(i);
+        model.insert(model.begin(), i);
+    }
+    EXPECT_TRUE(list.shrinkToFit() == LIST_OP_OK);
+    EXPECT_EQ(list.getCapacity(), model.size());
+    int value = 0;
+    list.getLogic(0, &value);
+    EXPECT_EQ(value, model[0]);
+    list.clear();
+    EXPECT_TRUE(list.compact() == LIST_OP_OK);
+    EXPECT_EQ(list.getCapacity(), SWIFTY_LIST_INLINE_CAPACITY);
+    list.pushBack(1);
+    EXPECT_EQ(list.getSize(), 1);
+    list.DestructList();
+}
+
+TEST(SwiftyListTests, logicBatch) {
+    for (int mode = 0; mode < 2; mode++) {
+        SwiftyList<int> list(0, 0, nullptr, true);
+        std::vector<int> model;
+        for (int i = 0; i < CAPACITY_RANGE; i++) {
+            if (mode == 0 || i % 2 == 0) {
+                list.pushBack(i);
+                model.push_back(i);
+            } else {
+                list.pushFront(i);
+                model.insert(model.begin(), i);
+            }
+        }
+        EXPECT_EQ(list.isOptimized(), mode == 0);
+
+        std::vector<size_t> positions;
+        for (int i = 0; i < 100; i++)
+            positions.push_back(rand() % CAPACITY_RANGE);
+        positions.push_back(positions[0]);
+        std::vector<int> values(positions.size());
+        EXPECT_TRUE(list.getLogicBatch(positions.data(), positions.size(), values.data()) == LIST_OP_OK);
+        for (size_t i = 0; i < positions.size(); i++)
+            EXPECT_EQ(values[i], model[positions[i]]);
+
+        for (size_t i = 0; i < positions.size(); i++) {
+            values[i] = -(int) i;
+            model[positions[i]] = values[i];
+        }
+        EXPECT_TRUE(list.setLogicBatch(positions.data(), positions.size(), values.data()) == LIST_OP_OK);
+        for (int i = 0; i < CAPACITY_RANGE; i++) {
+            int value = 0;
+            list.getLogic(i, &value);
+            EXPECT_EQ(value, model[i]);
+        }
+
+        positions.push_back(CAPACITY_RANGE);
+        EXPECT_TRUE(list.removeLogicBatch(positions.data(), positions.size()) == LIST_OP_OVERFLOW);
+        EXPECT_EQ(list.getSize(), CAPACITY_RANGE);
+        positions.pop_back();
+        EXPECT_TRUE(list.removeLogicBatch(positions.data(), positions.size()) == LIST_OP_OK);
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+        for (size_t i = positions.size(); i-- > 0;)
+            model.erase(model.begin() + positions[i]);
+        EXPECT_EQ(list.getSize(), model.size());
+        EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+        for (size_t i = 0; i < model.size(); i++) {
+            int value = 0;
+            list.getLogic(i, &value);
+            EXPECT_EQ(value, model[i]);
+        }
+        list.DestructList();
+    }
+}
+
+TEST(SwiftyListTests, handles) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    std::vector<SwiftyListHandle> handles;
+    for (int i = 0; i < CAPACITY_RANGE; i++) {
+        size_t pos = 0;
+        if (i % 2 == 0)
+            list.pushBack(i, &pos);
+        else
+            list.pushFront(i, &pos);
+        SwiftyListHandle handle = {};
+        EXPECT_TRUE(list.handleOf(pos, &handle) == LIST_OP_OK);
+        handles.push_back(handle);
+    }
+    SwiftyListHandle again = {};
+    EXPECT_TRUE(list.handleOfLogic(0, &again) == LIST_OP_OK);
+    EXPECT_EQ(again.index, handles[CAPACITY_RANGE - 1].index);
+
+    auto expectValues = [&]() {
+        for (int i = 0; i < CAPACITY_RANGE; i++) {
+            int value = -1;
+            if (i % 3 == 0) {
+                EXPECT_TRUE(list.getByHandle(handles[i], &value) == LIST_OP_SEGFAULT);
+                continue;
+            }
+            EXPECT_TRUE(list.getByHandle(handles[i], &value) == LIST_OP_OK);
+            EXPECT_EQ(value, i);
+        }
+    };
+    for (int i = 0; i < CAPACITY_RANGE; i += 3)
+        EXPECT_TRUE(list.removeByHandle(handles[i]) == LIST_OP_OK);
+    expectValues();
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    expectValues();
+    for (int i = 0; i < CAPACITY_RANGE; i++)
+        list.pushFront(-i);
+    for (int i = 0; i < CAPACITY_RANGE; i++)
+        list.popFront(nullptr);
+    expectValues();
+    EXPECT_TRUE(list.compact() == LIST_OP_OK);
+    expectValues();
+    EXPECT_TRUE(list.optimizeRange(10, 100) == LIST_OP_OK);
+    expectValues();
+    EXPECT_TRUE(list.sort() == LIST_OP_OK);
+    expectValues();
+    EXPECT_TRUE(list.swapLogic(0, 1) == LIST_OP_OK);
+    expectValues();
+
+    SwiftyListHandle inserted = {};
+    EXPECT_TRUE(list.insertAfterByHandle(handles[1], 1000, &inserted) == LIST_OP_OK);
+    EXPECT_TRUE(list.setByHandle(inserted, 1001) == LIST_OP_OK);
+    size_t pos = 0;
+    EXPECT_TRUE(list.handlePos(handles[1], &pos) == LIST_OP_OK);
+    int value = 0;
+    EXPECT_TRUE(list.get(list.nextIterator(pos), &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 1001);
+    EXPECT_TRUE(list.popByHandle(inserted, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 1001);
+    EXPECT_TRUE(list.getByHandle(inserted, &value) == LIST_OP_SEGFAULT);
+
+    SwiftyList<int> copy(list);
+    EXPECT_TRUE(copy.getByHandle(handles[2], &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(list.releaseHandle(handles[2]) == LIST_OP_OK);
+    EXPECT_TRUE(list.getByHandle(handles[2], &value) == LIST_OP_SEGFAULT);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+    list.clear();
+    EXPECT_TRUE(list.getByHandle(handles[1], &value) == LIST_OP_SEGFAULT);
+    list.pushBack(5, &pos);
+    SwiftyListHandle reused = {};
+    EXPECT_TRUE(list.handleOf(pos, &reused) == LIST_OP_OK);
+    for (const SwiftyListHandle &stale : handles) {
+        if (stale.index == reused.index) {
+            EXPECT_TRUE(list.getByHandle(stale, &value) == LIST_OP_SEGFAULT);
+        }
+    }
+    EXPECT_TRUE(list.getByHandle(reused, &value) == LIST_OP_OK);
+    list.DestructList();
+}
+
+TEST(SwiftyListTests, moveAfter) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    size_t positions[5] = {};
+    for (int i = 0; i < 5; i++)
+        list.pushBack(i, &positions[i]);
+    EXPECT_TRUE(list.moveToFront(positions[3]) == LIST_OP_OK);
+    EXPECT_FALSE(list.isOptimized());
+    EXPECT_TRUE(list.moveToBack(positions[0]) == LIST_OP_OK);
+    EXPECT_TRUE(list.moveAfter(positions[1], positions[4]) == LIST_OP_OK);
+    EXPECT_TRUE(list.moveAfter(positions[2], positions[2]) == LIST_OP_OK);
+    EXPECT_TRUE(list.moveAfter(positions[2], 100) == LIST_OP_OVERFLOW);
+
+    int expected[] = {3, 2, 4, 1, 0};
+    for (int i = 0; i < 5; i++) {
+        int value = -1;
+        EXPECT_TRUE(list.getLogic(i, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, expected[i]);
+    }
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+    list.DestructList();
+}
+
+TEST(SwiftyListTests, inlineStorage) {
+    SwiftyList<int> list(0, 0, nullptr, true);
+    EXPECT_EQ(list.getCapacity(), SWIFTY_LIST_INLINE_CAPACITY);
+    for (int i = 0; i < (int) SWIFTY_LIST_INLINE_CAPACITY; i++)
+        EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+    EXPECT_EQ(list.getCapacity(), SWIFTY_LIST_INLINE_CAPACITY);
+
+    SwiftyList<int> copy(list);
+    SwiftyList<int> moved(std::move(copy));
+    SwiftyListSnapshot<int> snapshot = list.snapshot();
+    EXPECT_TRUE(list.pushBack(100) == LIST_OP_OK);
+    EXPECT_GT(list.getCapacity(), SWIFTY_LIST_INLINE_CAPACITY);
+    EXPECT_TRUE(list.popFront(nullptr) == LIST_OP_OK);
+    EXPECT_TRUE(list.popFront(nullptr) == LIST_OP_OK);
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    EXPECT_EQ(list.getCapacity(), SWIFTY_LIST_INLINE_CAPACITY);
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+
+    EXPECT_EQ(snapshot.getSize(), SWIFTY_LIST_INLINE_CAPACITY);
+    EXPECT_EQ(moved.getSize(), SWIFTY_LIST_INLINE_CAPACITY);
+    for (int i = 0; i < (int) SWIFTY_LIST_INLINE_CAPACITY; i++) {
+        int value = -1;
+        EXPECT_TRUE(snapshot.getLogic(i, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(moved.getLogic(i, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, i);
+        if (i + 2 < (int) SWIFTY_LIST_INLINE_CAPACITY) {
+            EXPECT_TRUE(list.getLogic(i, &value) == LIST_OP_OK);
+            EXPECT_EQ(value, i + 2);
+        }
+    }
+    EXPECT_TRUE(list.get(SWIFTY_LIST_INLINE_CAPACITY, nullptr) == LIST_OP_SEGFAULT);
+    EXPECT_TRUE(list.get(1000, nullptr) == LIST_OP_SEGFAULT);
+}
+
+/**
+ * Heap storage the test can reach, nodes are laid out as SwiftyList nodes
+ */
+struct ExposedStorage : SwiftyListStorageSource {
+    struct Node {
+        int    value;
+        size_t next;
+        size_t previous;
+        bool   valid;
+    };
+
+    Node *nodes = nullptr;
+
+    void *allocate(size_t bytes, size_t *actualBytes) override {
+        *actualBytes = bytes;
+        this->nodes = (Node *) malloc(bytes);
+        return this->nodes;
+    }
+
+    void release(void *storage) override {
+        free(storage);
+    }
+};
+
+TEST(SwiftyListTests, validate) {
+    ExposedStorage source;
+    SwiftyList<int> list(0, 0, nullptr, false);
+    ASSERT_TRUE(list.setStorageSource(&source) == LIST_OP_OK);
+    for (int i = 0; i < 2000; i++)
+        list.pushBack(i);
+    for (int i = 0; i < 100; i++)
+        list.popBack(nullptr);
+    ASSERT_TRUE(list.isOptimized());
+    SwiftyListValidation report = {};
+    EXPECT_TRUE(list.validate(&report) == LIST_OP_OK);
+    EXPECT_EQ(report.invariant, LIST_INVARIANT_NONE);
+
+    // elements are in cells 1..1900, free list is 1901 -> 1902 -> ... -> 2000
+    ExposedStorage::Node *nodes = source.nodes;
+    auto expectBroken = [&](SwiftyListInvariant invariant, size_t pos, auto corrupt) {
+        std::vector<ExposedStorage::Node> saved(nodes, nodes + 2001);
+        corrupt();
+        EXPECT_TRUE(list.validate(&report) == LIST_OP_CORRUPTED);
+        EXPECT_EQ(report.invariant, invariant);
+        EXPECT_EQ(report.pos, pos);
+        std::copy(saved.begin(), saved.end(), nodes);
+        EXPECT_TRUE(list.validate() == LIST_OP_OK);
+    };
+    expectBroken(LIST_INVARIANT_LINK_RANGE, 1, [&]() { nodes[1].next = 1u << 30; });
+    expectBroken(LIST_INVARIANT_LINK_TARGET, 0, [&]() { nodes[0].next = 1950; });
+    expectBroken(LIST_INVARIANT_LINK_SYMMETRY, 2, [&]() {
+        // checkUp only follows next links and does not notice it
+        nodes[3].previous = 1;
+        EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+    });
+    expectBroken(LIST_INVARIANT_OPTIMIZED, 0, [&]() {
+        // consistent links, but cells 1 and 2 are in reverse logical order
+        nodes[0].next = 2;
+        nodes[2].previous = 0;
+        nodes[2].next = 1;
+        nodes[1].previous = 2;
+        nodes[1].next = 3;
+        nodes[3].previous = 1;
+    });
+    expectBroken(LIST_INVARIANT_FREE_LIST, 1950, [&]() { nodes[1950].previous = 1901; });
+    expectBroken(LIST_INVARIANT_FREE_SIZE, 1950, [&]() { nodes[1950].next = 1950; });
+    expectBroken(LIST_INVARIANT_FREE_LIST, 1901, [&]() { nodes[2000].next = 1901; });
+
+    ExposedStorage ringSource;
+    SwiftyList<int> ring(0, 0, nullptr, false);
+    ASSERT_TRUE(ring.setStorageSource(&ringSource) == LIST_OP_OK);
+    for (int i = 0; i < 100; i++)
+        ring.pushFront(i);
+    ASSERT_FALSE(ring.isOptimized());
+    EXPECT_TRUE(ring.validate() == LIST_OP_OK);
+    nodes = ringSource.nodes;
+    ASSERT_EQ(nodes[0].next, 100u);
+    // the first element is taken out of the ring and linked to itself: two rings
+    nodes[0].next = 99;
+    nodes[99].previous = 0;
+    nodes[100].next = 100;
+    nodes[100].previous = 100;
+    EXPECT_TRUE(ring.validate(&report) == LIST_OP_CORRUPTED);
+    EXPECT_EQ(report.invariant, LIST_INVARIANT_CHAIN);
+    nodes[0].next = 100;
+    nodes[99].previous = 100;
+    nodes[100].next = 99;
+    nodes[100].previous = 0;
+    EXPECT_TRUE(ring.validate() == LIST_OP_OK);
+}
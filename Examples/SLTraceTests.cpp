@@ -0,0 +1,139 @@
+//
+// Workload trace tests
+//
+
+#include "gtest/gtest.h"
+#include <vector>
+#include "SwiftyFrozenList.hpp"
+#include "SwiftyListTrace.hpp"
+
+TEST(SwiftyListTraceTests, recordAndRead) {
+    FILE *file = tmpfile();
+    SwiftyList<int> list(0, 0, nullptr, false);
+    list.pushBack(10);
+    list.pushBack(20);
+    SwiftyListTraceWriter writer(file, sizeof(int));
+    EXPECT_TRUE(list.setRecorder(&writer) == LIST_OP_OK);
+
+    size_t physPos = 0;
+    list.pushFront(5, &physPos);
+    list.insertAfterLogic(1, 15);
+    int value = 0;
+    list.getLogic(2, &value);
+    list.swap(physPos, 1);
+    list.removeLogic(0);
+    size_t found = 0;
+    list.search(&found, 20);
+    list.optimize();
+    list.setRecorder(nullptr);
+    list.pushBack(30);
+    EXPECT_TRUE(writer.flush() == LIST_OP_OK);
+    EXPECT_EQ(writer.getRecordsCount(), 9);
+
+    rewind(file);
+    SwiftyListTraceReader reader(file);
+    EXPECT_TRUE(reader.open() == LIST_OP_OK);
+    EXPECT_EQ(reader.getElemSize(), sizeof(int));
+    std::vector<SwiftyListTraceRecord> records;
+    std::vector<int> values;
+    SwiftyListTraceRecord record = {};
+    while (reader.next(&record) == LIST_OP_OK) {
+        records.push_back(record);
+        values.push_back(record.value != nullptr ? *(const int *) record.value : -1);
+    }
+    EXPECT_TRUE(reader.next(&record) == LIST_OP_UNDERFLOW);
+
+    SwiftyListTraceOp expected[] = {TRACE_OP_INITIAL, TRACE_OP_INITIAL, TRACE_OP_PUSH_FRONT,
+                                    TRACE_OP_INSERT_AFTER_LOGIC, TRACE_OP_GET_LOGIC, TRACE_OP_SWAP,
+                                    TRACE_OP_REMOVE_LOGIC, TRACE_OP_SEARCH, TRACE_OP_OPTIMIZE};
+    ASSERT_EQ(records.size(), sizeof(expected) / sizeof(expected[0]));
+    for (size_t i = 0; i < records.size(); i++)
+        EXPECT_EQ(records[i].op, expected[i]);
+    EXPECT_EQ(values[0], 10);
+    EXPECT_EQ(records[1].second, 2);
+    EXPECT_EQ(records[2].second, physPos);
+    EXPECT_EQ(values[2], 5);
+    EXPECT_EQ(records[3].first, 1);
+    EXPECT_EQ(values[3], 15);
+    EXPECT_EQ(records[4].first, 2);
+    EXPECT_EQ(records[5].first, physPos);
+    EXPECT_EQ(records[5].second, 1);
+    EXPECT_EQ(values[7], 20);
+    fclose(file);
+}
+
+TEST(SwiftyListTraceTests, corrupted) {
+    FILE *file = tmpfile();
+    fputs("definitely not a trace", file);
+    rewind(file);
+    SwiftyListTraceReader reader(file);
+    EXPECT_TRUE(reader.open() == LIST_OP_CORRUPTED);
+    fclose(file);
+
+    file = tmpfile();
+    SwiftyListTraceWriter writer(file, sizeof(int));
+    int value = 7;
+    writer.record(TRACE_OP_SET_LOGIC, 300, 0, &value);
+    EXPECT_TRUE(writer.flush() == LIST_OP_OK);
+    long size = ftell(file);
+    std::vector<char> bytes(size);
+    rewind(file);
+    EXPECT_EQ(fread(bytes.data(), 1, size, file), (size_t) size);
+    fclose(file);
+
+    file = tmpfile();
+    fwrite(bytes.data(), 1, size - 1, file);
+    rewind(file);
+    SwiftyListTraceReader truncated(file);
+    EXPECT_TRUE(truncated.open() == LIST_OP_OK);
+    SwiftyListTraceRecord record = {};
+    EXPECT_TRUE(truncated.next(&record) == LIST_OP_CORRUPTED);
+    fclose(file);
+}
+
+TEST(SwiftyListTraceTests, unrecordedMutations) {
+    FILE *file = tmpfile();
+    SwiftyList<int> list(0, 0, nullptr, false);
+    for (int i = 0; i < 10; i++)
+        list.pushFront(i);
+    SwiftyListTraceWriter writer(file, sizeof(int));
+    EXPECT_TRUE(list.setRecorder(&writer) == LIST_OP_OK);
+
+    size_t positions[] = {1, 3};
+    int values[] = {7, 8};
+    list.setLogicBatch(positions, 2, values);
+    list.removeLogicBatch(positions, 2);
+    SwiftyListHandle handle = {};
+    list.handleOfLogic(0, &handle);
+    list.setByHandle(handle, 1);
+    list.insertAfterByHandle(handle, 2);
+    list.optimizeRange(0, 3);
+    list.sort();
+    list.compact();
+    SwiftyList<int> other(0, 0, nullptr, false);
+    other.pushBack(4);
+    list.merge(other);
+    list.removeByHandle(handle);
+    FrozenSwiftyList<int> frozen;
+    EXPECT_TRUE(list.freeze(&frozen) == LIST_OP_OK);
+    EXPECT_TRUE(frozen.thaw(&list) == LIST_OP_OK);
+    EXPECT_TRUE(writer.flush() == LIST_OP_OK);
+
+    rewind(file);
+    SwiftyListTraceReader reader(file);
+    EXPECT_TRUE(reader.open() == LIST_OP_OK);
+    SwiftyListTraceRecord record = {};
+    size_t initial = 0;
+    size_t unrecorded = 0;
+    while (reader.next(&record) == LIST_OP_OK) {
+        if (record.op == TRACE_OP_INITIAL)
+            initial++;
+        else
+            EXPECT_EQ(record.op, TRACE_OP_UNRECORDED);
+        if (record.op == TRACE_OP_UNRECORDED)
+            unrecorded++;
+    }
+    EXPECT_EQ(initial, 10);
+    EXPECT_EQ(unrecorded, 10);
+    fclose(file);
+}
@@ -0,0 +1,140 @@
+//
+// Unrolled list tests
+//
+
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include "SwiftyUnrolledList.hpp"
+
+TEST(SwiftyUnrolledListTests, pushAndGet) {
+    SwiftyUnrolledList<int, 4> list(0, true);
+    for (int i = 0; i < 100; i++)
+        EXPECT_TRUE(list.pushBack(i) == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    EXPECT_EQ(list.getSize(), 100);
+    EXPECT_EQ(list.getBlocksCount(), 25);
+    for (int i = 0; i < 100; i++) {
+        int value = -1;
+        EXPECT_TRUE(list.getLogic(i, &value) == LIST_OP_OK);
+        EXPECT_EQ(value, i);
+    }
+    int value = 0;
+    EXPECT_TRUE(list.getLogic(100, &value) == LIST_OP_OVERFLOW);
+    EXPECT_TRUE(list.popBack(&value) == LIST_OP_OK);
+    EXPECT_EQ(value, 99);
+    EXPECT_TRUE(list.isOptimized());
+    EXPECT_TRUE(list.popFront(&value) == LIST_OP_OK);
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(list.isOptimized());
+    EXPECT_TRUE(list.checkUp() == LIST_OP_OK);
+}
+
+TEST(SwiftyUnrolledListTests, physicalPositions) {
+    SwiftyUnrolledList<int, 4> list(0, true);
+    size_t first = 0, second = 0, third = 0;
+    EXPECT_TRUE(list.pushBack(1, &first) == LIST_OP_OK);
+    EXPECT_TRUE(list.insertAfter(first, 3, &third) == LIST_OP_OK);
+    EXPECT_TRUE(list.insertBefore(third, 2, &second) == LIST_OP_OK);
+    EXPECT_TRUE(list.insertAfter(0, 0) == LIST_OP_OK);
+    EXPECT_TRUE(list.insertBefore(0, 4) == LIST_OP_OK);
+
+    std::vector<int> values;
+    for (size_t pos = list.begin(); pos != 0; pos = list.nextIterator(pos)) {
+        int value = 0;
+        EXPECT_TRUE(list.get(pos, &value) == LIST_OP_OK);
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, std::vector<int>({0, 1, 2, 3, 4}));
+
+    values.clear();
+    for (size_t pos = list.end(); pos != 0; pos = list.prevIterator(pos)) {
+        int value = 0;
+        list.get(pos, &value);
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, std::vector<int>({4, 3, 2, 1, 0}));
+
+    size_t found = 0;
+    EXPECT_TRUE(list.search(&found, 3) == LIST_OP_OK);
+    EXPECT_TRUE(list.set(found, 30) == LIST_OP_OK);
+    EXPECT_TRUE(list.searchLogic(&found, 30) == LIST_OP_OK);
+    EXPECT_EQ(found, 3);
+    EXPECT_TRUE(list.searchLogic(&found, 42) == LIST_OP_NOTFOUND);
+    EXPECT_TRUE(list.get(1, nullptr) == LIST_OP_SEGFAULT);
+    EXPECT_TRUE(list.remove(list.end() + 1) == LIST_OP_SEGFAULT);
+}
+
+TEST(SwiftyUnrolledListTests, randomAgainstVector) {
+    SwiftyUnrolledList<int, 8> list(0, true);
+    std::vector<int> expected;
+    std::mt19937 generator(7);
+    for (int i = 0; i < 20000; i++) {
+        size_t size = expected.size();
+        int op = generator() % 8;
+        int value = (int) generator();
+        if (size == 0 || op == 0) {
+            EXPECT_TRUE(list.pushBack(value) == LIST_OP_OK);
+            expected.push_back(value);
+        } else if (op == 1) {
+            EXPECT_TRUE(list.pushFront(value) == LIST_OP_OK);
+            expected.insert(expected.begin(), value);
+        } else if (op == 2) {
+            size_t pos = generator() % size;
+            EXPECT_TRUE(list.insertAfterLogic(pos, value) == LIST_OP_OK);
+            expected.insert(expected.begin() + pos + 1, value);
+        } else if (op == 3) {
+            size_t pos = generator() % size;
+            EXPECT_TRUE(list.insertBeforeLogic(pos, value) == LIST_OP_OK);
+            expected.insert(expected.begin() + pos, value);
+        } else if (op == 4 || op == 5) {
+            size_t pos = generator() % size;
+            int popped = 0;
+            EXPECT_TRUE(list.popLogic(pos, &popped) == LIST_OP_OK);
+            EXPECT_EQ(popped, expected[pos]);
+            expected.erase(expected.begin() + pos);
+        } else if (op == 6) {
+            size_t first = generator() % size, second = generator() % size;
+            EXPECT_TRUE(list.swapLogic(first, second) == LIST_OP_OK);
+            std::swap(expected[first], expected[second]);
+        } else if (i % 1000 == 7) {
+            EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+            EXPECT_TRUE(list.isOptimized());
+        } else {
+            size_t pos = generator() % size;
+            EXPECT_TRUE(list.setLogic(pos, value) == LIST_OP_OK);
+            expected[pos] = value;
+        }
+        ASSERT_EQ(list.getSize(), expected.size());
+    }
+    for (size_t i = 0; i < expected.size(); i++) {
+        int value = 0;
+        list.getLogic(i, &value);
+        ASSERT_EQ(value, expected[i]);
+    }
+    EXPECT_GE(list.getBlocksCount() * 8, expected.size());
+    EXPECT_LE(list.getBlocksCount() * 2, expected.size() + 8);
+}
+
+TEST(SwiftyUnrolledListTests, optimize) {
+    SwiftyUnrolledList<int, 4> list(0, true);
+    for (int i = 0; i < 50; i++)
+        list.pushFront(i);
+    for (int i = 0; i < 10; i++)
+        list.removeLogic(5);
+    EXPECT_FALSE(list.isOptimized());
+    EXPECT_TRUE(list.optimize() == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    EXPECT_EQ(list.getBlocksCount(), 10);
+    EXPECT_EQ(list.logicToPhysic(6), 2 * 4 + 2);
+    int value = 0;
+    list.getLogic(6, &value);
+    EXPECT_EQ(value, 33);
+    EXPECT_TRUE(list.pushBack(100) == LIST_OP_OK);
+    EXPECT_TRUE(list.isOptimized());
+    EXPECT_TRUE(list.getLogic(40, &value) == LIST_OP_OK);
+    EXPECT_EQ(value, 100);
+    EXPECT_TRUE(list.clear() == LIST_OP_OK);
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_TRUE(list.popBack(&value) == LIST_OP_UNDERFLOW);
+}
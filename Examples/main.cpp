@@ -3,8 +3,10 @@
 
 #include "SwiftyList.hpp"
 const size_t stressElements = 10;
+const size_t serializeElements = 10000000;
 
 #define TIME_MEASURED(code){clock_t begin = clock();code;clock_t end = clock(); double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC; printf("ELAPSED: %lf sec\n", elapsed_secs);}
+#define THROUGHPUT_MEASURED(bytes, code){clock_t begin = clock();code;clock_t end = clock(); double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC; printf("ELAPSED: %lf sec, %.1lf MB/s\n", elapsed_secs, double(bytes) / 1e6 / elapsed_secs);}
 #define TIME_LIMIT(sec) if (double(clock() - begin) / CLOCKS_PER_SEC > sec) {printf("\tReached time limit! "); break;}
 
 int main() {
@@ -117,6 +119,35 @@ int main() {
                       }
                   })
 
+    list.DestructList();
+    list = SwiftyList<int> (20, 0, nullptr, false);
+    for (size_t i = 0; i < serializeElements; i++)
+        list.pushBack((int)i);
+
+    FILE* serialized = tmpfile();
+    printf("Serializing optimized %zu elements...\n", serializeElements);
+    THROUGHPUT_MEASURED(list.serializedSize(), {
+                            list.serialize(serialized);
+                            fflush(serialized);
+                        })
+
+    printf("Deserializing %zu elements...\n", serializeElements);
+    THROUGHPUT_MEASURED(list.serializedSize(), {
+                            rewind(serialized);
+                            list.deserialize(serialized);
+                        })
+
+    list.deOptimize();
+    for (size_t i = 0; i < serializeElements / 10; i++)
+        list.pushFront((int)i);
+    rewind(serialized);
+    printf("Serializing de-optimized %zu elements...\n", list.getSize());
+    THROUGHPUT_MEASURED(list.serializedSize(), {
+                            list.serialize(serialized);
+                            fflush(serialized);
+                        })
+    fclose(serialized);
+    list.DestructList();
 
     return 0;
 }
@@ -0,0 +1,578 @@
+/**
+ * SwiftyAggregateList - SwiftyList answering range aggregates over logical positions
+ *
+ * Physical positions are grouped in logical order into blocks of about sqrt(n),
+ * every block keeps the monoid aggregate of its values. An update changes one block:
+ * inserting into a full block splits it, emptied blocks are unlinked, and all blocks
+ * are rebuilt once their size drifts too far from sqrt(n). aggregate(), getLogic() and
+ * setLogic() walk blocks instead of elements, so they run in O(sqrt(n)) whether the
+ * list is optimized or not.
+ *
+ * Monoid provides Value, identity(), of(element) and combine(left, right).
+ * combine() must be associative, it does not have to be commutative.
+ */
+
+#ifndef SwiftyAggregateList_hpp
+#define SwiftyAggregateList_hpp
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include "SwiftyList.hpp"
+
+const size_t AGGREGATE_MIN_BLOCK = 16;
+
+template<typename T>
+struct SwiftySumMonoid {
+    using Value = T;
+
+    static T identity() { return T(); }
+
+    static T of(const T &value) { return value; }
+
+    static T combine(const T &left, const T &right) { return left + right; }
+};
+
+template<typename T>
+struct SwiftyMinMonoid {
+    using Value = T;
+
+    static T identity() { return std::numeric_limits<T>::max(); }
+
+    static T of(const T &value) { return value; }
+
+    static T combine(const T &left, const T &right) { return (right < left) ? right : left; }
+};
+
+template<typename T>
+struct SwiftyMaxMonoid {
+    using Value = T;
+
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+
+    static T of(const T &value) { return value; }
+
+    static T combine(const T &left, const T &right) { return (left < right) ? right : left; }
+};
+
+template<typename ListElem, typename Monoid = SwiftySumMonoid<ListElem>>
+struct SwiftyAggregateList {
+public:
+    using Value = typename Monoid::Value;
+
+private:
+    /**
+     * Linked in logical order, 0 is the sentinel as in SwiftyList
+     */
+    struct Block {
+        size_t next;
+        size_t previous;
+        size_t count;
+        Value  aggregate;
+    };
+
+    SwiftyList<ListElem> list;
+    Block                *blocks;
+    size_t               *slots;
+    size_t               *blockOf;
+    size_t               blocksCapacity;
+    size_t               blocksUsed;
+    size_t               freeBlocks;
+    size_t               activeBlocks;
+    size_t               blockSize;
+    size_t               blockLimit;
+    size_t               blockOfCapacity;
+
+    /**
+     * Physical positions of the block elements in logical order
+     */
+    size_t *positionsOf(size_t id) const {
+        return this->slots + id * this->blockLimit;
+    }
+
+    /**
+     * Value of the element at the valid physical position, read from its cell without a copy
+     */
+    const ListElem &valueAt(size_t pos) const {
+        return this->list.storage[pos].value;
+    }
+
+    void recompute(size_t id) {
+        Value aggregate = Monoid::identity();
+        size_t *positions = this->positionsOf(id);
+        for (size_t i = 0; i < this->blocks[id].count; i++)
+            aggregate = Monoid::combine(aggregate, Monoid::of(this->valueAt(positions[i])));
+        this->blocks[id].aggregate = aggregate;
+    }
+
+    /**
+     * Makes blockOf hold physical positions up to pos
+     */
+    bool trackPos(size_t pos) {
+        if (pos < this->blockOfCapacity)
+            return true;
+        size_t newCapacity = (this->blockOfCapacity == 0) ? INITIAL_INCREASE : this->blockOfCapacity * 2;
+        if (newCapacity <= pos)
+            newCapacity = pos + 1;
+        auto *newBlockOf = (size_t *) realloc(this->blockOf, newCapacity * sizeof(size_t));
+        if (newBlockOf == nullptr)
+            return false;
+        this->blockOf = newBlockOf;
+        this->blockOfCapacity = newCapacity;
+        return true;
+    }
+
+    /**
+     * Links an empty block after the block after, returns its id or 0 if there is no memory
+     */
+    size_t newBlock(size_t after) {
+        size_t id = this->freeBlocks;
+        if (id != 0) {
+            this->freeBlocks = this->blocks[id].next;
+        } else {
+            if (this->blocksUsed == this->blocksCapacity) {
+                size_t newCapacity = this->blocksCapacity * 2;
+                auto *newBlocks = (Block *) realloc(this->blocks, newCapacity * sizeof(Block));
+                if (newBlocks == nullptr)
+                    return 0;
+                this->blocks = newBlocks;
+                auto *newSlots = (size_t *) realloc(this->slots, newCapacity * this->blockLimit * sizeof(size_t));
+                if (newSlots == nullptr)
+                    return 0;
+                this->slots = newSlots;
+                this->blocksCapacity = newCapacity;
+            }
+            id = this->blocksUsed++;
+        }
+        this->blocks[id].count = 0;
+        this->blocks[id].aggregate = Monoid::identity();
+        this->blocks[id].previous = after;
+        this->blocks[id].next = this->blocks[after].next;
+        this->blocks[this->blocks[after].next].previous = id;
+        this->blocks[after].next = id;
+        this->activeBlocks++;
+        return id;
+    }
+
+    void dropBlock(size_t id) {
+        this->blocks[this->blocks[id].previous].next = this->blocks[id].next;
+        this->blocks[this->blocks[id].next].previous = this->blocks[id].previous;
+        this->blocks[id].next = this->freeBlocks;
+        this->freeBlocks = id;
+        this->activeBlocks--;
+    }
+
+    size_t indexIn(size_t id, size_t pos) const {
+        size_t *positions = this->positionsOf(id);
+        size_t index = 0;
+        while (positions[index] != pos)
+            index++;
+        return index;
+    }
+
+    /**
+     * Block and index of the element at the logical position pos, pos must be less than size
+     */
+    void locate(size_t pos, size_t *id, size_t *index) const {
+        size_t block = this->blocks[0].next;
+        while (pos >= this->blocks[block].count) {
+            pos -= this->blocks[block].count;
+            block = this->blocks[block].next;
+        }
+        *id = block;
+        *index = pos;
+    }
+
+    /**
+     * Puts physical position pos at index of the block, full blocks are split in halves
+     */
+    ListOpResult place(size_t id, size_t index, size_t pos) {
+        if (!this->trackPos(pos))
+            return LIST_OP_NOMEM;
+        if (id == 0) {
+            id = this->newBlock(this->blocks[0].previous);
+            if (id == 0)
+                return LIST_OP_NOMEM;
+        }
+        if (this->blocks[id].count == this->blockLimit) {
+            size_t half = this->blockLimit / 2;
+            size_t upper = this->newBlock(id);
+            if (upper == 0)
+                return LIST_OP_NOMEM;
+            memcpy(this->positionsOf(upper), this->positionsOf(id) + half, half * sizeof(size_t));
+            for (size_t i = 0; i < half; i++)
+                this->blockOf[this->positionsOf(upper)[i]] = upper;
+            this->blocks[id].count = half;
+            this->blocks[upper].count = half;
+            if (index > half) {
+                index -= half;
+                this->recompute(id);
+                id = upper;
+            } else {
+                this->recompute(upper);
+            }
+        }
+        size_t *positions = this->positionsOf(id);
+        memmove(positions + index + 1, positions + index, (this->blocks[id].count - index) * sizeof(size_t));
+        positions[index] = pos;
+        this->blocks[id].count++;
+        this->blockOf[pos] = id;
+        this->recompute(id);
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Places the element just inserted into the list, takes it back if there is no memory
+     */
+    ListOpResult placeInserted(size_t id, size_t index, size_t pos, size_t *physPos) {
+        if (this->place(id, index, pos) != LIST_OP_OK) {
+            this->list.pop(pos);
+            return LIST_OP_NOMEM;
+        }
+        if (physPos != nullptr)
+            *physPos = pos;
+        return this->maintain();
+    }
+
+    /**
+     * Rebuilds blocks when their number or size is no longer about sqrt(n).
+     * Current blocks stay valid if there is no memory for that.
+     */
+    ListOpResult maintain() {
+        size_t size = this->list.getSize();
+        if (size > 4 * this->blockSize * this->blockSize ||
+            (this->blockSize > AGGREGATE_MIN_BLOCK && 4 * size < this->blockSize * this->blockSize) ||
+            this->activeBlocks > 4 * (size / this->blockSize) + 4)
+            this->rebuild();
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Regroups all elements into half-full blocks of sqrt(n)
+     */
+    ListOpResult rebuild() {
+        size_t size = this->list.getSize();
+        size_t newBlockSize = (size_t) std::sqrt((double) size);
+        if (newBlockSize < AGGREGATE_MIN_BLOCK)
+            newBlockSize = AGGREGATE_MIN_BLOCK;
+        size_t newCapacity = 2 * (size / newBlockSize + 2);
+        auto *newBlocks = (Block *) malloc(newCapacity * sizeof(Block));
+        auto *newSlots = (size_t *) malloc(newCapacity * 2 * newBlockSize * sizeof(size_t));
+        if (newBlocks == nullptr || newSlots == nullptr || !this->trackPos(this->list.getCapacity() + 1)) {
+            free(newBlocks);
+            free(newSlots);
+            return LIST_OP_NOMEM;
+        }
+        free(this->blocks);
+        free(this->slots);
+        this->blocks = newBlocks;
+        this->slots = newSlots;
+        this->blocksCapacity = newCapacity;
+        this->blocksUsed = 1;
+        this->freeBlocks = 0;
+        this->activeBlocks = 0;
+        this->blockSize = newBlockSize;
+        this->blockLimit = 2 * newBlockSize;
+        this->blocks[0] = {0, 0, 0, Monoid::identity()};
+
+        size_t id = 0;
+        size_t pos = this->list.begin();
+        for (size_t i = 0; i < size; i++) {
+            if (id == 0 || this->blocks[id].count == this->blockSize) {
+                if (id != 0)
+                    this->recompute(id);
+                id = this->newBlock(id);
+            }
+            this->positionsOf(id)[this->blocks[id].count++] = pos;
+            this->blockOf[pos] = id;
+            pos = this->list.nextIterator(pos);
+        }
+        if (id != 0)
+            this->recompute(id);
+        return LIST_OP_OK;
+    }
+
+public:
+    /**
+     * @param initialSize - initial capacity of the list
+     */
+    explicit SwiftyAggregateList(size_t initialSize = 0) : list(initialSize, 0, nullptr, false), blocks(nullptr),
+                                                           slots(nullptr), blockOf(nullptr), blocksCapacity(0),
+                                                           blocksUsed(0), freeBlocks(0), activeBlocks(0),
+                                                           blockSize(AGGREGATE_MIN_BLOCK),
+                                                           blockLimit(2 * AGGREGATE_MIN_BLOCK),
+                                                           blockOfCapacity(0) {
+        this->rebuild();
+    }
+
+    SwiftyAggregateList(const SwiftyAggregateList &) = delete;
+
+    SwiftyAggregateList &operator=(const SwiftyAggregateList &) = delete;
+
+    ~SwiftyAggregateList() {
+        free(this->blocks);
+        free(this->slots);
+        free(this->blockOf);
+    }
+
+    /**
+     * Aggregate of the values in the logical window [logicFrom, logicTo)
+     * @param logicFrom - logical pos of the first element
+     * @param logicTo - logical pos after the last element
+     * @param result - combined value, identity for an empty window
+     * @return operation result
+     */
+    ListOpResult aggregate(size_t logicFrom, size_t logicTo, Value *result) {
+        if (result == nullptr)
+            return LIST_OP_SEGFAULT;
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        if (logicFrom > logicTo || logicTo > this->list.getSize())
+            return LIST_OP_OVERFLOW;
+        Value total = Monoid::identity();
+        size_t id = this->blocks[0].next;
+        while (id != 0 && logicTo != 0) {
+            const Block &block = this->blocks[id];
+            if (logicFrom == 0 && logicTo >= block.count) {
+                total = Monoid::combine(total, block.aggregate);
+            } else if (logicFrom < block.count) {
+                size_t *positions = this->positionsOf(id);
+                size_t to = (logicTo < block.count) ? logicTo : block.count;
+                for (size_t i = logicFrom; i < to; i++)
+                    total = Monoid::combine(total, Monoid::of(this->valueAt(positions[i])));
+            }
+            logicFrom = (logicFrom > block.count) ? logicFrom - block.count : 0;
+            logicTo = (logicTo > block.count) ? logicTo - block.count : 0;
+            id = block.next;
+        }
+        *result = total;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - physical pos of considered element, 0 inserts at the first position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertAfter(size_t pos, ListElem value, size_t *physPos = nullptr) {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        size_t newPos = 0;
+        ListOpResult res = this->list.insertAfter(pos, value, &newPos);
+        if (res != LIST_OP_OK)
+            return res;
+        if (pos == 0)
+            return this->placeInserted(this->blocks[0].next, 0, newPos, physPos);
+        size_t id = this->blockOf[pos];
+        return this->placeInserted(id, this->indexIn(id, pos) + 1, newPos, physPos);
+    }
+
+    /**
+     * Insert an element before pos
+     * @param pos - physical pos of considered element, 0 inserts at the last position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertBefore(size_t pos, ListElem value, size_t *physPos = nullptr) {
+        if (pos == 0)
+            return this->pushBack(value, physPos);
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        size_t newPos = 0;
+        ListOpResult res = this->list.insertBefore(pos, value, &newPos);
+        if (res != LIST_OP_OK)
+            return res;
+        size_t id = this->blockOf[pos];
+        return this->placeInserted(id, this->indexIn(id, pos), newPos, physPos);
+    }
+
+    ListOpResult pushFront(const ListElem value, size_t *physPos = nullptr) {
+        return this->insertAfter(0, value, physPos);
+    }
+
+    ListOpResult pushBack(const ListElem value, size_t *physPos = nullptr) {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        size_t newPos = 0;
+        ListOpResult res = this->list.pushBack(value, &newPos);
+        if (res != LIST_OP_OK)
+            return res;
+        size_t id = this->blocks[0].previous;
+        return this->placeInserted(id, this->blocks[id].count, newPos, physPos);
+    }
+
+    /**
+     * Retrieve an element at the physical position pos and remove it
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult pop(size_t pos, ListElem *value = nullptr) {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        ListOpResult res = this->list.pop(pos, value);
+        if (res != LIST_OP_OK)
+            return res;
+        size_t id = this->blockOf[pos];
+        size_t index = this->indexIn(id, pos);
+        size_t *positions = this->positionsOf(id);
+        memmove(positions + index, positions + index + 1, (this->blocks[id].count - index - 1) * sizeof(size_t));
+        this->blocks[id].count--;
+        if (this->blocks[id].count == 0)
+            this->dropBlock(id);
+        else
+            this->recompute(id);
+        return this->maintain();
+    }
+
+    ListOpResult popFront(ListElem *value) {
+        return this->pop(this->list.begin(), value);
+    }
+
+    ListOpResult popBack(ListElem *value) {
+        return this->pop(this->list.end(), value);
+    }
+
+    ListOpResult remove(size_t pos) {
+        return this->pop(pos, nullptr);
+    }
+
+    /**
+     * Remove an element at the logical position pos in O(sqrt(n))
+     * @param pos - logical pos of considered element
+     * @return operation result
+     */
+    ListOpResult removeLogic(size_t pos) {
+        size_t physPos = 0;
+        ListOpResult res = this->logicToPhysic(pos, &physPos);
+        if (res != LIST_OP_OK)
+            return res;
+        return this->pop(physPos, nullptr);
+    }
+
+    /**
+     * Set an element at the physical position pos to the new value
+     * @param pos - physical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult set(size_t pos, const ListElem value) {
+        ListOpResult res = this->list.set(pos, value);
+        if (res != LIST_OP_OK)
+            return res;
+        this->recompute(this->blockOf[pos]);
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Set an element at the logical position pos in O(sqrt(n))
+     * @param pos - logical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult setLogic(size_t pos, const ListElem value) {
+        size_t physPos = 0;
+        ListOpResult res = this->logicToPhysic(pos, &physPos);
+        if (res != LIST_OP_OK)
+            return res;
+        return this->set(physPos, value);
+    }
+
+    /**
+     * Swap two elements at the physical positions
+     * @param firstPos - physical pos of the first element
+     * @param secondPos - physical pos of the second element
+     * @return operation result
+     */
+    ListOpResult swap(size_t firstPos, size_t secondPos) {
+        ListOpResult res = this->list.swap(firstPos, secondPos);
+        if (res != LIST_OP_OK || firstPos == secondPos)
+            return res;
+        this->recompute(this->blockOf[firstPos]);
+        if (this->blockOf[secondPos] != this->blockOf[firstPos])
+            this->recompute(this->blockOf[secondPos]);
+        return LIST_OP_OK;
+    }
+
+    ListOpResult get(size_t pos, ListElem *value) {
+        return this->list.get(pos, value);
+    }
+
+    /**
+     * Get an element at the logical position pos in O(sqrt(n))
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem *value) {
+        size_t physPos = 0;
+        ListOpResult res = this->logicToPhysic(pos, &physPos);
+        if (res != LIST_OP_OK)
+            return res;
+        return this->list.get(physPos, value);
+    }
+
+    /**
+     * Physical position of the element at the logical position pos in O(sqrt(n))
+     * @param pos - logical pos of considered element
+     * @param physPos - physical pos of the element
+     * @return operation result
+     */
+    ListOpResult logicToPhysic(size_t pos, size_t *physPos) const {
+        if (physPos == nullptr)
+            return LIST_OP_SEGFAULT;
+        if (pos >= this->list.getSize())
+            return LIST_OP_OVERFLOW;
+        size_t id = 0, index = 0;
+        this->locate(pos, &id, &index);
+        *physPos = this->positionsOf(id)[index];
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Optimizes the list, blocks are rebuilt for the new physical positions
+     * @return operation result
+     */
+    ListOpResult optimize() {
+        ListOpResult res = this->list.optimize();
+        if (res != LIST_OP_OK)
+            return res;
+        return this->rebuild();
+    }
+
+    ListOpResult clear() {
+        ListOpResult res = this->list.clear();
+        if (res != LIST_OP_OK)
+            return res;
+        return this->rebuild();
+    }
+
+    size_t getSize() const {
+        return this->list.getSize();
+    }
+
+    bool isEmpty() const {
+        return this->list.isEmpty();
+    }
+
+    size_t begin() const {
+        return this->list.begin();
+    }
+
+    size_t end() const {
+        return this->list.end();
+    }
+
+    /**
+     * Underlying list for reading, it must not be changed directly
+     */
+    const SwiftyList<ListElem> &getList() const {
+        return this->list;
+    }
+};
+
+#endif /* SwiftyAggregateList_hpp */
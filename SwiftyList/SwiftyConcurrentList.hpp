@@ -0,0 +1,598 @@
+/**
+ * SwiftyConcurrentList - SwiftyList with lock-free readers
+ *
+ * Readers run optimistically under a sequence lock: they retry if a writer
+ * changed the list while they were reading. Writers are serialized by a spin lock.
+ * Storage that readers may still hold is released only after all readers that
+ * could have seen it left (two-phase epoch scheme).
+ *
+ * In de-optimized mode logical walks are not safe against concurrent relinking,
+ * so logical reads take the writer lock there.
+ */
+
+#ifndef SwiftyConcurrentList_hpp
+#define SwiftyConcurrentList_hpp
+
+#include <atomic>
+#include <thread>
+#include "SwiftyList.hpp"
+
+const size_t CONCURRENT_READER_STRIPES = 16;
+const size_t CONCURRENT_OPTIMISTIC_ATTEMPTS = 16;
+const size_t CONCURRENT_ITERATION_CHUNK = 256;
+
+template<typename ListElem>
+struct SwiftyConcurrentList {
+private:
+    typedef typename SwiftyList<ListElem>::SwiftyListNode Node;
+
+    static_assert(std::is_trivially_copyable<ListElem>::value,
+                  "optimistic reads require trivially copyable ListElem");
+
+    struct alignas(64) ReaderStripe {
+        std::atomic<size_t> count;
+    };
+
+    /**
+     * List state as seen by a reader
+     */
+    struct View {
+        const Node *storage;
+        size_t     size;
+        size_t     sumSize;
+        bool       optimized;
+    };
+
+    SwiftyList<ListElem> list;
+
+    mutable std::atomic<bool> writerLock;
+    alignas(64) std::atomic<uint64_t> sequence;
+    std::atomic<const Node *> publishedStorage;
+    std::atomic<size_t>       publishedSize;
+    std::atomic<size_t>       publishedSumSize;
+    std::atomic<bool>         publishedOptimized;
+
+    alignas(64) std::atomic<size_t> epoch;
+    mutable ReaderStripe readers[2][CONCURRENT_READER_STRIPES];
+
+    void lock() const {
+        while (this->writerLock.exchange(true, std::memory_order_acquire)) {
+            while (this->writerLock.load(std::memory_order_relaxed))
+                std::this_thread::yield();
+        }
+    }
+
+    void unlock() const {
+        this->writerLock.store(false, std::memory_order_release);
+    }
+
+    void writeBegin() {
+        this->sequence.store(this->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void writeEnd() {
+        this->publishedStorage.store(this->list.storage, std::memory_order_relaxed);
+        this->publishedSize.store(this->list.size, std::memory_order_relaxed);
+        this->publishedSumSize.store(this->list.sumSize(), std::memory_order_relaxed);
+        this->publishedOptimized.store(this->list.optimized, std::memory_order_relaxed);
+        this->sequence.store(this->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    static size_t readerStripe() {
+        static std::atomic<size_t> nextStripe(0);
+        static thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed)
+                                            % CONCURRENT_READER_STRIPES;
+        return stripe;
+    }
+
+    size_t enterEpoch(size_t stripe) const {
+        while (true) {
+            size_t current = this->epoch.load(std::memory_order_seq_cst);
+            this->readers[current & 1][stripe].count.fetch_add(1, std::memory_order_seq_cst);
+            if (this->epoch.load(std::memory_order_seq_cst) == current)
+                return current;
+            this->readers[current & 1][stripe].count.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void leaveEpoch(size_t current, size_t stripe) const {
+        this->readers[current & 1][stripe].count.fetch_sub(1, std::memory_order_release);
+    }
+
+    /**
+     * Waits until every reader that could have seen the previously published storage left.
+     * Called by the writer only.
+     */
+    void synchronize() {
+        size_t current = this->epoch.load(std::memory_order_relaxed);
+        this->epoch.store(current + 1, std::memory_order_seq_cst);
+        for (size_t i = 0; i < CONCURRENT_READER_STRIPES; i++) {
+            while (this->readers[current & 1][i].count.load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Replaces storage readers see and releases the old one once no reader holds it
+     */
+    void replaceStorage(Node *newStorage, size_t newCapacity) {
+        Node *oldStorage = this->list.storage;
+        this->writeBegin();
+        this->list.storage = newStorage;
+        this->list.capacity = newCapacity;
+        this->writeEnd();
+        this->synchronize();
+        this->list.freeStorage(oldStorage);
+    }
+
+    /**
+     * Grows storage so that inner list never reallocates it in place
+     */
+    ListOpResult reserveOne() {
+        if (this->list.freeSize != 0 || this->list.size < this->list.capacity)
+            return LIST_OP_OK;
+        size_t newCapacity = (this->list.capacity == 0) ? INITIAL_INCREASE : this->list.capacity * 2;
+        Node *newStorage = (Node *) malloc((newCapacity + 2) * sizeof(Node));
+        if (newStorage == nullptr)
+            return LIST_OP_NOMEM;
+        memcpy(newStorage, this->list.storage, (this->list.sumSize() + 1) * sizeof(Node));
+        this->replaceStorage(newStorage, newCapacity);
+        return LIST_OP_OK;
+    }
+
+    template<typename Op>
+    ListOpResult write(Op op) {
+        this->lock();
+        ListOpResult res = this->reserveOne();
+        if (res == LIST_OP_OK) {
+            this->writeBegin();
+            res = op(this->list);
+            this->writeEnd();
+        }
+        this->unlock();
+        return res;
+    }
+
+    /**
+     * Runs reader optimistically, falls back to the writer lock if the reader
+     * can not proceed without it or writers keep interfering.
+     * Published fields are validated before use, so storage and sizes always match.
+     * Reader returns false when it needs the lock.
+     */
+    template<typename Reader>
+    ListOpResult read(Reader reader) const {
+        size_t stripe = readerStripe();
+        size_t current = this->enterEpoch(stripe);
+        ListOpResult res = LIST_OP_OK;
+        for (size_t attempt = 0; attempt < CONCURRENT_OPTIMISTIC_ATTEMPTS; attempt++) {
+            uint64_t before = this->sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            View view = {this->publishedStorage.load(std::memory_order_relaxed),
+                         this->publishedSize.load(std::memory_order_relaxed),
+                         this->publishedSumSize.load(std::memory_order_relaxed),
+                         this->publishedOptimized.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (this->sequence.load(std::memory_order_relaxed) != before)
+                continue;
+            bool done = reader(view, false, &res);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (this->sequence.load(std::memory_order_relaxed) == before) {
+                if (done) {
+                    this->leaveEpoch(current, stripe);
+                    return res;
+                }
+                break;
+            }
+        }
+        this->leaveEpoch(current, stripe);
+
+        this->lock();
+        View view = {this->list.storage, this->list.size, this->list.sumSize(), this->list.optimized};
+        reader(view, true, &res);
+        this->unlock();
+        return res;
+    }
+
+public:
+    SwiftyConcurrentList(size_t initialSize, short int verbose, FILE *logFile, bool useChecks) :
+            list(initialSize, verbose, logFile, useChecks),
+            writerLock(false),
+            sequence(0),
+            publishedStorage(nullptr),
+            publishedSize(0),
+            publishedSumSize(0),
+            publishedOptimized(true),
+            epoch(0) {
+        for (auto &parity : this->readers)
+            for (auto &stripe : parity)
+                stripe.count.store(0, std::memory_order_relaxed);
+        this->writeBegin();
+        this->writeEnd();
+    }
+
+    SwiftyConcurrentList(const SwiftyConcurrentList &) = delete;
+
+    SwiftyConcurrentList &operator=(const SwiftyConcurrentList &) = delete;
+
+    ~SwiftyConcurrentList() {
+        this->list.DestructList();
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - physical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertAfter(size_t pos, ListElem value, size_t *physPos = nullptr) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.insertAfter(pos, value, physPos); });
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertAfterLogic(size_t pos, ListElem value, size_t *physPos = nullptr) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.insertAfterLogic(pos, value, physPos); });
+    }
+
+    /**
+     * Insert an element before pos
+     * @param pos - physical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertBefore(size_t pos, ListElem value, size_t *physPos = nullptr) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.insertBefore(pos, value, physPos); });
+    }
+
+    /**
+     * Insert an element before pos
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertBeforeLogic(size_t pos, ListElem value, size_t *physPos = nullptr) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.insertBeforeLogic(pos, value, physPos); });
+    }
+
+    /**
+     * Insert an element at the first position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult pushFront(const ListElem value, size_t *physPos = nullptr) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.pushFront(value, physPos); });
+    }
+
+    /**
+     * Insert an element at the last position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult pushBack(const ListElem value, size_t *physPos = nullptr) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.pushBack(value, physPos); });
+    }
+
+    /**
+     * Set an element at the physical position pos to the new value
+     * @param pos - physical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult set(size_t pos, const ListElem value) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.set(pos, value); });
+    }
+
+    /**
+     * Set an element at the logical position pos to the new value
+     * @param pos - logical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult setLogic(size_t pos, const ListElem value) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.setLogic(pos, value); });
+    }
+
+    /**
+     * Retrieve an element at the physical position pos and remove it
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult pop(size_t pos, ListElem *value = nullptr) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.pop(pos, value); });
+    }
+
+    /**
+     * Retrieve an element at the beginning and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popFront(ListElem *value) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.popFront(value); });
+    }
+
+    /**
+     * Retrieve an element at the end and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popBack(ListElem *value) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.popBack(value); });
+    }
+
+    /**
+     * Retrieve an element at the logical position pos and remove it
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popLogic(size_t pos, ListElem *value) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.popLogic(pos, value); });
+    }
+
+    /**
+     * Remove an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @return operation result
+     */
+    ListOpResult remove(size_t pos) {
+        return this->pop(pos, nullptr);
+    }
+
+    /**
+     * Remove an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @return operation result
+     */
+    ListOpResult removeLogic(size_t pos) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.removeLogic(pos); });
+    }
+
+    /**
+     * Swap two elements at the physical positions
+     * @param firstPos - physical pos of the first element
+     * @param secondPos - physical pos of the second element
+     * @return operation result
+     */
+    ListOpResult swap(size_t firstPos, size_t secondPos) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.swap(firstPos, secondPos); });
+    }
+
+    /**
+     * Swap two elements at the logical positions
+     * @param firstPos - logical pos of the first element
+     * @param secondPos - logical pos of the second element
+     * @return operation result
+     */
+    ListOpResult swapLogic(size_t firstPos, size_t secondPos) {
+        return this->write([&](SwiftyList<ListElem> &inner) { return inner.swapLogic(firstPos, secondPos); });
+    }
+
+    /**
+     * Clears the list
+     * @return operation result
+     */
+    ListOpResult clear() {
+        return this->write([](SwiftyList<ListElem> &inner) { return inner.clear(); });
+    }
+
+    /**
+     * Deoptimizes list
+     * @return operation result
+     */
+    ListOpResult deOptimize() {
+        return this->write([](SwiftyList<ListElem> &inner) { return inner.deOptimize(); });
+    }
+
+    /**
+     * Optimizes the list. Readers keep using the old storage until they leave.
+     * @return operation result
+     */
+    ListOpResult optimize() {
+        this->lock();
+        size_t newCapacity = 0;
+        Node *newStorage = this->list.optimizedStorage(&newCapacity);
+        if (newStorage == nullptr) {
+            this->unlock();
+            return LIST_OP_NOMEM;
+        }
+        Node *oldStorage = this->list.storage;
+        this->writeBegin();
+        this->list.adoptOptimized(newStorage, newCapacity);
+        this->writeEnd();
+        this->synchronize();
+        this->list.freeStorage(oldStorage);
+        this->unlock();
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get an element at the physical position pos. Lock-free in both modes.
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult get(size_t pos, ListElem *value) const {
+        if (value == nullptr)
+            return LIST_OP_SEGFAULT;
+        return this->read([&](const View &view, bool, ListOpResult *res) {
+            if (pos == 0 || pos > view.sumSize || !view.storage[pos].valid) {
+                *res = LIST_OP_SEGFAULT;
+                return true;
+            }
+            memcpy((void *) value, &view.storage[pos].value, sizeof(ListElem));
+            *res = LIST_OP_OK;
+            return true;
+        });
+    }
+
+    /**
+     * Get an element at the logical position pos. Lock-free in optimized mode.
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem *value) const {
+        if (value == nullptr)
+            return LIST_OP_SEGFAULT;
+        return this->read([&](const View &view, bool locked, ListOpResult *res) {
+            if (pos >= view.size) {
+                *res = LIST_OP_OVERFLOW;
+                return true;
+            }
+            size_t physPos = pos + 1;
+            if (!view.optimized) {
+                if (!locked)
+                    return false;
+                physPos = view.storage[0].next;
+                for (size_t i = 0; i < pos; i++)
+                    physPos = view.storage[physPos].next;
+            }
+            memcpy((void *) value, &view.storage[physPos].value, sizeof(ListElem));
+            *res = LIST_OP_OK;
+            return true;
+        });
+    }
+
+    /**
+     * Search an element in the list. Lock-free in optimized mode.
+     * @param pos - logical pos of the first matching element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult searchLogic(size_t *pos, const ListElem value) const {
+        return this->read([&](const View &view, bool locked, ListOpResult *res) {
+            if (!view.optimized && !locked)
+                return false;
+            *res = LIST_OP_NOTFOUND;
+            // links of an optimized view are not read: a writer may be linking in a cell not written yet
+            size_t physPos = view.optimized ? 1 : view.storage[0].next;
+            for (size_t i = 0; i < view.size; i++) {
+                if (view.storage[physPos].value == value) {
+                    *pos = i;
+                    *res = LIST_OP_OK;
+                    break;
+                }
+                physPos = view.optimized ? i + 2 : view.storage[physPos].next;
+            }
+            return true;
+        });
+    }
+
+    /**
+     * Search an element in the list. Lock-free in optimized mode.
+     * @param pos - physical pos of the first matching element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult search(size_t *pos, const ListElem value) const {
+        return this->read([&](const View &view, bool locked, ListOpResult *res) {
+            if (!view.optimized && !locked)
+                return false;
+            *res = LIST_OP_NOTFOUND;
+            // links of an optimized view are not read: a writer may be linking in a cell not written yet
+            size_t physPos = view.optimized ? 1 : view.storage[0].next;
+            for (size_t i = 0; i < view.size; i++) {
+                if (view.storage[physPos].value == value) {
+                    *pos = physPos;
+                    *res = LIST_OP_OK;
+                    break;
+                }
+                physPos = view.optimized ? i + 2 : view.storage[physPos].next;
+            }
+            return true;
+        });
+    }
+
+    /**
+     * Calls func(value) for elements in logical order.
+     * Values are copied out by chunks and func runs outside of any lock, so it may call writers.
+     * Every chunk is consistent on its own. In optimized mode chunks are copied lock-free,
+     * in de-optimized mode under the writer lock; the walk resumes from the last copied cell
+     * while no writer ran in between and restarts from the beginning otherwise.
+     * @return operation result
+     */
+    template<typename Func>
+    ListOpResult forEach(Func func) const {
+        ListElem chunk[CONCURRENT_ITERATION_CHUNK];
+        size_t done = 0;
+        size_t cursor = 0;
+        // sequence is even outside of writes, so an odd one means there is no cursor
+        uint64_t cursorSequence = 1;
+        while (true) {
+            size_t copied = 0;
+            bool finished = false;
+            this->read([&](const View &view, bool locked, ListOpResult *res) {
+                *res = LIST_OP_OK;
+                copied = (view.size > done) ? view.size - done : 0;
+                if (copied > CONCURRENT_ITERATION_CHUNK)
+                    copied = CONCURRENT_ITERATION_CHUNK;
+                finished = copied == 0;
+                if (!view.optimized) {
+                    if (!locked)
+                        return false;
+                    size_t iterator = cursor;
+                    if (this->sequence.load(std::memory_order_relaxed) != cursorSequence) {
+                        iterator = view.storage[0].next;
+                        for (size_t i = 0; i < done && i < view.size; i++)
+                            iterator = view.storage[iterator].next;
+                    }
+                    for (size_t i = 0; i < copied; i++) {
+                        memcpy((void *) (chunk + i), &view.storage[iterator].value, sizeof(ListElem));
+                        iterator = view.storage[iterator].next;
+                    }
+                    cursor = iterator;
+                    cursorSequence = this->sequence.load(std::memory_order_relaxed);
+                    return true;
+                }
+                for (size_t i = 0; i < copied; i++)
+                    memcpy((void *) (chunk + i), &view.storage[done + i + 1].value, sizeof(ListElem));
+                return true;
+            });
+            if (finished)
+                return LIST_OP_OK;
+            for (size_t i = 0; i < copied; i++)
+                func(chunk[i]);
+            done += copied;
+        }
+    }
+
+    /**
+     * Check up list's integrity
+     * @return operation result
+     */
+    ListOpResult checkUp() const {
+        this->lock();
+        ListOpResult res = this->list.checkUp();
+        this->unlock();
+        return res;
+    }
+
+    size_t getSize() const {
+        return this->publishedSize.load(std::memory_order_acquire);
+    }
+
+    bool isOptimized() const {
+        return this->publishedOptimized.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const {
+        return this->getSize() == 0;
+    }
+};
+
+#endif /* SwiftyConcurrentList_hpp */
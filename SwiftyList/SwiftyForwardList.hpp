@@ -0,0 +1,477 @@
+/**
+ * SwiftyForwardList - forward-only SwiftyList
+ *
+ * Nodes have no previous link, the tail is tracked separately so pushBack is O(1).
+ * Cell is free when the top bit of its next link is set, so a node is just
+ * the value and one link. Removal is done after a known element (popAfter)
+ * or at the front; operations that need to go backwards (prevIterator,
+ * insertBefore, popBack) do not exist in this variant.
+ *
+ * Optimized mode is the same as in SwiftyList: logical position pos is stored
+ * at the physical position pos + 1 until the list is changed anywhere except its end.
+ */
+
+#ifndef SwiftyForwardList_hpp
+#define SwiftyForwardList_hpp
+
+#include <cstdlib>
+#include "SwiftyList.hpp"
+
+const size_t FORWARD_FREE_BIT = ~(SIZE_MAX >> 1);
+
+template<typename ListElem>
+struct SwiftyForwardList {
+private:
+    struct SwiftyForwardNode {
+        ListElem value;
+        size_t   next;
+    };
+
+    SwiftyForwardNode *storage;
+    size_t            capacity;
+    size_t            size;
+    size_t            tail;
+    size_t            freePtr;
+    size_t            freeSize;
+    bool              optimized;
+    bool              useChecks;
+
+    /**
+     * Takes a free cell or the first unused one, reallocating storage if needed
+     * @return new cell or 0 if there is no memory
+     */
+    size_t getFreePos() {
+        if (this->freeSize != 0) {
+            size_t pos = this->freePtr;
+            this->freePtr = this->storage[pos].next & ~FORWARD_FREE_BIT;
+            this->freeSize--;
+            return pos;
+        }
+        if (this->size >= this->capacity) {
+            size_t newCapacity = (this->capacity == 0) ? INITIAL_INCREASE : this->capacity * 2;
+            SwiftyForwardNode *newStorage = (SwiftyForwardNode *) realloc(this->storage,
+                                                                          (newCapacity + 1) * sizeof(SwiftyForwardNode));
+            if (newStorage == nullptr)
+                return 0;
+            this->storage = newStorage;
+            this->capacity = newCapacity;
+        }
+        return this->size + 1;
+    }
+
+    void addFreePos(size_t pos) {
+        this->storage[pos].next = this->freePtr | FORWARD_FREE_BIT;
+        this->freePtr = pos;
+        this->freeSize++;
+    }
+
+    ListOpResult checked() const {
+        if (this->useChecks)
+            return this->checkUp();
+        return LIST_OP_OK;
+    }
+
+public:
+    /**
+     * @param initialSize - number of elements to reserve space for
+     * @param useChecks - check integrity after every modification
+     */
+    SwiftyForwardList(size_t initialSize, bool useChecks) : storage(nullptr), capacity(0), size(0), tail(0),
+                                                           freePtr(0), freeSize(0), optimized(true),
+                                                           useChecks(useChecks) {
+        this->storage = (SwiftyForwardNode *) calloc(initialSize + 1, sizeof(SwiftyForwardNode));
+        if (this->storage != nullptr)
+            this->capacity = initialSize;
+    }
+
+    SwiftyForwardList(const SwiftyForwardList &) = delete;
+
+    SwiftyForwardList &operator=(const SwiftyForwardList &) = delete;
+
+    ~SwiftyForwardList() {
+        free(this->storage);
+    }
+
+    /**
+     * Convert logic position to the physic one
+     */
+    size_t logicToPhysic(size_t pos) const {
+        if (this->optimized)
+            return pos + 1;
+        if (pos + 1 == this->size)
+            return this->tail;
+        size_t iterator = 0;
+        for (size_t i = 0; i <= pos; i++)
+            iterator = this->storage[iterator].next;
+        return iterator;
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - physical pos of considered element, 0 to insert at the beginning
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertAfter(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (this->storage == nullptr)
+            return LIST_OP_NOMEM;
+        if (pos != 0 && !this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        size_t newPos = this->getFreePos();
+        if (newPos == 0)
+            return LIST_OP_NOMEM;
+        if (pos != this->tail || newPos != this->tail + 1)
+            this->optimized = false;
+
+        this->storage[newPos].value = value;
+        this->storage[newPos].next = this->storage[pos].next;
+        this->storage[pos].next = newPos;
+        if (pos == this->tail)
+            this->tail = newPos;
+        this->size++;
+
+        if (physPos != nullptr)
+            *physPos = newPos;
+        return this->checked();
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertAfterLogic(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->insertAfter(this->logicToPhysic(pos), value, physPos);
+    }
+
+    /**
+     * Insert an element at the first position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult pushFront(const ListElem value, size_t* physPos=nullptr) {
+        return this->insertAfter(0, value, physPos);
+    }
+
+    /**
+     * Insert an element at the last position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult pushBack(const ListElem value, size_t* physPos=nullptr) {
+        return this->insertAfter(this->tail, value, physPos);
+    }
+
+    /**
+     * Set an element at the physical position pos to the new value
+     * @param pos - physical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult set(size_t pos, const ListElem value) {
+        if (!this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        this->storage[pos].value = value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Set an element at the logical position pos to the new value
+     * @param pos - logical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult setLogic(size_t pos, const ListElem value) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->set(this->logicToPhysic(pos), value);
+    }
+
+    /**
+     * Get an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult get(size_t pos, ListElem* value) const {
+        if (!this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        if (value != nullptr)
+            *value = this->storage[pos].value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem* value=nullptr) const {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->get(this->logicToPhysic(pos), value);
+    }
+
+    /**
+     * Retrieve the element following pos and remove it
+     * @param pos - physical pos of the element before the removed one, 0 to remove the first element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popAfter(size_t pos, ListElem *value=nullptr) {
+        if (this->size == 0)
+            return LIST_OP_UNDERFLOW;
+        if (pos != 0 && !this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        size_t removed = this->storage[pos].next;
+        if (removed == 0)
+            return LIST_OP_OVERFLOW;
+        if (removed != this->tail)
+            this->optimized = false;
+
+        if (value != nullptr)
+            *value = this->storage[removed].value;
+        this->storage[pos].next = this->storage[removed].next;
+        if (removed == this->tail)
+            this->tail = pos;
+        this->addFreePos(removed);
+        this->size--;
+        return this->checked();
+    }
+
+    /**
+     * Retrieve an element at the beginning and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popFront(ListElem *value) {
+        return this->popAfter(0, value);
+    }
+
+    /**
+     * Retrieve an element at the logical position pos and remove it.
+     * Walks to the element before pos in de-optimized mode.
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popLogic(size_t pos, ListElem *value) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->popAfter((pos == 0) ? 0 : this->logicToPhysic(pos - 1), value);
+    }
+
+    /**
+     * Remove the element following pos
+     * @param pos - physical pos of the element before the removed one, 0 to remove the first element
+     * @return operation result
+     */
+    ListOpResult removeAfter(size_t pos) {
+        return this->popAfter(pos, nullptr);
+    }
+
+    /**
+     * Remove an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @return operation result
+     */
+    ListOpResult removeLogic(size_t pos) {
+        return this->popLogic(pos, nullptr);
+    }
+
+    /**
+     * Swap two elements at the physical positions
+     * @param firstPos - physical pos of the first element
+     * @param secondPos - physical pos of the second element
+     * @return operation result
+     */
+    ListOpResult swap(size_t firstPos, size_t secondPos) {
+        if (!this->addressValid(firstPos) || !this->addressValid(secondPos))
+            return LIST_OP_SEGFAULT;
+        ListElem tmp = this->storage[firstPos].value;
+        this->storage[firstPos].value = this->storage[secondPos].value;
+        this->storage[secondPos].value = tmp;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Swap two elements at the logical positions
+     * @param firstPos - logical pos of the first element
+     * @param secondPos - logical pos of the second element
+     * @return operation result
+     */
+    ListOpResult swapLogic(size_t firstPos, size_t secondPos) {
+        if (firstPos >= this->size || secondPos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->swap(this->logicToPhysic(firstPos), this->logicToPhysic(secondPos));
+    }
+
+    /**
+     * Search an element in the list. Retrieves the logical position
+     * @param pos - logical pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult searchLogic(size_t *pos, const ListElem value) const {
+        size_t iterator = this->storage[0].next;
+        for (size_t i = 0; i < this->size; i++) {
+            if (this->storage[iterator].value == value) {
+                *pos = i;
+                return LIST_OP_OK;
+            }
+            iterator = this->storage[iterator].next;
+        }
+        return LIST_OP_NOTFOUND;
+    }
+
+    /**
+     * Search an element in the list. Retrieves the physic position
+     * @param pos - physic pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult search(size_t *pos, const ListElem value) const {
+        for (size_t iterator = this->storage[0].next; iterator != 0; iterator = this->storage[iterator].next) {
+            if (this->storage[iterator].value == value) {
+                *pos = iterator;
+                return LIST_OP_OK;
+            }
+        }
+        return LIST_OP_NOTFOUND;
+    }
+
+    /**
+     * Clears the list, storage is kept
+     * @return operation result
+     */
+    ListOpResult clear() {
+        if (this->storage == nullptr)
+            return LIST_OP_NOMEM;
+        this->storage[0].next = 0;
+        this->size = 0;
+        this->tail = 0;
+        this->freePtr = 0;
+        this->freeSize = 0;
+        this->optimized = true;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Optimizes the list so that logical access is effective and
+     * physical positions are aligned in ascending order in the storage
+     * @return operation result
+     */
+    ListOpResult optimize() {
+        if (this->storage == nullptr)
+            return LIST_OP_NOMEM;
+        SwiftyForwardNode *newStorage = (SwiftyForwardNode *) calloc(this->capacity + 1,
+                                                                     sizeof(SwiftyForwardNode));
+        if (newStorage == nullptr)
+            return LIST_OP_NOMEM;
+        size_t iterator = this->storage[0].next;
+        for (size_t i = 1; i <= this->size; i++) {
+            newStorage[i].value = this->storage[iterator].value;
+            newStorage[i].next = (i == this->size) ? 0 : i + 1;
+            iterator = this->storage[iterator].next;
+        }
+        newStorage[0].next = (this->size == 0) ? 0 : 1;
+        free(this->storage);
+        this->storage = newStorage;
+        this->tail = this->size;
+        this->freePtr = 0;
+        this->freeSize = 0;
+        this->optimized = true;
+        return this->checked();
+    }
+
+    /**
+     * Moves iterator to the next physical position
+     * @param pos
+     * @return next position or 0 after the last element
+     */
+    size_t nextIterator(size_t pos) const {
+        if (!this->addressValid(pos))
+            return 0;
+        return this->storage[pos].next;
+    }
+
+    /**
+     * Moves iterator to the next physical position
+     * @param pos
+     * @return operation result
+     */
+    ListOpResult nextIterator(size_t* pos) const {
+        if (!this->addressValid(*pos))
+            return LIST_OP_SEGFAULT;
+        *pos = this->storage[*pos].next;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Check up list's integrity
+     * @return operation result
+     */
+    ListOpResult checkUp() const {
+        if (this->storage == nullptr)
+            return LIST_OP_NOMEM;
+        if (this->sumSize() > this->capacity)
+            return LIST_OP_CORRUPTED;
+        size_t iterator = 0;
+        for (size_t i = 0; i < this->size; i++) {
+            iterator = this->storage[iterator].next;
+            if (!this->addressValid(iterator) || (this->optimized && iterator != i + 1))
+                return LIST_OP_CORRUPTED;
+        }
+        if (iterator != this->tail || this->storage[iterator].next != 0)
+            return LIST_OP_CORRUPTED;
+        size_t freePos = this->freePtr;
+        for (size_t i = 0; i < this->freeSize; i++) {
+            if (freePos == 0 || freePos > this->sumSize() || this->addressValid(freePos))
+                return LIST_OP_CORRUPTED;
+            freePos = this->storage[freePos].next & ~FORWARD_FREE_BIT;
+        }
+        return LIST_OP_OK;
+    }
+
+    size_t begin() const {
+        return this->storage[0].next;
+    }
+
+    size_t end() const {
+        return this->tail;
+    }
+
+    size_t getSize() const {
+        return this->size;
+    }
+
+    size_t getCapacity() const {
+        return this->capacity;
+    }
+
+    bool isOptimized() const {
+        return this->optimized;
+    }
+
+    bool isEmpty() const {
+        return this->size == 0;
+    }
+
+    size_t sumSize() const {
+        return this->size + this->freeSize;
+    }
+
+    bool addressValid(size_t pos) const {
+        return pos != 0 && pos <= this->sumSize() && (this->storage[pos].next & FORWARD_FREE_BIT) == 0;
+    }
+};
+
+#endif /* SwiftyForwardList_hpp */
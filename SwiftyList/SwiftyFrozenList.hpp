@@ -0,0 +1,346 @@
+/**
+ * FrozenSwiftyList - immutable compact copy of SwiftyList made by SwiftyList::freeze()
+ *
+ * Only values are kept, in logical order, so a logical position is a plain index and
+ * no next/previous/valid fields are stored. Integer values can be packed: they are
+ * split into blocks of FROZEN_BLOCK_ELEMS, every block keeps its minimum and maximum
+ * and stores differences to the minimum in as few bits as the block needs. A value is
+ * decoded from its block alone, so random access stays O(1), and search skips blocks
+ * whose range does not hold the value.
+ *
+ * thaw() turns it back into an optimized mutable list.
+ */
+
+#ifndef SwiftyFrozenList_hpp
+#define SwiftyFrozenList_hpp
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "SwiftyList.hpp"
+
+const size_t FROZEN_BLOCK_ELEMS  = 128;
+const size_t FROZEN_SEARCH_LANES = 16;
+
+template<typename ListElem>
+struct FrozenSwiftyList {
+private:
+    friend struct SwiftyList<ListElem>;
+
+    static constexpr bool packable = std::is_integral<ListElem>::value && !std::is_same<ListElem, bool>::value;
+
+    struct Block {
+        ListElem min;
+        ListElem max;
+        size_t   word;
+        size_t   width;
+    };
+
+    ListElem *values;
+    Block    *blocks;
+    uint64_t *bits;
+    size_t   size;
+    size_t   bitsWords;
+
+    static uint64_t lowBits(size_t width) {
+        return (width >= 64) ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+    }
+
+    static size_t blocksFor(size_t count) {
+        return (count + FROZEN_BLOCK_ELEMS - 1) / FROZEN_BLOCK_ELEMS;
+    }
+
+    /**
+     * Position of the first value in data, count if there is none.
+     * Lanes are compared without early exit so that the comparison is vectorized.
+     */
+    static size_t findIn(const ListElem *data, size_t count, const ListElem &value) {
+        size_t i = 0;
+        for (; i + FROZEN_SEARCH_LANES <= count; i += FROZEN_SEARCH_LANES) {
+            bool found = false;
+            for (size_t j = 0; j < FROZEN_SEARCH_LANES; j++)
+                found |= (data[i + j] == value);
+            if (found)
+                break;
+        }
+        for (; i < count; i++) {
+            if (data[i] == value)
+                return i;
+        }
+        return count;
+    }
+
+    /**
+     * Difference to the block minimum stored at the bit offset of the block.
+     * Both words are read without branches, bits has two spare words at the end for that.
+     */
+    uint64_t delta(const Block &block, size_t bit) const {
+        const uint64_t *word = this->bits + block.word + bit / 64;
+        size_t shift = bit % 64;
+        uint64_t value = (word[0] >> shift) | ((word[1] << 1) << (63 - shift));
+        return value & lowBits(block.width);
+    }
+
+    /**
+     * Decodes a single packed value
+     */
+    ListElem unpack(size_t pos) const {
+        const Block &block = this->blocks[pos / FROZEN_BLOCK_ELEMS];
+        return (ListElem) ((uint64_t) block.min + this->delta(block, (pos % FROZEN_BLOCK_ELEMS) * block.width));
+    }
+
+    /**
+     * Decodes all values of the block into out, returns their number
+     */
+    size_t unpackBlock(size_t blockNo, ListElem *out) const {
+        size_t from = blockNo * FROZEN_BLOCK_ELEMS;
+        size_t count = this->size - from;
+        if (count > FROZEN_BLOCK_ELEMS)
+            count = FROZEN_BLOCK_ELEMS;
+        const Block &block = this->blocks[blockNo];
+        for (size_t i = 0; i < count; i++)
+            out[i] = (ListElem) ((uint64_t) block.min + this->delta(block, i * block.width));
+        return count;
+    }
+
+    ListElem valueAt(size_t pos) const {
+        if constexpr (packable) {
+            if (this->blocks != nullptr)
+                return this->unpack(pos);
+        }
+        return this->values[pos];
+    }
+
+    /**
+     * Packs count integer values into blocks: minimum and maximum are found first,
+     * then differences to the minimum are written with the width of the largest one
+     */
+    ListOpResult pack(const ListElem *source, size_t count) {
+        size_t blocksCount = blocksFor(count);
+        auto *newBlocks = (Block *) malloc(blocksCount * sizeof(Block) + 1);
+        if (newBlocks == nullptr)
+            return LIST_OP_NOMEM;
+        size_t words = 0;
+        for (size_t b = 0; b < blocksCount; b++) {
+            size_t from = b * FROZEN_BLOCK_ELEMS;
+            size_t to = (from + FROZEN_BLOCK_ELEMS < count) ? from + FROZEN_BLOCK_ELEMS : count;
+            Block block = {source[from], source[from], words, 0};
+            for (size_t i = from + 1; i < to; i++) {
+                if (source[i] < block.min)
+                    block.min = source[i];
+                if (source[i] > block.max)
+                    block.max = source[i];
+            }
+            uint64_t range = (uint64_t) block.max - (uint64_t) block.min;
+            block.width = (range == 0) ? 0 : 64 - __builtin_clzll((unsigned long long) range);
+            words += ((to - from) * block.width + 63) / 64;
+            newBlocks[b] = block;
+        }
+
+        auto *newBits = (uint64_t *) calloc(words + 2, sizeof(uint64_t));
+        if (newBits == nullptr) {
+            free(newBlocks);
+            return LIST_OP_NOMEM;
+        }
+        for (size_t i = 0; i < count; i++) {
+            const Block &block = newBlocks[i / FROZEN_BLOCK_ELEMS];
+            if (block.width == 0)
+                continue;
+            uint64_t delta = (uint64_t) source[i] - (uint64_t) block.min;
+            size_t bit = (i % FROZEN_BLOCK_ELEMS) * block.width;
+            uint64_t *word = newBits + block.word + bit / 64;
+            size_t shift = bit % 64;
+            word[0] |= delta << shift;
+            if (shift + block.width > 64)
+                word[1] |= delta >> (64 - shift);
+        }
+        this->blocks = newBlocks;
+        this->bits = newBits;
+        this->bitsWords = words;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Replaces contents with the values of the list in logical order
+     */
+    ListOpResult build(const SwiftyList<ListElem> &list, bool packed) {
+        FrozenSwiftyList<ListElem> result;
+        result.size = list.size;
+        result.values = (ListElem *) malloc(list.size * sizeof(ListElem) + 1);
+        if (result.values == nullptr)
+            return LIST_OP_NOMEM;
+        list.forEachChunk(result.values, list.size, [](const ListElem *, size_t) { return true; });
+
+        if constexpr (packable) {
+            if (packed) {
+                if (result.pack(result.values, result.size) != LIST_OP_OK)
+                    return LIST_OP_NOMEM;
+                free(result.values);
+                result.values = nullptr;
+            }
+        }
+        *this = std::move(result);
+        return LIST_OP_OK;
+    }
+
+    void release() {
+        free(this->values);
+        free(this->blocks);
+        free(this->bits);
+        this->values = nullptr;
+        this->blocks = nullptr;
+        this->bits = nullptr;
+        this->size = 0;
+        this->bitsWords = 0;
+    }
+
+public:
+    FrozenSwiftyList() : values(nullptr), blocks(nullptr), bits(nullptr), size(0), bitsWords(0) {}
+
+    FrozenSwiftyList(const FrozenSwiftyList &) = delete;
+
+    FrozenSwiftyList &operator=(const FrozenSwiftyList &) = delete;
+
+    FrozenSwiftyList(FrozenSwiftyList &&other) noexcept : values(other.values), blocks(other.blocks),
+                                                          bits(other.bits), size(other.size),
+                                                          bitsWords(other.bitsWords) {
+        other.values = nullptr;
+        other.blocks = nullptr;
+        other.bits = nullptr;
+        other.size = 0;
+        other.bitsWords = 0;
+    }
+
+    FrozenSwiftyList &operator=(FrozenSwiftyList &&other) noexcept {
+        std::swap(this->values, other.values);
+        std::swap(this->blocks, other.blocks);
+        std::swap(this->bits, other.bits);
+        std::swap(this->size, other.size);
+        std::swap(this->bitsWords, other.bitsWords);
+        return *this;
+    }
+
+    ~FrozenSwiftyList() {
+        this->release();
+    }
+
+    /**
+     * Get an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value, may be nullptr
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem *value) const {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        if (value != nullptr)
+            *value = this->valueAt(pos);
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get count consecutive elements starting from the logical position from
+     * @param from - logical pos of the first element
+     * @param count - number of elements
+     * @param values - retrieved values
+     * @return operation result
+     */
+    ListOpResult getLogicRange(size_t from, size_t count, ListElem *values) const {
+        if (from > this->size || count > this->size - from)
+            return LIST_OP_OVERFLOW;
+        if (values == nullptr && count != 0)
+            return LIST_OP_SEGFAULT;
+        for (size_t i = 0; i < count; i++)
+            values[i] = this->valueAt(from + i);
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Calls func(value) for all elements in logical order, packed blocks are decoded one at a time
+     */
+    template<typename Func>
+    void forEach(Func func) const {
+        if constexpr (packable) {
+            if (this->blocks != nullptr) {
+                ListElem chunk[FROZEN_BLOCK_ELEMS];
+                for (size_t b = 0; b < blocksFor(this->size); b++) {
+                    size_t count = this->unpackBlock(b, chunk);
+                    for (size_t i = 0; i < count; i++)
+                        func(chunk[i]);
+                }
+                return;
+            }
+        }
+        for (size_t i = 0; i < this->size; i++)
+            func(this->values[i]);
+    }
+
+    /**
+     * Search an element in the list. Retrieves the logical position of the first match.
+     * Packed blocks whose minimum and maximum exclude the value are not decoded.
+     * @param pos - logical pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult searchLogic(size_t *pos, const ListElem value) const {
+        if (pos == nullptr)
+            return LIST_OP_SEGFAULT;
+        if constexpr (packable) {
+            if (this->blocks != nullptr) {
+                ListElem chunk[FROZEN_BLOCK_ELEMS];
+                for (size_t b = 0; b < blocksFor(this->size); b++) {
+                    if (value < this->blocks[b].min || value > this->blocks[b].max)
+                        continue;
+                    size_t count = this->unpackBlock(b, chunk);
+                    size_t found = findIn(chunk, count, value);
+                    if (found != count) {
+                        *pos = b * FROZEN_BLOCK_ELEMS + found;
+                        return LIST_OP_OK;
+                    }
+                }
+                return LIST_OP_NOTFOUND;
+            }
+        }
+        size_t found = findIn(this->values, this->size, value);
+        if (found == this->size)
+            return LIST_OP_NOTFOUND;
+        *pos = found;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Replaces contents of the list with the frozen values. The list comes out optimized.
+     * @param list - target list, not altered if there is no memory
+     * @return operation result
+     */
+    ListOpResult thaw(SwiftyList<ListElem> *list) const {
+        if (list == nullptr)
+            return LIST_OP_SEGFAULT;
+        return list->assignValues(this->size, [this](size_t pos) { return this->valueAt(pos); });
+    }
+
+    /**
+     * Bytes of values or packed blocks, the object itself excluded
+     */
+    size_t getMemoryBytes() const {
+        if (this->blocks == nullptr)
+            return this->size * sizeof(ListElem);
+        return blocksFor(this->size) * sizeof(Block) + this->bitsWords * sizeof(uint64_t);
+    }
+
+    size_t getSize() const {
+        return this->size;
+    }
+
+    bool isEmpty() const {
+        return this->size == 0;
+    }
+
+    bool isPacked() const {
+        return this->blocks != nullptr;
+    }
+};
+
+#endif /* SwiftyFrozenList_hpp */
@@ -0,0 +1,307 @@
+/**
+ * SwiftyLRU - capacity-bounded LRU cache on SwiftyList
+ *
+ * Recency order is kept in a SwiftyList preallocated for capacity entries: the
+ * most recently used entry is the first one. Hits are relinked to the front with
+ * moveToFront(), misses over capacity reuse the cell of the evicted tail entry,
+ * so cells are never allocated or released after warm-up.
+ *
+ * Keys are found through an open-addressing index (linear probing, backward-shift
+ * deletion) that stores key, hash and physical position of the entry, so lookups
+ * do not touch the list until the key is found. Slots and entries are copied bytewise
+ * and never destroyed, so keys and values must be trivially copyable.
+ */
+
+#ifndef SwiftyLRU_hpp
+#define SwiftyLRU_hpp
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include "SwiftyList.hpp"
+
+/**
+ * Number of keys getBatch hashes and prefetches ahead of probing
+ */
+const size_t SWIFTY_LRU_BATCH_CHUNK = 64;
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+struct SwiftyLRU {
+private:
+    static_assert(std::is_trivially_copyable<K>::value, "index slots require trivially copyable keys");
+    static_assert(std::is_trivially_copyable<V>::value, "cached entries require trivially copyable values");
+
+    struct Entry {
+        K key;
+        V value;
+
+        bool operator==(const Entry &other) const {
+            return this->key == other.key;
+        }
+    };
+
+    /**
+     * Index slot, pos is 0 for empty slots
+     */
+    struct Slot {
+        K      key;
+        size_t hash;
+        size_t pos;
+    };
+
+    SwiftyList<Entry> list;
+    Slot              *slots;
+    size_t            mask;
+    size_t            capacity;
+    Hash              hasher;
+
+    size_t hashOf(const K &key) const {
+        // Fibonacci hashing spreads identity hashes of integers over the whole table
+        return (size_t) ((uint64_t) this->hasher(key) * 0x9E3779B97F4A7C15ull);
+    }
+
+    size_t home(size_t hash) const {
+        return (hash >> 17) & this->mask;
+    }
+
+    /**
+     * Slot holding the key or the empty slot where it should be inserted
+     */
+    size_t probe(const K &key, size_t hash) const {
+        size_t i = this->home(hash);
+        while (this->slots[i].pos != 0 && !(this->slots[i].hash == hash && this->slots[i].key == key))
+            i = (i + 1) & this->mask;
+        return i;
+    }
+
+    /**
+     * Empties the slot and shifts following entries of the cluster back
+     */
+    void eraseSlot(size_t i) {
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & this->mask;
+            if (this->slots[j].pos == 0)
+                break;
+            size_t k = this->home(this->slots[j].hash);
+            bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable) {
+                this->slots[i] = this->slots[j];
+                i = j;
+            }
+        }
+        this->slots[i].pos = 0;
+    }
+
+    /**
+     * Puts the key into the empty slot i and the entry to the front
+     */
+    ListOpResult insertNew(size_t i, const K &key, size_t hash, const V &value) {
+        size_t pos = 0;
+        if (this->list.getSize() < this->capacity) {
+            ListOpResult res = this->list.pushFront({key, value}, &pos);
+            if (res != LIST_OP_OK)
+                return res;
+        } else {
+            pos = this->list.end();
+            Entry evicted = {};
+            this->list.get(pos, &evicted);
+            size_t evictedSlot = this->probe(evicted.key, this->hashOf(evicted.key));
+            this->eraseSlot(evictedSlot);
+            i = this->probe(key, hash);
+            this->list.set(pos, {key, value});
+            this->list.moveToFront(pos);
+        }
+        this->slots[i].key = key;
+        this->slots[i].hash = hash;
+        this->slots[i].pos = pos;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Finds the key by precomputed hash and moves its entry to the front
+     */
+    ListOpResult lookup(const K &key, size_t hash, V *value) {
+        size_t i = this->probe(key, hash);
+        if (this->slots[i].pos == 0)
+            return LIST_OP_NOTFOUND;
+        size_t pos = this->slots[i].pos;
+        if (value != nullptr) {
+            Entry entry = {};
+            this->list.get(pos, &entry);
+            *value = entry.value;
+        }
+        return this->list.moveToFront(pos);
+    }
+
+public:
+    /**
+     * @param capacity - maximum number of entries, at least one
+     */
+    explicit SwiftyLRU(size_t capacity) : list(capacity ? capacity : 1, 0, nullptr, false), slots(nullptr), mask(0),
+                                          capacity(capacity ? capacity : 1), hasher() {
+        size_t slotsCount = 2;
+        while (slotsCount < this->capacity * 2)
+            slotsCount *= 2;
+        this->slots = (Slot *) calloc(slotsCount, sizeof(Slot));
+        this->mask = slotsCount - 1;
+    }
+
+    SwiftyLRU(const SwiftyLRU &) = delete;
+
+    SwiftyLRU &operator=(const SwiftyLRU &) = delete;
+
+    ~SwiftyLRU() {
+        free(this->slots);
+    }
+
+    /**
+     * Get value and mark the entry as the most recently used
+     * @param key - searched key
+     * @param value - retrieved value, may be nullptr
+     * @return operation result, LIST_OP_NOTFOUND on miss
+     */
+    ListOpResult get(const K &key, V *value) {
+        if (this->slots == nullptr)
+            return LIST_OP_NOMEM;
+        return this->lookup(key, this->hashOf(key), value);
+    }
+
+    /**
+     * Get value without changing recency
+     * @param key - searched key
+     * @param value - retrieved value
+     * @return operation result, LIST_OP_NOTFOUND on miss
+     */
+    ListOpResult peek(const K &key, V *value) {
+        if (this->slots == nullptr)
+            return LIST_OP_NOMEM;
+        size_t i = this->probe(key, this->hashOf(key));
+        if (this->slots[i].pos == 0)
+            return LIST_OP_NOTFOUND;
+        Entry entry = {};
+        this->list.get(this->slots[i].pos, &entry);
+        if (value != nullptr)
+            *value = entry.value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Looks up several keys. Keys are taken in chunks of SWIFTY_LRU_BATCH_CHUNK, index slots
+     * of a chunk are prefetched before they are probed.
+     * @param keys - searched keys
+     * @param count - number of keys
+     * @param values - retrieved values, left untouched for missing keys
+     * @param found - per key flags whether it was found, may be nullptr
+     * @param hits - number of found keys, may be nullptr
+     * @return operation result
+     */
+    ListOpResult getBatch(const K *keys, size_t count, V *values, bool *found = nullptr, size_t *hits = nullptr) {
+        if (this->slots == nullptr)
+            return LIST_OP_NOMEM;
+        if (count != 0 && (keys == nullptr || values == nullptr))
+            return LIST_OP_SEGFAULT;
+        // hashes are kept so the second pass only probes slots already on their way to the cache
+        size_t hashes[SWIFTY_LRU_BATCH_CHUNK];
+        size_t hitsCount = 0;
+        for (size_t from = 0; from < count; from += SWIFTY_LRU_BATCH_CHUNK) {
+            size_t chunk = std::min(count - from, SWIFTY_LRU_BATCH_CHUNK);
+            for (size_t i = 0; i < chunk; i++) {
+                hashes[i] = this->hashOf(keys[from + i]);
+                __builtin_prefetch(&this->slots[this->home(hashes[i])]);
+            }
+            for (size_t i = 0; i < chunk; i++) {
+                ListOpResult res = this->lookup(keys[from + i], hashes[i], &values[from + i]);
+                if (found != nullptr)
+                    found[from + i] = (res == LIST_OP_OK);
+                if (res == LIST_OP_OK)
+                    hitsCount++;
+            }
+        }
+        if (hits != nullptr)
+            *hits = hitsCount;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Inserts or updates the entry and marks it as the most recently used.
+     * The least recently used entry is evicted when the cache is full.
+     * @param key - key
+     * @param value - value
+     * @return operation result
+     */
+    ListOpResult put(const K &key, const V &value) {
+        if (this->slots == nullptr)
+            return LIST_OP_NOMEM;
+        size_t hash = this->hashOf(key);
+        size_t i = this->probe(key, hash);
+        if (this->slots[i].pos == 0)
+            return this->insertNew(i, key, hash, value);
+        size_t pos = this->slots[i].pos;
+        ListOpResult res = this->list.set(pos, {key, value});
+        if (res != LIST_OP_OK)
+            return res;
+        return this->list.moveToFront(pos);
+    }
+
+    /**
+     * Removes the entry
+     * @param key - key
+     * @return operation result, LIST_OP_NOTFOUND if there is no such key
+     */
+    ListOpResult erase(const K &key) {
+        if (this->slots == nullptr)
+            return LIST_OP_NOMEM;
+        size_t i = this->probe(key, this->hashOf(key));
+        if (this->slots[i].pos == 0)
+            return LIST_OP_NOTFOUND;
+        size_t pos = this->slots[i].pos;
+        this->eraseSlot(i);
+        return this->list.remove(pos);
+    }
+
+    bool contains(const K &key) const {
+        if (this->slots == nullptr)
+            return false;
+        return this->slots[this->probe(key, this->hashOf(key))].pos != 0;
+    }
+
+    /**
+     * Least recently used key, the next one to be evicted
+     * @param key - retrieved key
+     * @return operation result
+     */
+    ListOpResult lruKey(K *key) {
+        if (this->list.isEmpty())
+            return LIST_OP_UNDERFLOW;
+        Entry entry = {};
+        this->list.get(this->list.end(), &entry);
+        *key = entry.key;
+        return LIST_OP_OK;
+    }
+
+    ListOpResult clear() {
+        if (this->slots != nullptr)
+            memset((void *) this->slots, 0, (this->mask + 1) * sizeof(Slot));
+        return this->list.clear();
+    }
+
+    size_t getSize() const {
+        return this->list.getSize();
+    }
+
+    size_t getCapacity() const {
+        return this->capacity;
+    }
+
+    /**
+     * Recency list, the most recently used entry first
+     */
+    const SwiftyList<Entry> &getList() const {
+        return this->list;
+    }
+};
+
+#endif /* SwiftyLRU_hpp */
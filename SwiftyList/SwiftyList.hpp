@@ -12,22 +12,49 @@
 #ifndef SwiftyList_hpp
 #define SwiftyList_hpp
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <unistd.h>
+#include "SwiftyListPool.hpp"
 
 #define DOTPATH "/usr/local/bin/dot"
 #define PERFORM_CHECKS(where) {                             \
-if (this->useChecks || this->params->getVerbose() != 0){    \
+if (this->useChecks || this->params.getVerbose() != 0){     \
     ListOpResult resCheck = this->checkUp();                \
     this->opDumper(resCheck, where);                        \
     if (resCheck != LIST_OP_OK) return resCheck;            \
     }                                                       \
 }
 
+#define DETACH_STORAGE() {                                  \
+    ListOpResult resDetach = this->detach();                \
+    if (resDetach != LIST_OP_OK) return resDetach;          \
+}
+
+#define RECORD_OP(op, first, second, value) \
+    RecordScope recordScope(this, op, first, second, value);
+
 #define DUMP_STATUS_REASON(status, reason) this->opDumper(status, reason)
 const size_t INITIAL_INCREASE = 16;
 
+/**
+ * Number of elements kept inside the list object before storage spills to the heap
+ */
+#ifndef SWIFTY_LIST_INLINE_CAPACITY
+#define SWIFTY_LIST_INLINE_CAPACITY 8
+#endif
+const size_t SERIALIZE_CHUNK_BYTES = 1 << 16;
+
 enum ListOpResult {
     LIST_OP_OK,
     LIST_OP_NOMEM,
@@ -35,19 +62,228 @@ enum ListOpResult {
     LIST_OP_OVERFLOW,
     LIST_OP_UNDERFLOW,
     LIST_OP_NOTFOUND,
-    LIST_OP_SEGFAULT
+    LIST_OP_SEGFAULT,
+    LIST_OP_IOERROR
+};
+
+/**
+ * Operations written to a workload trace
+ */
+enum SwiftyListTraceOp {
+    TRACE_OP_INITIAL = 1,
+    TRACE_OP_INSERT_AFTER,
+    TRACE_OP_INSERT_AFTER_LOGIC,
+    TRACE_OP_INSERT_BEFORE,
+    TRACE_OP_INSERT_BEFORE_LOGIC,
+    TRACE_OP_PUSH_FRONT,
+    TRACE_OP_PUSH_BACK,
+    TRACE_OP_SET,
+    TRACE_OP_SET_LOGIC,
+    TRACE_OP_GET,
+    TRACE_OP_GET_LOGIC,
+    TRACE_OP_POP,
+    TRACE_OP_POP_FRONT,
+    TRACE_OP_POP_BACK,
+    TRACE_OP_POP_LOGIC,
+    TRACE_OP_REMOVE,
+    TRACE_OP_REMOVE_LOGIC,
+    TRACE_OP_SWAP,
+    TRACE_OP_SWAP_LOGIC,
+    TRACE_OP_CLEAR,
+    TRACE_OP_OPTIMIZE,
+    TRACE_OP_SEARCH,
+    TRACE_OP_SEARCH_LOGIC,
+    TRACE_OP_MOVE_AFTER,
+    TRACE_OP_UNRECORDED,
+    TRACE_OP_COUNT
+};
+
+/**
+ * second argument of insert operations is the physical position of the inserted element
+ */
+const size_t TRACE_INSERT_RESULT = SIZE_MAX;
+
+/**
+ * Receives public operations of a list, see SwiftyListTrace.hpp
+ */
+struct SwiftyListRecorder {
+    virtual ~SwiftyListRecorder() = default;
+
+    /**
+     * @param op - operation
+     * @param first - first position argument
+     * @param second - second position argument or position of the inserted element
+     * @param value - value argument or nullptr
+     */
+    virtual void record(SwiftyListTraceOp op, size_t first, size_t second, const void *value) = 0;
+};
+
+/**
+ * Provides list storage outside the process heap, see SwiftySharedList.hpp
+ */
+struct SwiftyListStorageSource {
+    virtual ~SwiftyListStorageSource() = default;
+
+    /**
+     * @param bytes - requested size
+     * @param actualBytes - usable size of the returned storage
+     * @return storage or nullptr if there is no memory
+     */
+    virtual void *allocate(size_t bytes, size_t *actualBytes) = 0;
+
+    /**
+     * Takes back storage the list no longer uses
+     */
+    virtual void release(void *storage) = 0;
 };
 
+/**
+ * Invariants checked by SwiftyList::validate()
+ */
+enum SwiftyListInvariant {
+    LIST_INVARIANT_NONE,
+    LIST_INVARIANT_CAPACITY,      // size + freeSize exceeds capacity
+    LIST_INVARIANT_LINK_RANGE,    // next or previous of an element is out of storage
+    LIST_INVARIANT_LINK_TARGET,   // next or previous of an element is a free cell
+    LIST_INVARIANT_LINK_SYMMETRY, // previous[next[pos]] or next[previous[pos]] is not pos
+    LIST_INVARIANT_OPTIMIZED,     // list is marked optimized but pos is not logical position + 1
+    LIST_INVARIANT_SIZE,          // number of valid cells differs from size
+    LIST_INVARIANT_CHAIN,         // elements form more than one ring
+    LIST_INVARIANT_FREE_LIST,     // free list has a cycle, a valid cell or a broken back link
+    LIST_INVARIANT_FREE_SIZE,     // length of the free list differs from freeSize
+    LIST_INVARIANT_HANDLES        // handle table does not match nodes
+};
+
+/**
+ * First violated invariant found by validation and the physical position it was found at
+ */
+struct SwiftyListValidation {
+    SwiftyListInvariant invariant;
+    size_t              pos;
+};
+
+const size_t VALIDATE_BLOCK = 256;
+
+/**
+ * How free cells are chosen for new elements.
+ * LIFO - the most recently released cell, O(1).
+ * NEAREST - free cell physically nearest to the insertion neighbour, found in the free cells bitmap.
+ * pushBack takes the cell right after the tail whenever it is free.
+ */
+enum SwiftyListAllocPolicy {
+    LIST_ALLOC_LIFO,
+    LIST_ALLOC_NEAREST
+};
+
+/**
+ * Stable reference to a list element, see SwiftyList::handleOf().
+ * Survives optimize() and other operations that move elements; generation
+ * tells a live handle from a stale one whose table entry was reused.
+ */
+struct SwiftyListHandle {
+    size_t   index;
+    uint32_t generation;
+};
+
+const uint32_t SWIFTY_LIST_FORMAT_VERSION = 1;
+const char     SWIFTY_LIST_FORMAT_MAGIC[4] = {'S', 'W', 'L', 'S'};
+
+/**
+ * Header of the binary list representation.
+ * Followed by size values of elemSize bytes in logical order.
+ */
+struct SwiftyListFileHeader {
+    char     magic[4];
+    uint32_t version;
+    uint64_t size;
+    uint32_t elemSize;
+    uint32_t flags;
+    uint64_t checksum;
+};
+
+/**
+ * FNV-1a over 64-bit words, tail bytes are folded in at the end.
+ * Chunks can be fed in any split, result does not depend on it.
+ */
+struct SwiftyListChecksum {
+private:
+    uint64_t hash;
+    uint64_t pending;
+    size_t   pendingBytes;
+
+    void mix(uint64_t word) {
+        this->hash ^= word;
+        this->hash *= 0x100000001b3ULL;
+    }
+
+public:
+    SwiftyListChecksum() : hash(0xcbf29ce484222325ULL), pending(0), pendingBytes(0) {}
+
+    void update(const void *data, size_t len) {
+        const unsigned char *bytes = (const unsigned char *) data;
+        while (this->pendingBytes != 0 && len != 0) {
+            this->pending |= (uint64_t) (*bytes++) << (8 * this->pendingBytes++);
+            len--;
+            if (this->pendingBytes == sizeof(uint64_t)) {
+                this->mix(this->pending);
+                this->pending = 0;
+                this->pendingBytes = 0;
+            }
+        }
+        for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+            uint64_t word = 0;
+            memcpy(&word, bytes, sizeof(uint64_t));
+            this->mix(word);
+        }
+        for (; len != 0; len--)
+            this->pending |= (uint64_t) (*bytes++) << (8 * this->pendingBytes++);
+    }
+
+    [[nodiscard]] uint64_t digest() const {
+        SwiftyListChecksum tmp = *this;
+        if (tmp.pendingBytes != 0)
+            tmp.mix(tmp.pending ^ ((uint64_t) tmp.pendingBytes << 56));
+        return tmp.hash;
+    }
+};
+
+template<typename ListElem>
+struct SwiftyConcurrentList;
+
+struct SwiftyListAlgorithms;
+
+template<typename ListElem>
+struct SwiftyListSnapshot;
+
+template<typename ListElem>
+struct FrozenSwiftyList;
+
+template<typename ListElem>
+struct SwiftySharedListView;
+
+template<typename ListElem, typename Monoid>
+struct SwiftyAggregateList;
+
 template<typename ListElem>
 struct SwiftyList {
 private:
+    template<typename Elem, typename Monoid>
+    friend struct SwiftyAggregateList;
+    friend struct SwiftyConcurrentList<ListElem>;
+    friend struct SwiftyListAlgorithms;
+    friend struct SwiftyListSnapshot<ListElem>;
+    friend struct FrozenSwiftyList<ListElem>;
+    friend struct SwiftySharedListView<ListElem>;
+
+    // cells are raw storage: nodes are moved with memcpy and values are never constructed or destroyed
+    static_assert(std::is_trivially_copyable<ListElem>::value, "SwiftyList requires trivially copyable ListElem");
+
     struct ListGraphDumper;
     struct SwiftyListNode;
     struct SwiftyListParams;
 
-    SwiftyList<ListElem>::ListGraphDumper *dumper;
+    mutable SwiftyList<ListElem>::ListGraphDumper *dumper;
     SwiftyList<ListElem>::SwiftyListNode *storage;
-    SwiftyList<ListElem>::SwiftyListParams *params;
 
     bool optimized;
     bool useChecks;
@@ -58,6 +294,83 @@ private:
     size_t freePtr;
     size_t freeSize;
 
+    SwiftyListAllocPolicy allocPolicy;
+    uint64_t *freeMap;
+    size_t    freeMapWords;
+
+    /**
+     * Number of owners of storage when it is shared with snapshots, nullptr if the list owns it alone
+     */
+    std::atomic<size_t> *storageRefs;
+
+    /**
+     * Pool heap storage is taken from, nullptr for malloc
+     */
+    SwiftyListPool *pool;
+    size_t         poolGeneration;
+
+    /**
+     * Source of storage outside the heap, nullptr for heap or pool storage. Disables inline storage.
+     */
+    SwiftyListStorageSource *storageSource;
+
+    SwiftyListRecorder *recorder;
+    mutable size_t     recordDepth;
+    size_t             recordedPos;
+
+    /**
+     * Handle table entry, pos is 0 for released entries. Entry 0 is never used.
+     */
+    struct HandleEntry {
+        size_t   pos;
+        size_t   nextFree;
+        uint32_t generation;
+    };
+
+    /**
+     * Handle tables are allocated when the first handle is taken.
+     * nodeHandles maps physical position to the handle entry of its element, 0 if there is none.
+     */
+    HandleEntry *handles;
+    size_t      handlesCapacity;
+    size_t      handlesUsed;
+    size_t      freeHandle;
+    size_t      *nodeHandles;
+    size_t      nodeHandlesCapacity;
+
+    /**
+     * Records the outermost public operation when it finishes, so that operations
+     * called from other ones (pushBack from insertAfter and so on) are not recorded twice
+     */
+    struct RecordScope {
+        const SwiftyList  *list;
+        SwiftyListTraceOp op;
+        size_t            first;
+        size_t            second;
+        const ListElem    *value;
+        bool              counted;
+        bool              outer;
+
+        RecordScope(const SwiftyList *list, SwiftyListTraceOp op, size_t first, size_t second,
+                    const ListElem *value) : list(list), op(op), first(first), second(second), value(value),
+                                             counted(list->recorder != nullptr), outer(false) {
+            if (this->counted)
+                this->outer = (list->recordDepth++ == 0);
+        }
+
+        ~RecordScope() {
+            if (!this->counted)
+                return;
+            this->list->recordDepth--;
+            if (this->outer && this->list->recorder != nullptr) {
+                size_t recordedSecond = this->second;
+                if (recordedSecond == TRACE_INSERT_RESULT)
+                    recordedSecond = this->list->recordedPos;
+                this->list->recorder->record(this->op, this->first, recordedSecond, this->value);
+            }
+        }
+    };
+
     struct ListGraphDumper {
     private:
         FILE *file;
@@ -102,17 +415,129 @@ private:
         }
     };
 
+    SwiftyListParams params;
+
+    /**
+     * Storage of small lists: the sentinel and up to SWIFTY_LIST_INLINE_CAPACITY elements
+     * live in the list object itself, storage spills to the heap when the list grows further
+     */
+    alignas(SwiftyListNode) unsigned char inlineStorage[(SWIFTY_LIST_INLINE_CAPACITY + 1) * sizeof(SwiftyListNode)];
+
+    SwiftyListNode *inlineNodes() {
+        return (SwiftyListNode *) this->inlineStorage;
+    }
+
+    bool storageInline() const {
+        return this->storage == (const SwiftyListNode *) this->inlineStorage;
+    }
+
+    /**
+     * Allocates uninitialized storage for at least capacity elements,
+     * from the storage source or the pool if the list has one
+     * @param capacity - requested capacity, replaced with the actual one
+     * @return new storage or nullptr if no memory
+     */
+    SwiftyListNode *allocStorage(size_t *capacity) const {
+        size_t bytes = (*capacity + 2) * sizeof(SwiftyListNode);
+        if (this->pool == nullptr && this->storageSource == nullptr)
+            return (SwiftyListNode *) malloc(bytes);
+        size_t actualBytes = 0;
+        SwiftyListNode *newStorage = nullptr;
+        if (this->storageSource != nullptr)
+            newStorage = (SwiftyListNode *) this->storageSource->allocate(bytes, &actualBytes);
+        else
+            newStorage = (SwiftyListNode *) this->pool->allocate(bytes, &actualBytes);
+        if (newStorage != nullptr)
+            *capacity = actualBytes / sizeof(SwiftyListNode) - 2;
+        return newStorage;
+    }
+
+    /**
+     * Releases storage that is no longer used unless it is the inline one.
+     * Segments of a pool that was reset since are not returned.
+     */
+    void freeStorage(SwiftyListNode *oldStorage) {
+        if (oldStorage == this->inlineNodes() || oldStorage == nullptr)
+            return;
+        if (this->storageSource != nullptr)
+            this->storageSource->release(oldStorage);
+        else
+            releaseHeapStorage(oldStorage, this->pool, this->poolGeneration);
+    }
+
+    static void releaseHeapStorage(SwiftyListNode *oldStorage, SwiftyListPool *pool, size_t generation) {
+        if (pool == nullptr)
+            free(oldStorage);
+        else if (pool->getGeneration() == generation)
+            pool->release(oldStorage);
+    }
+
+    /**
+     * Moves storage to newCapacity + 2 heap cells. Only used cells are copied, the rest is left uninitialized.
+     * Plain heap storage is reallocated in place, any other one is copied to storage from the list's allocator.
+     */
+    ListOpResult resizeStorage(size_t newCapacity) {
+        SwiftyListNode *newStorage = nullptr;
+        if (this->storageInline() || this->pool != nullptr || this->storageSource != nullptr) {
+            newStorage = this->allocStorage(&newCapacity);
+            if (newStorage != nullptr) {
+                this->copyNodes(newStorage);
+                this->freeStorage(this->storage);
+            }
+        } else {
+            newStorage = (SwiftyListNode *) realloc(this->storage, (newCapacity + 2) * sizeof(SwiftyListNode));
+        }
+        if (newStorage == nullptr)
+            return LIST_OP_NOMEM;
+        this->storage = newStorage;
+        this->capacity = newCapacity;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Moves heap storage of a list that fits back into the inline one
+     */
+    void shrinkToInline() {
+        if (this->storageInline() || this->storageRefs != nullptr || this->storage == nullptr ||
+            this->storageSource != nullptr || this->sumSize() > SWIFTY_LIST_INLINE_CAPACITY)
+            return;
+        memcpy((void *) this->inlineStorage, this->storage, (this->sumSize() + 1) * sizeof(SwiftyListNode));
+        this->freeStorage(this->storage);
+        this->storage = this->inlineNodes();
+        this->capacity = SWIFTY_LIST_INLINE_CAPACITY;
+    }
+
+    /**
+     * Points storage to the inline buffer or allocates initialSize + 1 cells on the heap.
+     * Only the sentinel is initialized.
+     */
+    void initStorage(size_t initialSize) {
+        this->storage = nullptr;
+        if (initialSize > SWIFTY_LIST_INLINE_CAPACITY)
+            this->storage = (SwiftyListNode *) malloc((initialSize + 1) * sizeof(SwiftyListNode));
+        if (this->storage != nullptr) {
+            this->capacity = initialSize;
+        } else {
+            this->storage = this->inlineNodes();
+            this->capacity = SWIFTY_LIST_INLINE_CAPACITY;
+        }
+        this->storage[0].next = 0;
+        this->storage[0].previous = 0;
+        this->storage[0].valid = false;
+    }
+
     /**
      * Retrieves next possible free pos at all costs.
      * Reallocates container if needed.
+     * @param near - physical pos the new cell should be close to
      */
-    size_t getFreePos(bool mutating = false) {
+    size_t getFreePos(bool mutating = false, size_t near = 0) {
         if (freeSize != 0) {
             size_t newPos = this->freePtr;
-            if (mutating) {
-                this->freeSize--;
-                this->freePtr = this->storage[newPos].next;
-            }
+            if (this->allocPolicy == LIST_ALLOC_NEAREST)
+                newPos = this->nearestFree(near);
+            if (mutating)
+                this->unlinkFree(newPos);
             this->storage[newPos].valid = true;
             return newPos;
         }
@@ -124,6 +549,94 @@ private:
         return  this->size + 1;
     }
 
+    /**
+     * Removes cell from the free list. Free list is doubly linked:
+     * head's previous and last cell's next point to themselves.
+     */
+    void unlinkFree(size_t pos) {
+        size_t previous = this->storage[pos].previous;
+        size_t next = this->storage[pos].next;
+        bool head = (previous == pos);
+        bool last = (next == pos);
+        if (head)
+            this->freePtr = next;
+        else
+            this->storage[previous].next = last ? previous : next;
+        if (!last)
+            this->storage[next].previous = head ? next : previous;
+        this->freeSize--;
+        if (this->freeMap != nullptr)
+            this->freeMap[pos / 64] &= ~(uint64_t(1) << (pos % 64));
+    }
+
+    /**
+     * Free cell nearest to pos. Words of the bitmap are scanned outwards from pos,
+     * so the result is the nearest one up to the word granularity.
+     */
+    size_t nearestFree(size_t pos) const {
+        size_t word = pos / 64;
+        bool beyond = (word >= this->freeMapWords);
+        if (beyond)
+            word = this->freeMapWords - 1;
+        for (size_t distance = 0; distance < this->freeMapWords; distance++) {
+            size_t forward = 0;
+            size_t backward = 0;
+            bool forwardFound = false;
+            bool backwardFound = false;
+            if (!beyond && word + distance < this->freeMapWords) {
+                uint64_t bits = this->freeMap[word + distance];
+                if (distance == 0)
+                    bits &= ~uint64_t(0) << (pos % 64);
+                if (bits != 0) {
+                    forward = (word + distance) * 64 + __builtin_ctzll(bits);
+                    forwardFound = true;
+                }
+            }
+            if (distance <= word) {
+                uint64_t bits = this->freeMap[word - distance];
+                if (distance == 0 && !beyond)
+                    bits &= ~(~uint64_t(0) << (pos % 64));
+                if (bits != 0) {
+                    backward = (word - distance) * 64 + 63 - __builtin_clzll(bits);
+                    backwardFound = true;
+                }
+            }
+            if (forwardFound && (!backwardFound || forward - pos <= pos - backward))
+                return forward;
+            if (backwardFound)
+                return backward;
+        }
+        return this->freePtr;
+    }
+
+    /**
+     * Makes bitmap cover cell pos
+     */
+    bool growFreeMap(size_t pos) {
+        if (pos / 64 < this->freeMapWords)
+            return true;
+        size_t words = this->freeMapWords == 0 ? 1 : this->freeMapWords;
+        while (words <= pos / 64)
+            words *= 2;
+        uint64_t *newMap = (uint64_t *) realloc(this->freeMap, words * sizeof(uint64_t));
+        if (newMap == nullptr)
+            return false;
+        memset(newMap + this->freeMapWords, 0, (words - this->freeMapWords) * sizeof(uint64_t));
+        this->freeMap = newMap;
+        this->freeMapWords = words;
+        return true;
+    }
+
+    /**
+     * Forgets all free cells
+     */
+    void resetFree() {
+        this->freePtr = 0;
+        this->freeSize = 0;
+        if (this->freeMap != nullptr)
+            memset(this->freeMap, 0, this->freeMapWords * sizeof(uint64_t));
+    }
+
     /**
      * Reallocates container so that it can hold one more value
      * Reallocation is not performed if some freeSize cells are available.
@@ -138,17 +651,357 @@ private:
         
         if (this->capacity == newCapacity + 2)
             return LIST_OP_OK;
+        if (this->pool != nullptr)
+            newCapacity = this->capacity + 1;
+        return this->resizeStorage(newCapacity);
+    }
+
+    /**
+     * Resolves positions and passes physical ones to op
+     */
+    template<typename Op>
+    ListOpResult logicBatch(const size_t *positions, size_t count, Op op) {
+        if (count == 0)
+            return LIST_OP_OK;
+        if (positions == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "logicBatch nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        size_t *physical = (size_t *) malloc(count * sizeof(size_t));
+        if (physical == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "logicBatch no memory");
+            return LIST_OP_NOMEM;
+        }
+        ListOpResult res = this->resolveLogicBatch(positions, count, physical);
+        if (res == LIST_OP_OK)
+            res = op(physical);
+        else
+            DUMP_STATUS_REASON(res, "logicBatch positions");
+        free(physical);
+        return res;
+    }
+
+    /**
+     * Converts logical positions to physical ones. In de-optimized mode positions are
+     * sorted and resolved in one forward walk that prefetches the upcoming node.
+     * @param physical - physical positions in request order
+     * @return operation result
+     */
+    ListOpResult resolveLogicBatch(const size_t *positions, size_t count, size_t *physical) const {
+        for (size_t i = 0; i < count; i++) {
+            if (positions[i] >= this->size)
+                return LIST_OP_OVERFLOW;
+        }
+        if (this->optimized) {
+            for (size_t i = 0; i < count; i++)
+                physical[i] = positions[i] + 1;
+            return LIST_OP_OK;
+        }
+        size_t *order = (size_t *) malloc(count * sizeof(size_t));
+        if (order == nullptr)
+            return LIST_OP_NOMEM;
+        for (size_t i = 0; i < count; i++)
+            order[i] = i;
+        std::stable_sort(order, order + count, [positions](size_t a, size_t b) {
+            return positions[a] < positions[b];
+        });
+        size_t iterator = this->storage[0].next;
+        size_t logic = 0;
+        for (size_t i = 0; i < count; i++) {
+            size_t target = positions[order[i]];
+            while (logic < target) {
+                iterator = this->storage[iterator].next;
+                __builtin_prefetch(&this->storage[this->storage[iterator].next]);
+                logic++;
+            }
+            physical[order[i]] = iterator;
+        }
+        free(order);
+        return LIST_OP_OK;
+    }
 
-        SwiftyList<ListElem>::SwiftyListNode *newStorage = (SwiftyList<ListElem>::SwiftyListNode *)
-                                            realloc(this->storage,(newCapacity + 2)
-                                                    * sizeof(SwiftyList<ListElem>::SwiftyListNode));
-        if (newStorage == NULL)
+    /**
+     * Copy of used cells of source in a storage of the same capacity from this list's
+     * storage source, pool or the heap
+     * @param source - list whose cells are copied
+     * @param newCapacity - retrieved capacity of the new storage
+     * @return new storage or nullptr if no memory
+     */
+    SwiftyListNode *copyStorage(const SwiftyList &source, size_t *newCapacity) const {
+        *newCapacity = source.capacity;
+        SwiftyListNode *newStorage = this->allocStorage(newCapacity);
+        if (newStorage == nullptr)
+            return nullptr;
+        source.copyNodes(newStorage);
+        return newStorage;
+    }
+
+    /**
+     * Copies used cells to target with a single memcpy
+     */
+    void copyNodes(SwiftyListNode *target) const {
+        memcpy(target, this->storage, (this->sumSize() + 1) * sizeof(SwiftyListNode));
+    }
+
+    /**
+     * Drops one reference to shared storage, the last owner frees it
+     */
+    static void releaseStorage(const SwiftyListNode *storage, std::atomic<size_t> *refs) {
+        if (refs->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            free((void *) storage);
+            delete refs;
+        }
+    }
+
+    /**
+     * Releases current storage whether it is shared or not
+     */
+    void releaseOwnStorage() {
+        if (this->storageRefs != nullptr) {
+            releaseStorage(this->storage, this->storageRefs);
+            this->storageRefs = nullptr;
+        } else {
+            this->freeStorage(this->storage);
+        }
+        this->storage = nullptr;
+    }
+
+    /**
+     * Makes the list the only owner of its storage before mutation.
+     * Storage shared with alive snapshots is copied once to storage from the list's source,
+     * pool or the heap, snapshots keep the old one.
+     * @return operation result
+     */
+    ListOpResult detach() {
+        if (this->storageRefs == nullptr)
+            return LIST_OP_OK;
+        if (this->storageRefs->load(std::memory_order_acquire) == 1) {
+            delete this->storageRefs;
+            this->storageRefs = nullptr;
+            return LIST_OP_OK;
+        }
+        size_t ownCapacity = 0;
+        SwiftyListNode *own = this->copyStorage(*this, &ownCapacity);
+        if (own == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "detach no memory");
             return LIST_OP_NOMEM;
-        this->storage = newStorage;
-        this->capacity = newCapacity;
+        }
+        releaseStorage(this->storage, this->storageRefs);
+        this->storageRefs = nullptr;
+        this->storage = own;
+        this->capacity = ownCapacity;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Takes all resources of other, other is left empty without storage
+     */
+    void stealFrom(SwiftyList &other) {
+        this->storage = other.storage;
+        if (other.storageInline()) {
+            this->storage = this->inlineNodes();
+            memcpy((void *) this->storage, other.storage, (other.sumSize() + 1) * sizeof(SwiftyListNode));
+        }
+        this->params = other.params;
+        this->optimized = other.optimized;
+        this->useChecks = other.useChecks;
+        this->capacity = other.capacity;
+        this->size = other.size;
+        this->freePtr = other.freePtr;
+        this->freeSize = other.freeSize;
+        this->allocPolicy = other.allocPolicy;
+        this->freeMap = other.freeMap;
+        this->freeMapWords = other.freeMapWords;
+        this->storageRefs = other.storageRefs;
+        this->pool = other.pool;
+        this->poolGeneration = other.poolGeneration;
+        this->storageSource = other.storageSource;
+        this->recorder = other.recorder;
+        this->recordDepth = 0;
+        this->recordedPos = 0;
+        this->handles = other.handles;
+        this->handlesCapacity = other.handlesCapacity;
+        this->handlesUsed = other.handlesUsed;
+        this->freeHandle = other.freeHandle;
+        this->nodeHandles = other.nodeHandles;
+        this->nodeHandlesCapacity = other.nodeHandlesCapacity;
+        this->dumper = nullptr;
+        other.storage = nullptr;
+        other.handles = nullptr;
+        other.nodeHandles = nullptr;
+        other.freeMap = nullptr;
+        other.storageRefs = nullptr;
+        other.recorder = nullptr;
+        other.DestructList();
+    }
+
+    bool handlesActive() const {
+        return this->nodeHandles != nullptr;
+    }
+
+    /**
+     * Makes nodeHandles cover physical positions up to pos
+     */
+    bool growNodeHandles(size_t pos) {
+        if (pos < this->nodeHandlesCapacity)
+            return true;
+        size_t newCapacity = this->nodeHandlesCapacity * 2;
+        if (newCapacity < this->capacity + 2)
+            newCapacity = this->capacity + 2;
+        if (newCapacity <= pos)
+            newCapacity = pos + 1;
+        auto *newNodeHandles = (size_t *) realloc(this->nodeHandles, newCapacity * sizeof(size_t));
+        if (newNodeHandles == nullptr)
+            return false;
+        memset(newNodeHandles + this->nodeHandlesCapacity, 0,
+               (newCapacity - this->nodeHandlesCapacity) * sizeof(size_t));
+        this->nodeHandles = newNodeHandles;
+        this->nodeHandlesCapacity = newCapacity;
+        return true;
+    }
+
+    size_t nodeHandle(size_t pos) const {
+        return (pos < this->nodeHandlesCapacity) ? this->nodeHandles[pos] : 0;
+    }
+
+    void releaseHandleEntry(size_t index) {
+        HandleEntry &entry = this->handles[index];
+        entry.generation++;
+        entry.pos = 0;
+        entry.nextFree = this->freeHandle;
+        this->freeHandle = index;
+    }
+
+    /**
+     * Invalidates the handle of the element at pos, called when the element is removed
+     */
+    void dropHandle(size_t pos) {
+        size_t index = this->nodeHandle(pos);
+        if (index == 0)
+            return;
+        this->releaseHandleEntry(index);
+        this->nodeHandles[pos] = 0;
+    }
+
+    /**
+     * Invalidates all handles
+     */
+    void dropAllHandles() {
+        if (!this->handlesActive())
+            return;
+        for (size_t index = 1; index <= this->handlesUsed; index++) {
+            if (this->handles[index].pos != 0)
+                this->releaseHandleEntry(index);
+        }
+        memset(this->nodeHandles, 0, this->nodeHandlesCapacity * sizeof(size_t));
+    }
+
+    /**
+     * Points neighbours of the cell back to it
+     */
+    void relinkCell(size_t pos) {
+        this->storage[this->storage[pos].previous].next = pos;
+        this->storage[this->storage[pos].next].previous = pos;
+    }
+
+    static size_t swappedLink(size_t link, size_t first, size_t second) {
+        if (link == first)
+            return second;
+        if (link == second)
+            return first;
+        return link;
+    }
+
+    /**
+     * Exchanges two occupied cells keeping the logical order, handles follow their elements.
+     * nodeHandles must already cover both cells.
+     */
+    void swapCells(size_t first, size_t second) {
+        SwiftyListNode firstNode = this->storage[first];
+        SwiftyListNode secondNode = this->storage[second];
+        firstNode.next = swappedLink(firstNode.next, first, second);
+        firstNode.previous = swappedLink(firstNode.previous, first, second);
+        secondNode.next = swappedLink(secondNode.next, first, second);
+        secondNode.previous = swappedLink(secondNode.previous, first, second);
+        this->storage[second] = firstNode;
+        this->storage[first] = secondNode;
+        this->relinkCell(first);
+        this->relinkCell(second);
+        if (this->handlesActive()) {
+            size_t firstHandle = this->nodeHandle(first);
+            size_t secondHandle = this->nodeHandle(second);
+            this->nodeHandles[first] = secondHandle;
+            this->nodeHandles[second] = firstHandle;
+            if (firstHandle != 0)
+                this->handles[firstHandle].pos = second;
+            if (secondHandle != 0)
+                this->handles[secondHandle].pos = first;
+        }
+    }
+
+    /**
+     * Moves handle of the element at from to the cell to. nodeHandles must already cover to.
+     */
+    void moveHandle(size_t from, size_t to) {
+        size_t index = this->nodeHandle(from);
+        if (index == 0)
+            return;
+        this->nodeHandles[from] = 0;
+        this->nodeHandles[to] = index;
+        this->handles[index].pos = to;
+    }
+
+    /**
+     * Renumbers handles for storage built by optimizedStorage(). Must be called before the switch.
+     * @return operation result
+     */
+    ListOpResult remapHandlesOptimized() {
+        if (!this->handlesActive())
+            return LIST_OP_OK;
+        auto *newNodeHandles = (size_t *) calloc(this->size + 2, sizeof(size_t));
+        if (newNodeHandles == nullptr)
+            return LIST_OP_NOMEM;
+        size_t iterator = this->storage[0].next;
+        for (size_t i = 1; i <= this->size; i++) {
+            size_t index = this->nodeHandle(iterator);
+            if (index != 0) {
+                newNodeHandles[i] = index;
+                this->handles[index].pos = i;
+            }
+            iterator = this->storage[iterator].next;
+        }
+        free(this->nodeHandles);
+        this->nodeHandles = newNodeHandles;
+        this->nodeHandlesCapacity = this->size + 2;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Physical position of the element referenced by handle
+     * @return operation result, LIST_OP_SEGFAULT for stale or unknown handles
+     */
+    ListOpResult resolveHandle(SwiftyListHandle handle, size_t *pos) const {
+        if (handle.index == 0 || handle.index > this->handlesUsed)
+            return LIST_OP_SEGFAULT;
+        const HandleEntry &entry = this->handles[handle.index];
+        if (entry.generation != handle.generation || entry.pos == 0)
+            return LIST_OP_SEGFAULT;
+        *pos = entry.pos;
         return LIST_OP_OK;
     }
 
+    /**
+     * Makes storage hold cells up to pos
+     */
+    ListOpResult reserve(size_t pos) {
+        if (pos <= this->capacity)
+            return LIST_OP_OK;
+        size_t newCapacity = (this->capacity == 0) ? INITIAL_INCREASE : this->capacity * 2;
+        if (newCapacity < pos)
+            newCapacity = pos;
+        return this->resizeStorage(newCapacity);
+    }
+
     /**
      * Generates random image name
      */
@@ -180,54 +1033,636 @@ private:
         } else {
             this->freeSize++;
             this->storage[pos].next = this->freePtr;
+            this->storage[this->freePtr].previous = pos;
             this->freePtr = pos;
         }
+        if (this->freeMap != nullptr) {
+            if (this->growFreeMap(pos))
+                this->freeMap[pos / 64] |= uint64_t(1) << (pos % 64);
+            else
+                this->setAllocPolicy(LIST_ALLOC_LIFO);
+        }
+    }
+
+    /**
+     * Byte sinks and sources the binary format is written to and read from
+     */
+    struct FileSink {
+        FILE *file;
+        long  start;
+
+        explicit FileSink(FILE *file) : file(file), start(ftell(file)) {}
+
+        bool seekable() const {
+            return this->start >= 0;
+        }
+
+        bool write(const void *data, size_t len) {
+            return fwrite(data, 1, len, this->file) == len;
+        }
+
+        bool patch(const SwiftyListFileHeader &header) {
+            long end = ftell(this->file);
+            if (end < 0 || fseek(this->file, this->start, SEEK_SET) != 0)
+                return false;
+            bool written = this->write(&header, sizeof(header));
+            return fseek(this->file, end, SEEK_SET) == 0 && written;
+        }
+    };
+
+    struct FdSink {
+        int   fd;
+        off_t start;
+
+        explicit FdSink(int fd) : fd(fd), start(lseek(fd, 0, SEEK_CUR)) {}
+
+        bool seekable() const {
+            return this->start >= 0;
+        }
+
+        bool write(const void *data, size_t len) {
+            const char *bytes = (const char *) data;
+            while (len != 0) {
+                ssize_t done = ::write(this->fd, bytes, len);
+                if (done < 0 && errno == EINTR)
+                    continue;
+                if (done <= 0)
+                    return false;
+                bytes += done;
+                len -= (size_t) done;
+            }
+            return true;
+        }
+
+        bool patch(const SwiftyListFileHeader &header) {
+            return pwrite(this->fd, &header, sizeof(header), this->start) == (ssize_t) sizeof(header);
+        }
+    };
+
+    struct BufferSink {
+        char   *buffer;
+        size_t bufferSize;
+        size_t used;
+
+        BufferSink(void *buffer, size_t bufferSize) : buffer((char *) buffer), bufferSize(bufferSize), used(0) {}
+
+        bool seekable() const {
+            return true;
+        }
+
+        bool write(const void *data, size_t len) {
+            if (this->bufferSize - this->used < len)
+                return false;
+            memcpy(this->buffer + this->used, data, len);
+            this->used += len;
+            return true;
+        }
+
+        bool patch(const SwiftyListFileHeader &header) {
+            memcpy(this->buffer, &header, sizeof(header));
+            return true;
+        }
+    };
+
+    struct FileSource {
+        FILE *file;
+
+        explicit FileSource(FILE *file) : file(file) {}
+
+        bool available(size_t) const {
+            return true;
+        }
+
+        bool read(void *data, size_t len) {
+            return fread(data, 1, len, this->file) == len;
+        }
+    };
+
+    struct FdSource {
+        int fd;
+
+        explicit FdSource(int fd) : fd(fd) {}
+
+        bool available(size_t) const {
+            return true;
+        }
+
+        bool read(void *data, size_t len) {
+            char *bytes = (char *) data;
+            while (len != 0) {
+                ssize_t done = ::read(this->fd, bytes, len);
+                if (done < 0 && errno == EINTR)
+                    continue;
+                if (done <= 0)
+                    return false;
+                bytes += done;
+                len -= (size_t) done;
+            }
+            return true;
+        }
+    };
+
+    struct BufferSource {
+        const char *buffer;
+        size_t     bufferSize;
+        size_t     used;
+
+        BufferSource(const void *buffer, size_t bufferSize) : buffer((const char *) buffer), bufferSize(bufferSize),
+                                                              used(0) {}
+
+        bool available(size_t len) const {
+            return this->bufferSize - this->used >= len;
+        }
+
+        bool read(void *data, size_t len) {
+            if (this->bufferSize - this->used < len)
+                return false;
+            memcpy(data, this->buffer + this->used, len);
+            this->used += len;
+            return true;
+        }
+    };
+
+    /**
+     * Collects values in logical order into chunk, calls consumer for every filled chunk.
+     * Optimized lists are read sequentially, others follow the next links.
+     */
+    template<typename Consumer>
+    bool forEachChunk(ListElem *chunk, size_t chunkElems, Consumer consumer) const {
+        size_t iterator = this->storage[0].next;
+        size_t done = 0;
+        while (done < this->size) {
+            size_t count = this->size - done;
+            if (count > chunkElems)
+                count = chunkElems;
+            if (this->optimized) {
+                for (size_t i = 0; i < count; i++)
+                    chunk[i] = this->storage[done + i + 1].value;
+            } else {
+                for (size_t i = 0; i < count; i++) {
+                    chunk[i] = this->storage[iterator].value;
+                    iterator = this->storage[iterator].next;
+                }
+            }
+            if (!consumer(chunk, count))
+                return false;
+            done += count;
+        }
+        return true;
+    }
+
+    /**
+     * Writes header and values in logical order to the sink.
+     * Checksum is patched into the header afterwards when the sink allows it,
+     * otherwise it is calculated by a separate pass.
+     */
+    template<typename Sink>
+    ListOpResult serializeTo(Sink &sink) const {
+        SwiftyListFileHeader header = {};
+        memcpy(header.magic, SWIFTY_LIST_FORMAT_MAGIC, sizeof(header.magic));
+        header.version = SWIFTY_LIST_FORMAT_VERSION;
+        header.size = this->size;
+        header.elemSize = sizeof(ListElem);
+
+        size_t chunkElems = SERIALIZE_CHUNK_BYTES / sizeof(ListElem) + 1;
+        ListElem *chunk = (ListElem *) malloc(chunkElems * sizeof(ListElem));
+        if (chunk == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "serialize no memory");
+            return LIST_OP_NOMEM;
+        }
+
+        SwiftyListChecksum checksum;
+        bool seekable = sink.seekable();
+        if (!seekable) {
+            this->forEachChunk(chunk, chunkElems, [&checksum](const ListElem *data, size_t count) {
+                checksum.update(data, count * sizeof(ListElem));
+                return true;
+            });
+            header.checksum = checksum.digest();
+        }
+
+        bool written = sink.write(&header, sizeof(header)) &&
+                       this->forEachChunk(chunk, chunkElems, [&](const ListElem *data, size_t count) {
+                           if (seekable)
+                               checksum.update(data, count * sizeof(ListElem));
+                           return sink.write(data, count * sizeof(ListElem));
+                       });
+        free(chunk);
+        if (written && seekable) {
+            header.checksum = checksum.digest();
+            written = sink.patch(header);
+        }
+        if (!written) {
+            DUMP_STATUS_REASON(LIST_OP_IOERROR, "serialize write failed");
+            return LIST_OP_IOERROR;
+        }
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Reads the whole values block with a single read into the tail of the new storage,
+     * then spreads it forward into optimized layout. Node i never overlaps values i + 1..n
+     * as nodes are at least as wide as values.
+     * Sources that know their length reject a size the remaining bytes cannot hold before allocating.
+     */
+    template<typename Source>
+    ListOpResult deserializeFrom(Source &source) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        SwiftyListFileHeader header = {};
+        if (!source.read(&header, sizeof(header))) {
+            DUMP_STATUS_REASON(LIST_OP_IOERROR, "deserialize header read failed");
+            return LIST_OP_IOERROR;
+        }
+        if (memcmp(header.magic, SWIFTY_LIST_FORMAT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version == 0 || header.version > SWIFTY_LIST_FORMAT_VERSION ||
+            header.elemSize != sizeof(ListElem) || header.size > SIZE_MAX / sizeof(SwiftyListNode) - 2) {
+            DUMP_STATUS_REASON(LIST_OP_CORRUPTED, "deserialize unsupported header");
+            return LIST_OP_CORRUPTED;
+        }
+
+        size_t newSize = header.size;
+        if (!source.available(newSize * sizeof(ListElem))) {
+            DUMP_STATUS_REASON(LIST_OP_IOERROR, "deserialize values truncated");
+            return LIST_OP_IOERROR;
+        }
+        size_t totalBytes = (newSize + 2) * sizeof(SwiftyListNode);
+        size_t newCapacity = newSize;
+        auto *newStorage = this->allocStorage(&newCapacity);
+        if (newStorage == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "deserialize no memory");
+            return LIST_OP_NOMEM;
+        }
+        char *values = (char *) newStorage + totalBytes - newSize * sizeof(ListElem);
+        if (!source.read(values, newSize * sizeof(ListElem))) {
+            this->freeStorage(newStorage);
+            DUMP_STATUS_REASON(LIST_OP_IOERROR, "deserialize values read failed");
+            return LIST_OP_IOERROR;
+        }
+        SwiftyListChecksum checksum;
+        checksum.update(values, newSize * sizeof(ListElem));
+        if (checksum.digest() != header.checksum) {
+            this->freeStorage(newStorage);
+            DUMP_STATUS_REASON(LIST_OP_CORRUPTED, "deserialize checksum mismatch");
+            return LIST_OP_CORRUPTED;
+        }
+
+        for (size_t i = 1; i <= newSize; i++) {
+            SwiftyListNode node;
+            memcpy(&node.value, values + (i - 1) * sizeof(ListElem), sizeof(ListElem));
+            node.next = (i == newSize) ? 0 : i + 1;
+            node.previous = i - 1;
+            node.valid = true;
+            newStorage[i] = node;
+        }
+        newStorage[0].next = (newSize == 0) ? 0 : 1;
+        newStorage[0].previous = newSize;
+        newStorage[0].valid = false;
+
+        this->releaseOwnStorage();
+        this->storage = newStorage;
+        this->size = newSize;
+        this->capacity = newCapacity;
+        this->resetFree();
+        this->dropAllHandles();
+        this->optimized = true;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Replaces contents with newSize values valueAt(0..newSize - 1) in logical order.
+     * The list comes out optimized, it is not altered if there is no memory.
+     */
+    template<typename ValueAt>
+    ListOpResult assignValues(size_t newSize, ValueAt valueAt) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        size_t newCapacity = newSize;
+        auto *newStorage = this->allocStorage(&newCapacity);
+        if (newStorage == nullptr)
+            return LIST_OP_NOMEM;
+        for (size_t i = 1; i <= newSize; i++) {
+            newStorage[i].value = valueAt(i - 1);
+            newStorage[i].next = (i == newSize) ? 0 : i + 1;
+            newStorage[i].previous = i - 1;
+            newStorage[i].valid = true;
+        }
+        newStorage[0].next = (newSize == 0) ? 0 : 1;
+        newStorage[0].previous = newSize;
+        newStorage[0].valid = false;
+
+        this->releaseOwnStorage();
+        this->storage = newStorage;
+        this->size = newSize;
+        this->capacity = newCapacity;
+        this->resetFree();
+        this->dropAllHandles();
+        this->optimized = true;
+        this->shrinkToInline();
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Random access iterator over values of consecutive storage nodes.
+     * Used to sort optimized list in place.
+     */
+    struct ValueIterator {
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = ListElem;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = ListElem *;
+        using reference         = ListElem &;
+
+        SwiftyListNode *node;
+
+        explicit ValueIterator(SwiftyListNode *node = nullptr) : node(node) {}
+
+        reference operator*() const { return this->node->value; }
+        pointer operator->() const { return &this->node->value; }
+        reference operator[](difference_type n) const { return this->node[n].value; }
+
+        ValueIterator &operator++() { ++this->node; return *this; }
+        ValueIterator &operator--() { --this->node; return *this; }
+        ValueIterator operator++(int) { ValueIterator tmp = *this; ++this->node; return tmp; }
+        ValueIterator operator--(int) { ValueIterator tmp = *this; --this->node; return tmp; }
+        ValueIterator &operator+=(difference_type n) { this->node += n; return *this; }
+        ValueIterator &operator-=(difference_type n) { this->node -= n; return *this; }
+        ValueIterator operator+(difference_type n) const { return ValueIterator(this->node + n); }
+        ValueIterator operator-(difference_type n) const { return ValueIterator(this->node - n); }
+        friend ValueIterator operator+(difference_type n, const ValueIterator &it) { return it + n; }
+        difference_type operator-(const ValueIterator &other) const { return this->node - other.node; }
+
+        bool operator==(const ValueIterator &other) const { return this->node == other.node; }
+        bool operator!=(const ValueIterator &other) const { return this->node != other.node; }
+        bool operator<(const ValueIterator &other) const { return this->node < other.node; }
+        bool operator>(const ValueIterator &other) const { return this->node > other.node; }
+        bool operator<=(const ValueIterator &other) const { return this->node <= other.node; }
+        bool operator>=(const ValueIterator &other) const { return this->node >= other.node; }
+    };
+
+    /**
+     * Values of optimized list as a contiguous range
+     */
+    ValueIterator valuesBegin() {
+        return ValueIterator(this->storage + 1);
+    }
+
+    ValueIterator valuesEnd() {
+        return ValueIterator(this->storage + 1 + this->size);
+    }
+
+    /**
+     * Merges two sorted chains terminated by 0. Nodes are relinked through next only,
+     * on equal values nodes of the first chain go first.
+     * @return head of the merged chain
+     */
+    template<typename Compare>
+    size_t mergeChains(size_t first, size_t second, Compare &comp) {
+        size_t head = 0;
+        size_t *link = &head;
+        while (first != 0 && second != 0) {
+            if (comp(this->storage[second].value, this->storage[first].value)) {
+                *link = second;
+                link = &this->storage[second].next;
+                second = this->storage[second].next;
+            } else {
+                *link = first;
+                link = &this->storage[first].next;
+                first = this->storage[first].next;
+            }
+        }
+        *link = (first != 0) ? first : second;
+        return head;
+    }
+
+    /**
+     * Bottom-up merge sort by relinking nodes. bins[i] holds a sorted chain of 2^i nodes.
+     * Values are not moved, previous links are restored at the end.
+     */
+    template<typename Compare>
+    void sortLinks(Compare &comp) {
+        size_t bins[sizeof(size_t) * 8] = {};
+        size_t pos = this->storage[0].next;
+        while (pos != 0) {
+            size_t next = this->storage[pos].next;
+            this->storage[pos].next = 0;
+            size_t chain = pos;
+            size_t bin = 0;
+            for (; bins[bin] != 0; bin++) {
+                chain = this->mergeChains(bins[bin], chain, comp);
+                bins[bin] = 0;
+            }
+            bins[bin] = chain;
+            pos = next;
+        }
+        size_t chain = 0;
+        for (size_t bin = 0; bin < sizeof(size_t) * 8; bin++) {
+            if (bins[bin] != 0)
+                chain = this->mergeChains(bins[bin], chain, comp);
+        }
+
+        size_t previous = 0;
+        this->storage[0].next = chain;
+        for (pos = chain; pos != 0; pos = this->storage[pos].next) {
+            this->storage[pos].previous = previous;
+            previous = pos;
+        }
+        this->storage[0].previous = previous;
+    }
+
+    /**
+     * Builds new storage with nodes aligned in logical order.
+     * Current storage is left untouched.
+     * @param newCapacity - retrieved capacity of the new storage, at least size
+     * @return new storage or nullptr if no memory
+     */
+    SwiftyListNode *optimizedStorage(size_t *newCapacity) const {
+        *newCapacity = this->size;
+        SwiftyList<ListElem>::SwiftyListNode *newStorage = this->allocStorage(newCapacity);
+        if (newStorage == nullptr)
+            return nullptr;
+        newStorage[0] = this->storage[0];
+        newStorage[0].previous = this->size;
+        size_t iterator = this->storage[0].next;
+        for (size_t i = 0; i < this->size; i++) {
+            newStorage[i + 1] = this->storage[iterator];
+            iterator = this->storage[iterator].next;
+            newStorage[i + 1].previous = i;
+            newStorage[i].next = i + 1;
+            newStorage[i].valid = true;
+            if (i + 1 == this->size) {
+                newStorage[i + 1].next = 0;
+            }
+        }
+        return newStorage;
+    }
+
+    /**
+     * Switches to storage built by optimizedStorage(). Old storage is not released.
+     * @param newCapacity - capacity the storage was allocated with
+     */
+    void adoptOptimized(SwiftyListNode *newStorage, size_t newCapacity) {
+        this->optimized = true;
+        this->resetFree();
+        this->storage = newStorage;
+        this->capacity = newCapacity;
     }
 
     /**
      * Dumps information about list if needed
      */
     void opDumper(ListOpResult status, const char* where) const {
-        if (this->params->getVerbose() == 0)
+        if (this->params.getVerbose() == 0)
             return;
-        if (this->params->getVerbose() == 1 && status == LIST_OP_OK)
+        if (this->params.getVerbose() == 1 && status == LIST_OP_OK)
             return;
         char* dumpInfo = (char*)calloc(sizeof("Logging : ") + strlen(where) + 50, sizeof(char));
         sprintf(dumpInfo, "%10s: Logging : \"%s\"",(status == LIST_OP_OK)? "[OK]": "[CAUTION]" , where);
 
-        free(dumpInfo);
+        free(dumpInfo);
+    }
+
+public:
+    SwiftyList(size_t initialSize, short int verbose, FILE *logFile, bool useChecks) :
+            dumper(nullptr),
+            optimized(true),
+            useChecks(useChecks),
+            capacity(initialSize),
+            size(0),
+            freePtr(0),
+            freeSize(0),
+            allocPolicy(LIST_ALLOC_LIFO),
+            freeMap(nullptr),
+            freeMapWords(0),
+            storageRefs(nullptr),
+            pool(nullptr),
+            poolGeneration(0),
+            storageSource(nullptr),
+            recorder(nullptr),
+            recordDepth(0),
+            recordedPos(0),
+            handles(nullptr),
+            handlesCapacity(0),
+            handlesUsed(0),
+            freeHandle(0),
+            nodeHandles(nullptr),
+            nodeHandlesCapacity(0),
+            params(verbose, useChecks, logFile) {
+        this->initStorage(initialSize);
+    }
+
+    /**
+     * Deep copy, the storage is copied with a single memcpy.
+     * The copy is empty if there is no memory for its storage.
+     */
+    SwiftyList(const SwiftyList &other) :
+            dumper(nullptr),
+            optimized(other.optimized),
+            useChecks(other.useChecks),
+            capacity(other.capacity),
+            size(other.size),
+            freePtr(other.freePtr),
+            freeSize(other.freeSize),
+            allocPolicy(LIST_ALLOC_LIFO),
+            freeMap(nullptr),
+            freeMapWords(0),
+            storageRefs(nullptr),
+            pool(nullptr),
+            poolGeneration(0),
+            storageSource(nullptr),
+            recorder(nullptr),
+            recordDepth(0),
+            recordedPos(0),
+            handles(nullptr),
+            handlesCapacity(0),
+            handlesUsed(0),
+            freeHandle(0),
+            nodeHandles(nullptr),
+            nodeHandlesCapacity(0),
+            params(other.params) {
+        if (other.sumSize() <= SWIFTY_LIST_INLINE_CAPACITY) {
+            this->storage = this->inlineNodes();
+            this->capacity = SWIFTY_LIST_INLINE_CAPACITY;
+            other.copyNodes(this->storage);
+        } else {
+            this->storage = this->copyStorage(other, &this->capacity);
+        }
+        if (this->storage == nullptr) {
+            this->optimized = true;
+            this->size = 0;
+            this->freePtr = 0;
+            this->freeSize = 0;
+            this->initStorage(0);
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "copy no memory");
+            return;
+        }
+        if (other.allocPolicy != LIST_ALLOC_LIFO)
+            this->setAllocPolicy(other.allocPolicy);
+        if (other.handlesActive()) {
+            this->handles = (HandleEntry *) malloc(other.handlesCapacity * sizeof(HandleEntry));
+            this->nodeHandles = (size_t *) malloc(other.nodeHandlesCapacity * sizeof(size_t));
+            if (this->handles != nullptr && this->nodeHandles != nullptr) {
+                memcpy(this->handles, other.handles, other.handlesCapacity * sizeof(HandleEntry));
+                memcpy(this->nodeHandles, other.nodeHandles, other.nodeHandlesCapacity * sizeof(size_t));
+                this->handlesCapacity = other.handlesCapacity;
+                this->handlesUsed = other.handlesUsed;
+                this->freeHandle = other.freeHandle;
+                this->nodeHandlesCapacity = other.nodeHandlesCapacity;
+            } else {
+                free(this->handles);
+                free(this->nodeHandles);
+                this->handles = nullptr;
+                this->nodeHandles = nullptr;
+            }
+        }
+    }
+
+    /**
+     * Takes storage of other without copying. Other is left without storage and can only be
+     * destroyed or assigned.
+     */
+    SwiftyList(SwiftyList &&other) noexcept : params(other.params) {
+        this->stealFrom(other);
+    }
+
+    SwiftyList &operator=(const SwiftyList &other) {
+        if (this != &other) {
+            SwiftyList copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
     }
 
-public:
-    SwiftyList(size_t initialSize, short int verbose, FILE *logFile, bool useChecks) :
-            optimized(true),
-            capacity(initialSize),
-            size(0),
-            useChecks(useChecks),
-            freeSize(0),
-            freePtr(0) {
-        this->storage = (SwiftyListNode *) calloc(initialSize + 1, sizeof(SwiftyListNode));
-        this->params = new SwiftyListParams(verbose, useChecks, logFile);
-        this->dumper = new SwiftyList::ListGraphDumper(this, (char*)"tmp.gv");
-        this->storage[0].next = 0;
-        this->storage[0].previous = 0;
-        this->storage[0].valid = false;
+    SwiftyList &operator=(SwiftyList &&other) noexcept {
+        if (this != &other) {
+            this->DestructList();
+            this->stealFrom(other);
+        }
+        return *this;
+    }
+
+    ~SwiftyList() {
+        this->DestructList();
     }
 
     static SwiftyList<ListElem>* CreateNovel (size_t initialSize, short int verbose, FILE *logFile, bool useChecks) {
         auto* thou = static_cast<SwiftyList<ListElem>*>(calloc(1, sizeof(SwiftyList<ListElem>)));
         thou->freePtr = 0;
         thou->freeSize = 0;
+        thou->allocPolicy = LIST_ALLOC_LIFO;
+        thou->freeMap = nullptr;
+        thou->freeMapWords = 0;
+        thou->storageRefs = nullptr;
+        thou->pool = nullptr;
+        thou->poolGeneration = 0;
+        thou->storageSource = nullptr;
+        thou->recorder = nullptr;
+        thou->recordDepth = 0;
+        thou->recordedPos = 0;
         thou->useChecks = useChecks;
         thou->size = 0;
-        thou->capacity = initialSize;
         thou->optimized = true;
-        thou->storage = (SwiftyListNode *) calloc(initialSize + 1, sizeof(SwiftyListNode));
-        thou->params = new SwiftyListParams(verbose, useChecks, logFile);
-        thou->dumper = new SwiftyList::ListGraphDumper(thou, (char*)"tmp.gv");
-        thou->storage[0].next = 0;
-        thou->storage[0].previous = 0;
-        thou->storage[0].valid = false;
+        thou->dumper = nullptr;
+        thou->params = SwiftyListParams(verbose, useChecks, logFile);
+        thou->initStorage(initialSize);
         return thou;
     }
 
@@ -254,7 +1689,9 @@ public:
      * @return operation result
      */
     ListOpResult insertAfter(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        RECORD_OP(TRACE_OP_INSERT_AFTER, pos, TRACE_INSERT_RESULT, &value);
         PERFORM_CHECKS("Insert after setting up");
+        DETACH_STORAGE();
         if (pos > this->sumSize()) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "insert pos overflow");
             return LIST_OP_OVERFLOW;
@@ -266,13 +1703,19 @@ public:
         if (pos != this->storage[0].previous)
             this->optimized = false;
 
-        size_t newPos = this->getFreePos(true);
+        size_t near = pos + 1;
+        if (pos == 0 && this->storage[0].next > 1)
+            near = this->storage[0].next - 1;
+        size_t newPos = this->getFreePos(true, near);
         if (newPos == 0)
             return LIST_OP_NOMEM;
 
         if (physPos != nullptr)
             *physPos = newPos; // TODO: consider phy
 
+        if (this->recorder != nullptr)
+            this->recordedPos = newPos;
+
         this->storage[newPos].value = value;
         this->storage[newPos].previous = pos;
         this->storage[newPos].next = this->storage[pos].next;
@@ -294,6 +1737,7 @@ public:
      * @return operation result
      */
     ListOpResult insertAfterLogic(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        RECORD_OP(TRACE_OP_INSERT_AFTER_LOGIC, pos, TRACE_INSERT_RESULT, &value);
         if (pos > this->size) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "insertAfterLogic pos overflow");
             return LIST_OP_OVERFLOW;
@@ -309,6 +1753,7 @@ public:
      * @return operation result
      */
     ListOpResult insertBefore(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        RECORD_OP(TRACE_OP_INSERT_BEFORE, pos, TRACE_INSERT_RESULT, &value);
         if (pos > this->sumSize()) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "insertBefore pos overflow");
             return LIST_OP_OVERFLOW;
@@ -330,6 +1775,7 @@ public:
      * @return operation result
      */
     ListOpResult insertBeforeLogic(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        RECORD_OP(TRACE_OP_INSERT_BEFORE_LOGIC, pos, TRACE_INSERT_RESULT, &value);
         if (pos > this->size) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "insertBeforeLogic pos overflow");
             return LIST_OP_OVERFLOW;
@@ -344,6 +1790,7 @@ public:
      * @return operation result
      */
     ListOpResult pushFront(const ListElem value, size_t* physPos=nullptr) {
+        RECORD_OP(TRACE_OP_PUSH_FRONT, 0, TRACE_INSERT_RESULT, &value);
         return this->insertAfter(0, value, physPos);
     }
 
@@ -354,6 +1801,7 @@ public:
      * @return operation result
      */
     ListOpResult pushBack(const ListElem value, size_t* physPos=nullptr) {
+        RECORD_OP(TRACE_OP_PUSH_BACK, 0, TRACE_INSERT_RESULT, &value);
         return this->insertAfter(this->storage[0].previous, value, physPos);
     }
 
@@ -364,7 +1812,9 @@ public:
      * @return operation result
      */
     ListOpResult set(size_t pos, const ListElem value) {
+        RECORD_OP(TRACE_OP_SET, pos, 0, &value);
         PERFORM_CHECKS("Set setting up");
+        DETACH_STORAGE();
         if (!this->addressValid(pos)) {
             DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "set segmentation fault");
             return LIST_OP_SEGFAULT;
@@ -380,6 +1830,7 @@ public:
      * @return operation result
      */
     ListOpResult setLogic(size_t pos, const ListElem value) {
+        RECORD_OP(TRACE_OP_SET_LOGIC, pos, 0, &value);
         if (pos > this->size) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "setLogic pos overflow");
             return LIST_OP_OVERFLOW;
@@ -394,7 +1845,8 @@ public:
      * @return operation result
      */
     ListOpResult get(size_t pos, ListElem* value) {
-        if (!this->storage[pos].valid) {
+        RECORD_OP(TRACE_OP_GET, pos, 0, nullptr);
+        if (!this->addressValid(pos)) {
             DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "get segmentation fault");
             return LIST_OP_SEGFAULT;
         }
@@ -413,6 +1865,7 @@ public:
      * @return operation result
      */
     ListOpResult getLogic(size_t pos, ListElem* value=nullptr) {
+        RECORD_OP(TRACE_OP_GET_LOGIC, pos, 0, nullptr);
         if (pos > this->size) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "getLogic pos overflow");
             return LIST_OP_OVERFLOW;
@@ -420,6 +1873,67 @@ public:
         return this->get(this->logicToPhysic(pos), value);
     }
 
+    /**
+     * Get elements at several logical positions in one walk: O(n + k log k) in de-optimized mode
+     * @param positions - logical positions, any order, repeats allowed
+     * @param count - number of positions
+     * @param values - retrieved values in request order
+     * @return operation result
+     */
+    ListOpResult getLogicBatch(const size_t *positions, size_t count, ListElem *values) {
+        if (values == nullptr && count != 0) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "getLogicBatch nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        return this->logicBatch(positions, count, [&](const size_t *physical) {
+            for (size_t i = 0; i < count; i++)
+                values[i] = this->storage[physical[i]].value;
+            return LIST_OP_OK;
+        });
+    }
+
+    /**
+     * Set elements at several logical positions in one walk: O(n + k log k) in de-optimized mode
+     * @param positions - logical positions, any order. For repeated position the last value is kept
+     * @param count - number of positions
+     * @param values - new values in request order
+     * @return operation result
+     */
+    ListOpResult setLogicBatch(const size_t *positions, size_t count, const ListElem *values) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        if (values == nullptr && count != 0) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "setLogicBatch nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        DETACH_STORAGE();
+        return this->logicBatch(positions, count, [&](const size_t *physical) {
+            for (size_t i = 0; i < count; i++)
+                this->storage[physical[i]].value = values[i];
+            return LIST_OP_OK;
+        });
+    }
+
+    /**
+     * Remove elements at several logical positions in one walk: O(n + k log k) in de-optimized mode.
+     * Positions refer to the list before removal.
+     * @param positions - logical positions, any order. Repeated position is removed once
+     * @param count - number of positions
+     * @return operation result
+     */
+    ListOpResult removeLogicBatch(const size_t *positions, size_t count) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        return this->logicBatch(positions, count, [&](const size_t *physical) {
+            for (size_t i = 0; i < count; i++) {
+                if (!this->addressValid(physical[i]))
+                    continue;
+                ListOpResult res = this->pop(physical[i], nullptr);
+                if (res != LIST_OP_OK)
+                    return res;
+            }
+            return LIST_OP_OK;
+        });
+    }
+
     /**
      * Retrieve an element at the physical position pos and remove it
      * @param pos - physical pos of considered element
@@ -427,7 +1941,9 @@ public:
      * @return operation result
      */
     ListOpResult pop(size_t pos, ListElem *value=nullptr) {
+        RECORD_OP(TRACE_OP_POP, pos, 0, nullptr);
         PERFORM_CHECKS("Pop setting up");
+        DETACH_STORAGE();
         if (this->size == 0) {
             DUMP_STATUS_REASON(LIST_OP_UNDERFLOW, "pop pos underflow");
             return LIST_OP_UNDERFLOW;
@@ -446,6 +1962,7 @@ public:
         this->storage[this->storage[pos].next].previous = this->storage[pos].previous;
         this->storage[this->storage[pos].previous].next = this->storage[pos].next;
 
+        this->dropHandle(pos);
         this->addFreePos(pos);
         this->size--;
 
@@ -459,6 +1976,7 @@ public:
      * @return operation result
      */
     ListOpResult popFront(ListElem *value) {
+        RECORD_OP(TRACE_OP_POP_FRONT, 0, 0, nullptr);
         return this->pop(this->storage[0].next, value);
     }
 
@@ -468,6 +1986,7 @@ public:
      * @return operation result
      */
     ListOpResult popBack(ListElem *value) {
+        RECORD_OP(TRACE_OP_POP_BACK, 0, 0, nullptr);
         return this->pop(this->storage[0].previous, value);
     }
 
@@ -478,6 +1997,7 @@ public:
      * @return operation result
      */
     ListOpResult popLogic(size_t pos, ListElem *value) {
+        RECORD_OP(TRACE_OP_POP_LOGIC, pos, 0, nullptr);
         return this->pop(this->logicToPhysic(pos), value);
     }
 
@@ -487,6 +2007,7 @@ public:
      * @return operation result
      */
     ListOpResult remove(size_t pos) {
+        RECORD_OP(TRACE_OP_REMOVE, pos, 0, nullptr);
         return this->pop(pos, nullptr);
     }
 
@@ -496,6 +2017,7 @@ public:
      * @return operation result
      */
     ListOpResult removeLogic(size_t pos) {
+        RECORD_OP(TRACE_OP_REMOVE_LOGIC, pos, 0, nullptr);
         if (pos > this->size) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "pop pos underflow");
             return LIST_OP_OVERFLOW;
@@ -510,7 +2032,9 @@ public:
      * @return operation result
      */
     ListOpResult swap(size_t firstPos, size_t secondPos) {
+        RECORD_OP(TRACE_OP_SWAP, firstPos, secondPos, nullptr);
         PERFORM_CHECKS("Swap setting up");
+        DETACH_STORAGE();
         if (firstPos == secondPos)
             return LIST_OP_OK;
         if (!this->addressValid(firstPos) || !this->addressValid(secondPos)) {
@@ -518,9 +2042,25 @@ public:
             return LIST_OP_SEGFAULT;
         }
 
+        size_t firstHandle = this->nodeHandle(firstPos);
+        size_t secondHandle = this->nodeHandle(secondPos);
+        if ((firstHandle != 0 || secondHandle != 0) && !this->growNodeHandles(std::max(firstPos, secondPos))) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "swap handles no memory");
+            return LIST_OP_NOMEM;
+        }
+
         ListElem tmp = this->storage[firstPos].value;
         this->storage[firstPos].value = this->storage[secondPos].value;
         this->storage[secondPos].value = tmp;
+
+        if (firstHandle != 0 || secondHandle != 0) {
+            this->nodeHandles[firstPos] = secondHandle;
+            this->nodeHandles[secondPos] = firstHandle;
+            if (firstHandle != 0)
+                this->handles[firstHandle].pos = secondPos;
+            if (secondHandle != 0)
+                this->handles[secondHandle].pos = firstPos;
+        }
         PERFORM_CHECKS("Swap tear down");
         return LIST_OP_OK;
     }
@@ -532,6 +2072,7 @@ public:
      * @return operation result
      */
     ListOpResult swapLogic(size_t firstPos, size_t secondPos) {
+        RECORD_OP(TRACE_OP_SWAP_LOGIC, firstPos, secondPos, nullptr);
         if (firstPos > this->size || secondPos > this->size) {
             DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "swapLogic pos underflow");
             return LIST_OP_OVERFLOW;
@@ -539,17 +2080,242 @@ public:
         return this->swap(this->logicToPhysic(firstPos), this->logicToPhysic(secondPos));
     }
 
+    /**
+     * Stable handle of the element at the physical position pos. Handle stays valid through
+     * optimize(), compact(), optimizeRange(), sort(), merge() and swaps until the element is removed.
+     * Taking a handle of the same element again returns the same handle.
+     * @param pos - physical pos of considered element
+     * @param handle - handle of the element
+     * @return operation result
+     */
+    ListOpResult handleOf(size_t pos, SwiftyListHandle *handle) {
+        if (handle == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "handleOf nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        if (pos > this->sumSize() || !this->addressValid(pos)) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "handleOf invalid address");
+            return LIST_OP_SEGFAULT;
+        }
+        if (!this->growNodeHandles(pos)) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "handleOf no memory");
+            return LIST_OP_NOMEM;
+        }
+        size_t index = this->nodeHandles[pos];
+        if (index == 0) {
+            if (this->freeHandle != 0) {
+                index = this->freeHandle;
+                this->freeHandle = this->handles[index].nextFree;
+            } else {
+                if (this->handlesUsed + 1 >= this->handlesCapacity) {
+                    size_t newCapacity = (this->handlesCapacity == 0) ? INITIAL_INCREASE : this->handlesCapacity * 2;
+                    auto *newHandles = (HandleEntry *) realloc(this->handles, newCapacity * sizeof(HandleEntry));
+                    if (newHandles == nullptr) {
+                        DUMP_STATUS_REASON(LIST_OP_NOMEM, "handleOf no memory");
+                        return LIST_OP_NOMEM;
+                    }
+                    memset(newHandles + this->handlesCapacity, 0,
+                           (newCapacity - this->handlesCapacity) * sizeof(HandleEntry));
+                    this->handles = newHandles;
+                    this->handlesCapacity = newCapacity;
+                }
+                index = ++this->handlesUsed;
+            }
+            this->handles[index].pos = pos;
+            this->nodeHandles[pos] = index;
+        }
+        handle->index = index;
+        handle->generation = this->handles[index].generation;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Stable handle of the element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @param handle - handle of the element
+     * @return operation result
+     */
+    ListOpResult handleOfLogic(size_t pos, SwiftyListHandle *handle) {
+        if (pos >= this->size) {
+            DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "handleOfLogic pos overflow");
+            return LIST_OP_OVERFLOW;
+        }
+        return this->handleOf(this->logicToPhysic(pos), handle);
+    }
+
+    /**
+     * Current physical position of the element
+     * @param handle - handle of the element
+     * @param pos - physical pos of the element
+     * @return operation result, LIST_OP_SEGFAULT for stale handles
+     */
+    ListOpResult handlePos(SwiftyListHandle handle, size_t *pos) const {
+        if (pos == nullptr)
+            return LIST_OP_SEGFAULT;
+        return this->resolveHandle(handle, pos);
+    }
+
+    /**
+     * Stops tracking the element. Handle becomes stale, the element is kept.
+     * @param handle - handle of the element
+     * @return operation result
+     */
+    ListOpResult releaseHandle(SwiftyListHandle handle) {
+        size_t pos = 0;
+        ListOpResult res = this->resolveHandle(handle, &pos);
+        if (res != LIST_OP_OK)
+            return res;
+        this->dropHandle(pos);
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get an element by its handle in O(1)
+     * @param handle - handle of the element
+     * @param value - retrieved value
+     * @return operation result, LIST_OP_SEGFAULT for stale handles
+     */
+    ListOpResult getByHandle(SwiftyListHandle handle, ListElem *value) {
+        size_t pos = 0;
+        ListOpResult res = this->resolveHandle(handle, &pos);
+        if (res != LIST_OP_OK) {
+            DUMP_STATUS_REASON(res, "getByHandle stale handle");
+            return res;
+        }
+        return this->get(pos, value);
+    }
+
+    /**
+     * Set an element by its handle in O(1)
+     * @param handle - handle of the element
+     * @param value - new value
+     * @return operation result, LIST_OP_SEGFAULT for stale handles
+     */
+    ListOpResult setByHandle(SwiftyListHandle handle, const ListElem value) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        size_t pos = 0;
+        ListOpResult res = this->resolveHandle(handle, &pos);
+        if (res != LIST_OP_OK) {
+            DUMP_STATUS_REASON(res, "setByHandle stale handle");
+            return res;
+        }
+        return this->set(pos, value);
+    }
+
+    /**
+     * Retrieve an element by its handle and remove it in O(1). Handle becomes stale.
+     * @param handle - handle of the element
+     * @param value - retrieved value
+     * @return operation result, LIST_OP_SEGFAULT for stale handles
+     */
+    ListOpResult popByHandle(SwiftyListHandle handle, ListElem *value=nullptr) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        size_t pos = 0;
+        ListOpResult res = this->resolveHandle(handle, &pos);
+        if (res != LIST_OP_OK) {
+            DUMP_STATUS_REASON(res, "popByHandle stale handle");
+            return res;
+        }
+        return this->pop(pos, value);
+    }
+
+    /**
+     * Remove an element by its handle in O(1). Handle becomes stale.
+     * @param handle - handle of the element
+     * @return operation result, LIST_OP_SEGFAULT for stale handles
+     */
+    ListOpResult removeByHandle(SwiftyListHandle handle) {
+        return this->popByHandle(handle, nullptr);
+    }
+
+    /**
+     * Insert an element after the one referenced by handle in O(1)
+     * @param handle - handle of the element
+     * @param value - value to be inserted
+     * @param inserted - handle of the inserted element
+     * @return operation result, LIST_OP_SEGFAULT for stale handles
+     */
+    ListOpResult insertAfterByHandle(SwiftyListHandle handle, ListElem value, SwiftyListHandle *inserted=nullptr) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        size_t pos = 0;
+        ListOpResult res = this->resolveHandle(handle, &pos);
+        if (res != LIST_OP_OK) {
+            DUMP_STATUS_REASON(res, "insertAfterByHandle stale handle");
+            return res;
+        }
+        size_t newPos = 0;
+        res = this->insertAfter(pos, value, &newPos);
+        if (res != LIST_OP_OK || inserted == nullptr)
+            return res;
+        return this->handleOf(newPos, inserted);
+    }
+
+    /**
+     * Relinks the element at pos after the element at after in O(1). Cells and physical
+     * positions are kept, only links change.
+     * @param pos - physical pos of the moved element
+     * @param after - physical pos of the element to move after, 0 to move to the beginning
+     * @return operation result
+     */
+    ListOpResult moveAfter(size_t pos, size_t after) {
+        RECORD_OP(TRACE_OP_MOVE_AFTER, pos, after, nullptr);
+        PERFORM_CHECKS("MoveAfter setting up");
+        DETACH_STORAGE();
+        if (pos > this->sumSize() || after > this->sumSize()) {
+            DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "moveAfter pos overflow");
+            return LIST_OP_OVERFLOW;
+        }
+        if (!this->addressValid(pos) || (after != 0 && !this->addressValid(after))) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "moveAfter segmentation fault");
+            return LIST_OP_SEGFAULT;
+        }
+        if (pos == after || this->storage[after].next == pos)
+            return LIST_OP_OK;
+        this->optimized = false;
+
+        SwiftyListNode &node = this->storage[pos];
+        this->storage[node.previous].next = node.next;
+        this->storage[node.next].previous = node.previous;
+
+        node.previous = after;
+        node.next = this->storage[after].next;
+        this->storage[node.next].previous = pos;
+        this->storage[after].next = pos;
+        PERFORM_CHECKS("MoveAfter tear down");
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Relinks the element at pos to the beginning in O(1)
+     * @param pos - physical pos of the moved element
+     * @return operation result
+     */
+    ListOpResult moveToFront(size_t pos) {
+        return this->moveAfter(pos, 0);
+    }
+
+    /**
+     * Relinks the element at pos to the end in O(1)
+     * @param pos - physical pos of the moved element
+     * @return operation result
+     */
+    ListOpResult moveToBack(size_t pos) {
+        return this->moveAfter(pos, this->storage[0].previous);
+    }
+
     /**
      * Clears the list
      * @return operation result
      */
     ListOpResult clear() {
+        RECORD_OP(TRACE_OP_CLEAR, 0, 0, nullptr);
         PERFORM_CHECKS("Clear setting up");
+        DETACH_STORAGE();
         this->size = 0;
         this->storage[0].next = 0;
         this->storage[0].previous = 0;
-        this->freeSize = 0;
-        this->freePtr  = 0;
+        this->resetFree();
+        this->dropAllHandles();
         this->reallocate();
         PERFORM_CHECKS("Clear tear down");
         return LIST_OP_OK;
@@ -561,31 +2327,114 @@ public:
      * @return operation result
      */
     ListOpResult optimize() {
+        RECORD_OP(TRACE_OP_OPTIMIZE, 0, 0, nullptr);
         PERFORM_CHECKS("Optimize setting up");
-        SwiftyList<ListElem>::SwiftyListNode *newStorage = (SwiftyList<ListElem>::SwiftyListNode*)(calloc(this->size + 2, sizeof(SwiftyList<ListElem>::SwiftyListNode)));
-        if (newStorage == nullptr) {
+        size_t newCapacity = 0;
+        SwiftyList<ListElem>::SwiftyListNode *newStorage = this->optimizedStorage(&newCapacity);
+        if (newStorage == nullptr || this->remapHandlesOptimized() != LIST_OP_OK) {
+            if (newStorage != nullptr)
+                this->freeStorage(newStorage);
             DUMP_STATUS_REASON(LIST_OP_NOMEM, "optimize no memory");
             return LIST_OP_NOMEM;
         }
-        newStorage[0] = this->storage[0];
-        size_t iterator = this->storage[0].next;
-        for (size_t i = 0; i < this->size; i++) {
-            newStorage[i + 1] = this->storage[iterator];
-            iterator = this->storage[iterator].next;
-            newStorage[i + 1].previous = i;
-            newStorage[i].next = i + 1;
-            newStorage[i].valid = true;
-            if (i + 1 == this->size) {
-                newStorage[i + 1].next = 0;
+        this->releaseOwnStorage();
+        this->adoptOptimized(newStorage, newCapacity);
+        this->shrinkToInline();
+        PERFORM_CHECKS("Optimize tear down");
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Stable sort of the list. De-optimized list is sorted by relinking nodes,
+     * optimized one by moving values in place unless it has handles. List is optimized afterwards.
+     * @param comp - strict weak ordering of values
+     * @return operation result
+     */
+    template<typename Compare = std::less<ListElem>>
+    ListOpResult sort(Compare comp = Compare()) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        PERFORM_CHECKS("Sort setting up");
+        DETACH_STORAGE();
+        if (this->size < 2)
+            return this->optimized ? LIST_OP_OK : this->optimize();
+        if (this->optimized && !this->handlesActive()) {
+            std::stable_sort(this->valuesBegin(), this->valuesEnd(), comp);
+        } else {
+            this->sortLinks(comp);
+            ListOpResult res = this->optimize();
+            if (res != LIST_OP_OK)
+                return res;
+        }
+        PERFORM_CHECKS("Sort tear down");
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Merges sorted other list into this sorted list. Merge is stable: on equal values
+     * elements of this list go first. Other list is left empty, this one is optimized.
+     * Handles of this list follow their elements. Handles of other are invalidated, as
+     * handle tables are per list: they give LIST_OP_SEGFAULT on other, and merged elements
+     * get new handles from handleOf on this list.
+     * @param other - list to be merged
+     * @param comp - ordering both lists are sorted by
+     * @return operation result
+     */
+    template<typename Compare = std::less<ListElem>>
+    ListOpResult merge(SwiftyList<ListElem> &other, Compare comp = Compare()) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        PERFORM_CHECKS("Merge setting up");
+        if (&other == this)
+            return LIST_OP_OK;
+        size_t total = this->size + other.size;
+        size_t newCapacity = total;
+        SwiftyList<ListElem>::SwiftyListNode *newStorage = this->allocStorage(&newCapacity);
+        if (newStorage == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "merge no memory");
+            return LIST_OP_NOMEM;
+        }
+        size_t *newNodeHandles = nullptr;
+        if (this->handlesActive()) {
+            newNodeHandles = (size_t *) calloc(total + 2, sizeof(size_t));
+            if (newNodeHandles == nullptr) {
+                this->freeStorage(newStorage);
+                DUMP_STATUS_REASON(LIST_OP_NOMEM, "merge no memory");
+                return LIST_OP_NOMEM;
             }
         }
-        this->optimized = true;
-        this->freePtr = 0;
-        this->freeSize = 0;
-        free(this->storage);
-        this->storage = newStorage;
-        this->capacity = this->size;
-        PERFORM_CHECKS("Optimize tear down");
+        size_t first = this->storage[0].next;
+        size_t second = other.storage[0].next;
+        for (size_t i = 1; i <= total; i++) {
+            if (first == 0 || (second != 0 && comp(other.storage[second].value, this->storage[first].value))) {
+                newStorage[i].value = other.storage[second].value;
+                second = other.storage[second].next;
+            } else {
+                newStorage[i].value = this->storage[first].value;
+                size_t index = this->nodeHandle(first);
+                if (index != 0) {
+                    newNodeHandles[i] = index;
+                    this->handles[index].pos = i;
+                }
+                first = this->storage[first].next;
+            }
+            newStorage[i].previous = i - 1;
+            newStorage[i].next = (i == total) ? 0 : i + 1;
+            newStorage[i].valid = true;
+        }
+        newStorage[0].next = (total == 0) ? 0 : 1;
+        newStorage[0].previous = total;
+        newStorage[0].valid = false;
+
+        if (newNodeHandles != nullptr) {
+            free(this->nodeHandles);
+            this->nodeHandles = newNodeHandles;
+            this->nodeHandlesCapacity = total + 2;
+        }
+        this->releaseOwnStorage();
+        this->size = total;
+        this->adoptOptimized(newStorage, newCapacity);
+        this->shrinkToInline();
+        other.clear();
+        PERFORM_CHECKS("Merge tear down");
         return LIST_OP_OK;
     }
 
@@ -624,41 +2473,246 @@ public:
     }
 
     /**
-     * Moves iterator to the next physical position
-     * @param pos
-     * @return
+     * Moves iterator to the next physical position
+     * @param pos
+     * @return
+     */
+    ListOpResult prevIterator(size_t* pos) {
+        if (!this->addressValid(*pos))
+            return LIST_OP_SEGFAULT;
+        *pos =  this->storage[*pos].previous;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Check up list's integrity
+     * @return operation result
+     */
+    ListOpResult checkUp() const {
+        if (this->size == 0)
+            return LIST_OP_OK;
+        if (this->size > this->capacity)
+            return LIST_OP_CORRUPTED;
+
+        size_t pos = 0;
+        for (size_t i = 0; i <= this->size; i++) {
+            SwiftyListNode node = this->storage[pos];
+            if ((node.next == pos || node.previous == pos) && this->size > 1)
+                return LIST_OP_CORRUPTED;
+            pos = node.next;
+        }
+
+        if (pos != 0)
+            return LIST_OP_CORRUPTED;
+
+        for (size_t index = 1; this->handlesActive() && index <= this->handlesUsed; index++) {
+            size_t handlePos = this->handles[index].pos;
+            if (handlePos != 0 && (!this->addressValid(handlePos) || this->nodeHandle(handlePos) != index))
+                return LIST_OP_CORRUPTED;
+        }
+
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Full structure validation. Storage is scanned linearly, checking links of every element,
+     * then the free list and the ring of elements are walked. Unlike checkUp() it finds
+     * asymmetric links and size or freeSize mismatches. See parallelValidate() in SwiftyParallel.hpp
+     * for the multithreaded version.
+     * @param report - first violated invariant, may be nullptr
+     * @return operation result
+     */
+    ListOpResult validate(SwiftyListValidation *report = nullptr) const {
+        size_t validCount = 0;
+        SwiftyListValidation found = {LIST_INVARIANT_NONE, 0};
+        if (this->sumSize() > this->capacity)
+            found.invariant = LIST_INVARIANT_CAPACITY;
+        else
+            found.invariant = this->scanSlots(0, this->sumSize() + 1, &validCount, &found.pos);
+        if (found.invariant == LIST_INVARIANT_NONE)
+            found = this->validateWalks(validCount);
+        if (report != nullptr)
+            *report = found;
+        return found.invariant == LIST_INVARIANT_NONE ? LIST_OP_OK : LIST_OP_CORRUPTED;
+    }
+
+    /**
+     * Read-only point-in-time view of the list in O(1). Storage is shared with the snapshot
+     * until the list is mutated: the first mutation after a snapshot copies the whole storage,
+     * O(n), and the snapshot keeps the old one. Snapshots can be read from other threads while
+     * the list is changed.
+     * Lists with a pool or a storage source keep it: their snapshot is a heap copy taken in O(n),
+     * as that storage cannot be released from other threads.
+     * @return snapshot of the current state, empty if there is no memory
+     */
+    SwiftyListSnapshot<ListElem> snapshot() {
+        if (this->pool != nullptr || this->storageSource != nullptr) {
+            auto *copy = (SwiftyListNode *) malloc((this->sumSize() + 2) * sizeof(SwiftyListNode));
+            if (copy == nullptr) {
+                DUMP_STATUS_REASON(LIST_OP_NOMEM, "snapshot no memory");
+                return SwiftyListSnapshot<ListElem>();
+            }
+            this->copyNodes(copy);
+            return SwiftyListSnapshot<ListElem>(copy, new std::atomic<size_t>(1), this->size, this->sumSize(),
+                                                this->optimized);
+        }
+        if (this->storageInline() && this->resizeStorage(this->capacity) != LIST_OP_OK) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "snapshot no memory");
+            return SwiftyListSnapshot<ListElem>();
+        }
+        if (this->storageRefs == nullptr)
+            this->storageRefs = new std::atomic<size_t>(1);
+        this->storageRefs->fetch_add(1, std::memory_order_relaxed);
+        return SwiftyListSnapshot<ListElem>(this->storage, this->storageRefs, this->size, this->sumSize(),
+                                            this->optimized);
+    }
+
+    /**
+     * Immutable copy holding only the values in logical order, defined in SwiftyFrozenList.hpp
+     * @param frozen - target, its previous contents are replaced
+     * @param packed - bit-pack integer values by blocks, ignored for other types
+     * @return operation result
+     */
+    ListOpResult freeze(FrozenSwiftyList<ListElem> *frozen, bool packed = false) const {
+        if (frozen == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "freeze nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        ListOpResult res = frozen->build(*this, packed);
+        if (res != LIST_OP_OK)
+            DUMP_STATUS_REASON(res, "freeze no memory");
+        return res;
+    }
+
+    /**
+     * Starts passing public operations to recorder, nullptr stops recording.
+     * Current elements are passed first as TRACE_OP_INITIAL records in logical order.
+     * Element operations, clear, optimize, search and moveAfter are recorded with their arguments.
+     * Batch, handle, sort, merge, compact, optimizeRange, deserialize and thaw mutations are recorded
+     * as TRACE_OP_UNRECORDED markers without arguments, so the trace cannot be replayed past them.
+     * @param newRecorder - recorder, must outlive recording
+     * @return operation result
+     */
+    ListOpResult setRecorder(SwiftyListRecorder *newRecorder) {
+        this->recorder = newRecorder;
+        this->recordDepth = 0;
+        if (newRecorder == nullptr)
+            return LIST_OP_OK;
+        size_t iterator = this->storage[0].next;
+        for (size_t i = 0; i < this->size; i++) {
+            newRecorder->record(TRACE_OP_INITIAL, i, iterator, &this->storage[iterator].value);
+            iterator = this->storage[iterator].next;
+        }
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Sets the way free cells are chosen for new elements
+     * @param policy - allocation policy
+     * @return operation result
+     */
+    ListOpResult setAllocPolicy(SwiftyListAllocPolicy policy) {
+        if (policy == LIST_ALLOC_LIFO) {
+            free(this->freeMap);
+            this->freeMap = nullptr;
+            this->freeMapWords = 0;
+            this->allocPolicy = policy;
+            return LIST_OP_OK;
+        }
+        if (this->freeMap == nullptr && !this->growFreeMap(this->sumSize() + 1)) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "setAllocPolicy no memory");
+            return LIST_OP_NOMEM;
+        }
+        size_t pos = this->freePtr;
+        for (size_t i = 0; i < this->freeSize; i++) {
+            this->freeMap[pos / 64] |= uint64_t(1) << (pos % 64);
+            pos = this->storage[pos].next;
+        }
+        this->allocPolicy = policy;
+        return LIST_OP_OK;
+    }
+
+    SwiftyListAllocPolicy getAllocPolicy() const {
+        return this->allocPolicy;
+    }
+
+    /**
+     * Moves heap storage to the pool, nullptr moves it back to malloc. Inline storage stays in place.
+     * Pooled lists grow by one size class of the pool instead of doubling.
+     * The list detaches from the pool when a snapshot is taken or a storage source is set.
+     * @param newPool - pool that must outlive the list or its next setPool
+     * @return operation result
      */
-    ListOpResult prevIterator(size_t* pos) {
-        if (!this->addressValid(*pos))
-            return LIST_OP_SEGFAULT;
-        *pos =  this->storage[*pos].previous;
+    ListOpResult setPool(SwiftyListPool *newPool) {
+        DETACH_STORAGE();
+        if (newPool == this->pool)
+            return LIST_OP_OK;
+        if (this->storageSource != nullptr && this->setStorageSource(nullptr) != LIST_OP_OK)
+            return LIST_OP_NOMEM;
+        SwiftyListPool *oldPool = this->pool;
+        size_t oldGeneration = this->poolGeneration;
+        this->pool = newPool;
+        this->poolGeneration = (newPool == nullptr) ? 0 : newPool->getGeneration();
+        if (this->storageInline() || this->storage == nullptr)
+            return LIST_OP_OK;
+
+        size_t newCapacity = this->capacity;
+        SwiftyListNode *newStorage = this->allocStorage(&newCapacity);
+        if (newStorage == nullptr) {
+            this->pool = oldPool;
+            this->poolGeneration = oldGeneration;
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "setPool no memory");
+            return LIST_OP_NOMEM;
+        }
+        memcpy((void *) newStorage, this->storage, (this->sumSize() + 1) * sizeof(SwiftyListNode));
+        releaseHeapStorage(this->storage, oldPool, oldGeneration);
+        this->storage = newStorage;
+        this->capacity = newCapacity;
         return LIST_OP_OK;
     }
 
+    SwiftyListPool *getPool() const {
+        return this->pool;
+    }
+
     /**
-     * Check up list's integrity
+     * Moves storage, inline one included, to the source, nullptr moves it back to the heap.
+     * Storage stays with the source until another source or a pool is set.
+     * @param newSource - source that must outlive the list or its next setStorageSource
      * @return operation result
      */
-    ListOpResult checkUp() const {
-        if (this->size == 0)
+    ListOpResult setStorageSource(SwiftyListStorageSource *newSource) {
+        DETACH_STORAGE();
+        if (newSource == this->storageSource)
+            return LIST_OP_OK;
+        if (this->pool != nullptr && this->setPool(nullptr) != LIST_OP_OK)
+            return LIST_OP_NOMEM;
+        SwiftyListStorageSource *oldSource = this->storageSource;
+        this->storageSource = newSource;
+        if (this->storage == nullptr)
             return LIST_OP_OK;
-        if (this->size > this->capacity)
-            return LIST_OP_CORRUPTED;
 
-        size_t pos = 0;
-        for (size_t i = 0; i <= this->size; i++) {
-            SwiftyListNode node = this->storage[pos];
-            if ((node.next == pos || node.previous == pos) && this->size > 1)
-                return LIST_OP_CORRUPTED;
-            pos = node.next;
+        size_t newCapacity = this->capacity;
+        SwiftyListNode *newStorage = this->allocStorage(&newCapacity);
+        if (newStorage == nullptr) {
+            this->storageSource = oldSource;
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "setStorageSource no memory");
+            return LIST_OP_NOMEM;
         }
-
-        if (pos != 0)
-            return LIST_OP_CORRUPTED;
-
+        memcpy((void *) newStorage, this->storage, (this->sumSize() + 1) * sizeof(SwiftyListNode));
+        if (oldSource != nullptr)
+            oldSource->release(this->storage);
+        else if (!this->storageInline())
+            free(this->storage);
+        this->storage = newStorage;
+        this->capacity = newCapacity;
         return LIST_OP_OK;
     }
 
+    SwiftyListStorageSource *getStorageSource() const {
+        return this->storageSource;
+    }
+
     /**
      * Deoptimizes list
      * @return operation result
@@ -693,7 +2747,101 @@ public:
      * @return operation result
      */
     ListOpResult shrinkToFit() {
-        return this->resize(0);
+        return this->compact();
+    }
+
+    /**
+     * Lays out elements of the logical window [logicFrom, logicTo) in contiguous ascending cells.
+     * Window is laid out in place starting from the cell of its first element: every target cell
+     * is either taken from the free list or swapped with the element occupying it, so storage
+     * does not grow. Swapped elements change their physical positions, handles follow them.
+     * Runs in O(logicTo) in de-optimized mode.
+     * @param logicFrom - logical pos of the first element
+     * @param logicTo - logical pos after the last element
+     * @return operation result
+     */
+    ListOpResult optimizeRange(size_t logicFrom, size_t logicTo) {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        PERFORM_CHECKS("OptimizeRange setting up");
+        DETACH_STORAGE();
+        if (logicFrom > logicTo || logicTo > this->size) {
+            DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "optimizeRange pos overflow");
+            return LIST_OP_OVERFLOW;
+        }
+        if (this->optimized || logicTo - logicFrom < 2)
+            return LIST_OP_OK;
+        if (logicFrom == 0 && logicTo == this->size)
+            return this->optimize();
+
+        size_t count = logicTo - logicFrom;
+        size_t first = this->logicToPhysic(logicFrom);
+        size_t pos = first;
+        size_t contiguous = 1;
+        while (contiguous < count && this->storage[pos].next == pos + 1) {
+            pos++;
+            contiguous++;
+        }
+        if (contiguous == count)
+            return LIST_OP_OK;
+        if (this->handlesActive() && !this->growNodeHandles(this->sumSize())) {
+            DUMP_STATUS_REASON(LIST_OP_NOMEM, "optimizeRange no memory");
+            return LIST_OP_NOMEM;
+        }
+
+        size_t base = std::min(first, this->sumSize() - count + 1);
+        pos = first;
+        for (size_t i = 0; i < count; i++) {
+            size_t target = base + i;
+            if (pos != target) {
+                if (this->storage[target].valid) {
+                    this->swapCells(pos, target);
+                } else {
+                    this->unlinkFree(target);
+                    this->storage[target] = this->storage[pos];
+                    this->relinkCell(target);
+                    this->moveHandle(pos, target);
+                    this->addFreePos(pos);
+                }
+            }
+            pos = this->storage[target].next;
+        }
+        PERFORM_CHECKS("OptimizeRange tear down");
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Moves elements from the end of the storage into free cells and releases the unused tail,
+     * so capacity becomes equal to size. Runs in O(number of free cells).
+     * @return operation result
+     */
+    ListOpResult compact() {
+        RECORD_OP(TRACE_OP_UNRECORDED, 0, 0, nullptr);
+        PERFORM_CHECKS("Compact setting up");
+        DETACH_STORAGE();
+        size_t last = this->sumSize();
+        size_t hole = this->freePtr;
+        for (size_t i = 0; i < this->freeSize; i++) {
+            size_t nextFree = this->storage[hole].next;
+            if (hole <= this->size) {
+                while (!this->storage[last].valid)
+                    last--;
+                SwiftyListNode &node = this->storage[last];
+                this->storage[node.previous].next = hole;
+                this->storage[node.next].previous = hole;
+                this->storage[hole] = node;
+                this->moveHandle(last, hole);
+                node.valid = false;
+                last--;
+            }
+            hole = nextFree;
+        }
+        this->resetFree();
+
+        this->shrinkToInline();
+        if (!this->storageInline())
+            this->resizeStorage(this->size);
+        PERFORM_CHECKS("Compact tear down");
+        return LIST_OP_OK;
     }
 
     /**
@@ -703,6 +2851,7 @@ public:
      * @return operation result
      */
     ListOpResult searchLogic(size_t *pos, const ListElem value) const{
+        RECORD_OP(TRACE_OP_SEARCH_LOGIC, 0, 0, &value);
         PERFORM_CHECKS("Search setting up");
         if (this->size == 0) {
             return LIST_OP_NOTFOUND;
@@ -729,6 +2878,7 @@ public:
      * @return operation result
      */
     ListOpResult search(size_t *pos, const ListElem value) const{
+        RECORD_OP(TRACE_OP_SEARCH, 0, 0, &value);
         PERFORM_CHECKS("Search setting up");
         if (this->size == 0) {
             return LIST_OP_NOTFOUND;
@@ -747,11 +2897,111 @@ public:
         return LIST_OP_NOTFOUND;
     }
 
+    /**
+     * Number of bytes serialize() produces for the current list
+     */
+    size_t serializedSize() const {
+        return sizeof(SwiftyListFileHeader) + this->size * sizeof(ListElem);
+    }
+
+    /**
+     * Write the list in binary format. Logical order is kept, no optimization required
+     * @param file - output stream
+     * @return operation result
+     */
+    ListOpResult serialize(FILE *file) const {
+        if (file == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "serialize nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        FileSink sink(file);
+        return this->serializeTo(sink);
+    }
+
+    /**
+     * Write the list in binary format. Logical order is kept, no optimization required
+     * @param fd - output file descriptor
+     * @return operation result
+     */
+    ListOpResult serialize(int fd) const {
+        FdSink sink(fd);
+        return this->serializeTo(sink);
+    }
+
+    /**
+     * Write the list in binary format. Logical order is kept, no optimization required
+     * @param buffer - output buffer
+     * @param bufferSize - buffer capacity in bytes, at least serializedSize()
+     * @param written - number of bytes written
+     * @return operation result
+     */
+    ListOpResult serialize(void *buffer, size_t bufferSize, size_t *written = nullptr) const {
+        if (buffer == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "serialize nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        if (bufferSize < this->serializedSize()) {
+            DUMP_STATUS_REASON(LIST_OP_OVERFLOW, "serialize buffer overflow");
+            return LIST_OP_OVERFLOW;
+        }
+        BufferSink sink(buffer, bufferSize);
+        ListOpResult res = this->serializeTo(sink);
+        if (written != nullptr)
+            *written = sink.used;
+        return res;
+    }
+
+    /**
+     * Replace list contents with the serialized ones. The list comes out optimized.
+     * List is not altered if reading fails.
+     * @param file - input stream
+     * @return operation result
+     */
+    ListOpResult deserialize(FILE *file) {
+        if (file == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "deserialize nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        FileSource source(file);
+        return this->deserializeFrom(source);
+    }
+
+    /**
+     * Replace list contents with the serialized ones. The list comes out optimized.
+     * List is not altered if reading fails.
+     * @param fd - input file descriptor
+     * @return operation result
+     */
+    ListOpResult deserialize(int fd) {
+        FdSource source(fd);
+        return this->deserializeFrom(source);
+    }
+
+    /**
+     * Replace list contents with the serialized ones. The list comes out optimized.
+     * List is not altered if reading fails.
+     * @param buffer - input buffer
+     * @param bufferSize - buffer size in bytes
+     * @param read - number of bytes consumed
+     * @return operation result
+     */
+    ListOpResult deserialize(const void *buffer, size_t bufferSize, size_t *read = nullptr) {
+        if (buffer == nullptr) {
+            DUMP_STATUS_REASON(LIST_OP_SEGFAULT, "deserialize nullptr detected");
+            return LIST_OP_SEGFAULT;
+        }
+        BufferSource source(buffer, bufferSize);
+        ListOpResult res = this->deserializeFrom(source);
+        if (read != nullptr)
+            *read = (res == LIST_OP_OK) ? source.used : 0;
+        return res;
+    }
+
     /**
      * Dump all informaton as new section
      */
     void dumpAll(const char* sectionName) const{
-        if (this->params->getLogFile() != NULL) {
+        if (this->params.getLogFile() != NULL) {
             this->setNewSection(sectionName);
             this->dumpData();
             this->dumpImage();
@@ -762,7 +3012,7 @@ public:
      * Dump only basic list information
      */
     void dumpData() const{
-        FILE* logFile = this->params->getLogFile();
+        FILE* logFile = this->params.getLogFile();
         fprintf(logFile, "\n<pre><code>\n");
         if (logFile == NULL) return;
 
@@ -787,8 +3037,8 @@ public:
      * Sets new logging section
      */
     void setNewSection(const char *section) const{
-        if (this->params->getLogFile() != NULL)
-            fprintf(this->params->getLogFile(), "<h2>%s</h2>\n", section);
+        if (this->params.getLogFile() != NULL)
+            fprintf(this->params.getLogFile(), "<h2>%s</h2>\n", section);
     }
 
     /**
@@ -796,8 +3046,10 @@ public:
      */
     void dumpImage() const{
         char *name = this->genRandomImageName(20);
+        if (this->dumper == nullptr)
+            this->dumper = new SwiftyList::ListGraphDumper(const_cast<SwiftyList *>(this), (char*)"tmp.gv");
         this->dumper->build(name);
-        if (this->params->getLogFile() != NULL) fprintf(this->params->getLogFile(), "<img src=\"%s\">\n", name);
+        if (this->params.getLogFile() != NULL) fprintf(this->params.getLogFile(), "<img src=\"%s\">\n", name);
         free(name);
     }
 
@@ -825,8 +3077,113 @@ public:
         return this->size == 0;
     }
 
-    SwiftyListParams *getParams() const{
-        return this->params;
+    const SwiftyListParams *getParams() const{
+        return &this->params;
+    }
+
+    /**
+     * Invariant violated by the cell pos alone and its direct neighbours, links are clamped
+     * before use so that a broken link is never dereferenced out of storage
+     */
+    SwiftyListInvariant slotInvariant(size_t pos) const {
+        const SwiftyListNode &node = this->storage[pos];
+        size_t last = this->sumSize();
+        bool linked = node.valid || pos == 0;
+        size_t next = (node.next <= last) ? node.next : 0;
+        size_t previous = (node.previous <= last) ? node.previous : 0;
+        bool inRange = (node.next <= last) & (node.previous <= last);
+        bool targetsValid = (this->storage[next].valid | (next == 0)) &
+                            (this->storage[previous].valid | (previous == 0));
+        bool symmetric = (this->storage[next].previous == pos) & (this->storage[previous].next == pos);
+        size_t orderedNext = (pos == this->size) ? 0 : pos + 1;
+        bool ordered = !this->optimized || ((linked == (pos <= this->size)) & (!linked | (node.next == orderedNext)));
+        if (linked && !inRange)
+            return LIST_INVARIANT_LINK_RANGE;
+        if (linked && !targetsValid)
+            return LIST_INVARIANT_LINK_TARGET;
+        if (linked && !symmetric)
+            return LIST_INVARIANT_LINK_SYMMETRY;
+        if (!ordered)
+            return LIST_INVARIANT_OPTIMIZED;
+        return LIST_INVARIANT_NONE;
+    }
+
+    /**
+     * Checks cells [from, to) one by one without following links. Blocks of VALIDATE_BLOCK cells
+     * are checked without early exits, so the loop is straight-line code the compiler can vectorize,
+     * and only a failing block is checked again to find the cell.
+     * @param validCount - number of valid cells in the range
+     * @param failPos - first failing cell
+     * @return violated invariant
+     */
+    SwiftyListInvariant scanSlots(size_t from, size_t to, size_t *validCount, size_t *failPos) const {
+        size_t valid = 0;
+        for (size_t block = from; block < to; block += VALIDATE_BLOCK) {
+            size_t end = std::min(block + VALIDATE_BLOCK, to);
+            bool broken = false;
+            for (size_t pos = block; pos < end; pos++) {
+                broken |= (this->slotInvariant(pos) != LIST_INVARIANT_NONE);
+                valid += this->storage[pos].valid;
+            }
+            if (!broken)
+                continue;
+            for (size_t pos = block; pos < end; pos++) {
+                SwiftyListInvariant invariant = this->slotInvariant(pos);
+                if (invariant != LIST_INVARIANT_NONE) {
+                    *failPos = pos;
+                    return invariant;
+                }
+            }
+        }
+        *validCount = valid;
+        return LIST_INVARIANT_NONE;
+    }
+
+    /**
+     * Checks that need walks: counts, the free list and the ring of elements.
+     * Cells have to pass scanSlots() before, so links of elements are in range.
+     * @param validCount - number of valid cells found by the scan
+     */
+    SwiftyListValidation validateWalks(size_t validCount) const {
+        if (validCount != this->size)
+            return {LIST_INVARIANT_SIZE, 0};
+
+        size_t last = this->sumSize();
+        if (this->freeSize != 0) {
+            size_t pos = this->freePtr;
+            size_t previous = pos;
+            size_t length = 0;
+            while (true) {
+                if (pos == 0 || pos > last || this->storage[pos].valid || this->storage[pos].previous != previous)
+                    return {LIST_INVARIANT_FREE_LIST, pos};
+                if (++length > last)
+                    return {LIST_INVARIANT_FREE_LIST, pos};
+                if (this->storage[pos].next == pos)
+                    break;
+                previous = pos;
+                pos = this->storage[pos].next;
+            }
+            if (length != this->freeSize)
+                return {LIST_INVARIANT_FREE_SIZE, pos};
+        }
+
+        if (!this->optimized) {
+            size_t pos = this->storage[0].next;
+            size_t count = 0;
+            while (pos != 0 && count <= this->size) {
+                count++;
+                pos = this->storage[pos].next;
+            }
+            if (count != this->size)
+                return {LIST_INVARIANT_CHAIN, pos};
+        }
+
+        for (size_t index = 1; this->handlesActive() && index <= this->handlesUsed; index++) {
+            size_t handlePos = this->handles[index].pos;
+            if (handlePos != 0 && (!this->addressValid(handlePos) || this->nodeHandle(handlePos) != index))
+                return {LIST_INVARIANT_HANDLES, handlePos};
+        }
+        return {LIST_INVARIANT_NONE, 0};
     }
 
     size_t sumSize() const{
@@ -834,15 +3191,299 @@ public:
     }
 
     bool addressValid(size_t pos) const {
-        return this->storage[pos].valid;
+        return pos <= this->sumSize() && this->storage[pos].valid;
     }
     
+    /**
+     * Releases all resources. Safe to call more than once, the destructor calls it as well.
+     */
     void DestructList(){
-        delete this->params;
         delete this->dumper;
-        free(this->storage);
+        this->releaseOwnStorage();
+        free(this->freeMap);
+        free(this->handles);
+        free(this->nodeHandles);
+        this->dumper = nullptr;
+        this->pool = nullptr;
+        this->storageSource = nullptr;
+        this->freeMap = nullptr;
+        this->handles = nullptr;
+        this->nodeHandles = nullptr;
+        this->handlesCapacity = 0;
+        this->handlesUsed = 0;
+        this->freeHandle = 0;
+        this->nodeHandlesCapacity = 0;
+        this->freeMapWords = 0;
+        this->capacity = 0;
+        this->size = 0;
+        this->freePtr = 0;
+        this->freeSize = 0;
+    }
+};
+
+
+/**
+ * Read-only view of SwiftyList created by SwiftyList::snapshot().
+ * Keeps the storage it was taken from alive, copies share it as well.
+ */
+template<typename ListElem>
+struct SwiftyListSnapshot {
+private:
+    friend struct SwiftyList<ListElem>;
+    using Node = typename SwiftyList<ListElem>::SwiftyListNode;
+
+    const Node          *storage;
+    std::atomic<size_t> *refs;
+    size_t              size;
+    size_t              sumSize;
+    bool                optimized;
+
+    SwiftyListSnapshot(const Node *storage, std::atomic<size_t> *refs, size_t size, size_t sumSize,
+                       bool optimized) : storage(storage), refs(refs), size(size), sumSize(sumSize),
+                                         optimized(optimized) {}
+
+    void release() {
+        if (this->refs != nullptr)
+            SwiftyList<ListElem>::releaseStorage(this->storage, this->refs);
+        this->storage = nullptr;
+        this->refs = nullptr;
+    }
+
+public:
+    SwiftyListSnapshot() : storage(nullptr), refs(nullptr), size(0), sumSize(0), optimized(true) {}
+
+    SwiftyListSnapshot(const SwiftyListSnapshot &other) : storage(other.storage), refs(other.refs),
+                                                          size(other.size), sumSize(other.sumSize),
+                                                          optimized(other.optimized) {
+        if (this->refs != nullptr)
+            this->refs->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SwiftyListSnapshot(SwiftyListSnapshot &&other) noexcept : storage(other.storage), refs(other.refs),
+                                                              size(other.size), sumSize(other.sumSize),
+                                                              optimized(other.optimized) {
+        other.storage = nullptr;
+        other.refs = nullptr;
+    }
+
+    SwiftyListSnapshot &operator=(SwiftyListSnapshot other) noexcept {
+        std::swap(this->storage, other.storage);
+        std::swap(this->refs, other.refs);
+        this->size = other.size;
+        this->sumSize = other.sumSize;
+        this->optimized = other.optimized;
+        return *this;
+    }
+
+    ~SwiftyListSnapshot() {
+        this->release();
+    }
+
+    /**
+     * Get an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult get(size_t pos, ListElem *value) const {
+        if (pos == 0 || pos > this->sumSize || !this->storage[pos].valid)
+            return LIST_OP_SEGFAULT;
+        if (value != nullptr)
+            *value = this->storage[pos].value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem *value) const {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        size_t iterator = pos + 1;
+        if (!this->optimized) {
+            iterator = this->storage[0].next;
+            for (size_t i = 0; i < pos; i++)
+                iterator = this->storage[iterator].next;
+        }
+        return this->get(iterator, value);
+    }
+
+    /**
+     * Calls func(value) for all elements in logical order
+     */
+    template<typename Func>
+    void forEach(Func func) const {
+        size_t iterator = this->begin();
+        for (size_t i = 0; i < this->size; i++) {
+            func(this->storage[iterator].value);
+            iterator = this->storage[iterator].next;
+        }
+    }
+
+    size_t begin() const {
+        return (this->storage == nullptr) ? 0 : this->storage[0].next;
+    }
+
+    size_t nextIterator(size_t pos) const {
+        if (pos > this->sumSize || !this->storage[pos].valid)
+            return 0;
+        return this->storage[pos].next;
+    }
+
+    size_t getSize() const {
+        return this->size;
+    }
+
+    bool isOptimized() const {
+        return this->optimized;
+    }
+
+    bool isEmpty() const {
+        return this->size == 0;
     }
 };
 
+/**
+ * Streaming reader of the binary list format.
+ * Keeps only one chunk in memory, so lists larger than RAM can be processed.
+ * Checksum is verified once the last value is consumed.
+ */
+template<typename ListElem>
+struct SwiftyListReader {
+private:
+    FILE     *file;
+    int      fd;
+    ListElem *chunk;
+    size_t   chunkElems;
+    size_t   chunkUsed;
+    size_t   chunkFilled;
+    size_t   consumed;
+
+    SwiftyListFileHeader header;
+    SwiftyListChecksum   checksum;
+
+    bool readBytes(void *data, size_t len) {
+        if (this->file != nullptr)
+            return fread(data, 1, len, this->file) == len;
+        char *bytes = (char *) data;
+        while (len != 0) {
+            ssize_t done = ::read(this->fd, bytes, len);
+            if (done < 0 && errno == EINTR)
+                continue;
+            if (done <= 0)
+                return false;
+            bytes += done;
+            len -= (size_t) done;
+        }
+        return true;
+    }
+
+    ListOpResult fillChunk() {
+        size_t count = this->header.size - this->consumed - this->chunkFilled;
+        if (count > this->chunkElems)
+            count = this->chunkElems;
+        if (!this->readBytes(this->chunk, count * sizeof(ListElem)))
+            return LIST_OP_IOERROR;
+        this->checksum.update(this->chunk, count * sizeof(ListElem));
+        this->consumed += this->chunkFilled;
+        this->chunkFilled = count;
+        this->chunkUsed = 0;
+        if (this->consumed + this->chunkFilled == this->header.size &&
+            this->checksum.digest() != this->header.checksum)
+            return LIST_OP_CORRUPTED;
+        return LIST_OP_OK;
+    }
+
+public:
+    static_assert(std::is_trivially_copyable<ListElem>::value,
+                  "binary deserialization requires trivially copyable ListElem");
+
+    explicit SwiftyListReader(FILE *file) : file(file), fd(-1), chunk(nullptr), chunkElems(0), chunkUsed(0),
+                                            chunkFilled(0), consumed(0), header() {}
+
+    explicit SwiftyListReader(int fd) : file(nullptr), fd(fd), chunk(nullptr), chunkElems(0), chunkUsed(0),
+                                        chunkFilled(0), consumed(0), header() {}
+
+    SwiftyListReader(const SwiftyListReader &) = delete;
+
+    SwiftyListReader &operator=(const SwiftyListReader &) = delete;
+
+    ~SwiftyListReader() {
+        free(this->chunk);
+    }
+
+    /**
+     * Read and validate the header
+     * @return operation result
+     */
+    ListOpResult open() {
+        if (this->file == nullptr && this->fd < 0)
+            return LIST_OP_SEGFAULT;
+        if (!this->readBytes(&this->header, sizeof(this->header)))
+            return LIST_OP_IOERROR;
+        if (memcmp(this->header.magic, SWIFTY_LIST_FORMAT_MAGIC, sizeof(this->header.magic)) != 0 ||
+            this->header.version == 0 || this->header.version > SWIFTY_LIST_FORMAT_VERSION ||
+            this->header.elemSize != sizeof(ListElem))
+            return LIST_OP_CORRUPTED;
+        this->chunkElems = SERIALIZE_CHUNK_BYTES / sizeof(ListElem) + 1;
+        this->chunk = (ListElem *) malloc(this->chunkElems * sizeof(ListElem));
+        if (this->chunk == nullptr)
+            return LIST_OP_NOMEM;
+        if (this->header.size == 0 && this->checksum.digest() != this->header.checksum)
+            return LIST_OP_CORRUPTED;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Read up to count values
+     * @param values - output array
+     * @param count - maximum number of values
+     * @param read - number of values read, 0 at the end of the list
+     * @return operation result
+     */
+    ListOpResult read(ListElem *values, size_t count, size_t *read) {
+        *read = 0;
+        while (*read < count) {
+            if (this->chunkUsed == this->chunkFilled) {
+                if (this->consumed + this->chunkFilled == this->header.size)
+                    break;
+                ListOpResult res = this->fillChunk();
+                if (res != LIST_OP_OK)
+                    return res;
+            }
+            size_t take = this->chunkFilled - this->chunkUsed;
+            if (take > count - *read)
+                take = count - *read;
+            memcpy(values + *read, this->chunk + this->chunkUsed, take * sizeof(ListElem));
+            this->chunkUsed += take;
+            *read += take;
+        }
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Read next value
+     * @param value - retrieved value
+     * @return operation result, LIST_OP_UNDERFLOW at the end of the list
+     */
+    ListOpResult next(ListElem *value) {
+        size_t read = 0;
+        ListOpResult res = this->read(value, 1, &read);
+        if (res != LIST_OP_OK)
+            return res;
+        return (read == 1) ? LIST_OP_OK : LIST_OP_UNDERFLOW;
+    }
+
+    size_t getSize() const {
+        return this->header.size;
+    }
+
+    uint32_t getVersion() const {
+        return this->header.version;
+    }
+};
 
 #endif /* SwiftyList_hpp */
@@ -0,0 +1,230 @@
+/**
+ * SwiftyListPool - slab arena many lists take their storage from
+ *
+ * Storage segments are carved from large slabs and rounded up to size classes
+ * with four steps per power of two, so a segment wastes at most a quarter of
+ * its size and lists attached to a pool grow by one class (about 25%) instead
+ * of doubling. Released segments are kept in per-class free lists and reused.
+ *
+ * reset() drops all segments at once and keeps slabs for reuse. Lists whose
+ * storage was taken before the reset must not be used anymore, they can only
+ * be destroyed (DestructList() does not return their segments to the pool).
+ *
+ * The pool is not thread-safe.
+ */
+
+#ifndef SwiftyListPool_hpp
+#define SwiftyListPool_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+const size_t POOL_DEFAULT_SLAB_BYTES = 1 << 20;
+const size_t POOL_MIN_SEGMENT_BYTES  = 64;
+const size_t POOL_MAX_EXPONENT       = 48;
+const size_t POOL_CLASSES            = (POOL_MAX_EXPONENT - 6) * 4 + 1;
+
+struct SwiftyListPool {
+private:
+    /**
+     * Precedes every segment, keeps nodes aligned as malloc would
+     */
+    struct alignas(std::max_align_t) SegmentHeader {
+        uint32_t sizeClass;
+        uint32_t released;
+    };
+
+    struct Slab {
+        char   *memory;
+        size_t bytes;
+    };
+
+    Slab   *slabs;
+    size_t slabsCount;
+    size_t slabsCapacity;
+    size_t currentSlab;
+    size_t slabOffset;
+    size_t slabBytes;
+    void   *freeSegments[POOL_CLASSES];
+    size_t generation;
+    size_t reservedBytes;
+    size_t liveBytes;
+    size_t liveSegments;
+
+    static size_t classBytes(size_t sizeClass) {
+        if (sizeClass == 0)
+            return POOL_MIN_SEGMENT_BYTES;
+        size_t exponent = 6 + (sizeClass - 1) / 4;
+        size_t step = (sizeClass - 1) % 4 + 1;
+        return (size_t(1) << exponent) + step * (size_t(1) << (exponent - 2));
+    }
+
+    static size_t classOf(size_t bytes) {
+        if (bytes <= POOL_MIN_SEGMENT_BYTES)
+            return 0;
+        size_t exponent = 63 - __builtin_clzll((unsigned long long) (bytes - 1));
+        size_t quarter = size_t(1) << (exponent - 2);
+        size_t step = (bytes - (size_t(1) << exponent) + quarter - 1) / quarter;
+        return (exponent - 6) * 4 + step;
+    }
+
+    /**
+     * Bump allocates from the current slab, moves to the next slab that fits or adds a new one
+     */
+    char *carve(size_t bytes) {
+        while (this->currentSlab < this->slabsCount) {
+            Slab &slab = this->slabs[this->currentSlab];
+            if (slab.bytes - this->slabOffset >= bytes) {
+                char *result = slab.memory + this->slabOffset;
+                this->slabOffset += bytes;
+                return result;
+            }
+            this->currentSlab++;
+            this->slabOffset = 0;
+        }
+        if (this->slabsCount == this->slabsCapacity) {
+            size_t newCapacity = (this->slabsCapacity == 0) ? 8 : this->slabsCapacity * 2;
+            auto *newSlabs = (Slab *) realloc(this->slabs, newCapacity * sizeof(Slab));
+            if (newSlabs == nullptr)
+                return nullptr;
+            this->slabs = newSlabs;
+            this->slabsCapacity = newCapacity;
+        }
+        size_t newBytes = (bytes > this->slabBytes) ? bytes : this->slabBytes;
+        char *memory = (char *) malloc(newBytes);
+        if (memory == nullptr)
+            return nullptr;
+        this->slabs[this->slabsCount++] = {memory, newBytes};
+        this->reservedBytes += newBytes;
+        this->currentSlab = this->slabsCount - 1;
+        this->slabOffset = bytes;
+        return memory;
+    }
+
+public:
+    /**
+     * @param slabBytes - size of slabs segments are carved from, larger segments get their own slab
+     */
+    explicit SwiftyListPool(size_t slabBytes = POOL_DEFAULT_SLAB_BYTES) : slabs(nullptr), slabsCount(0),
+                                                                       slabsCapacity(0), currentSlab(0),
+                                                                       slabOffset(0), slabBytes(slabBytes),
+                                                                       freeSegments(), generation(0),
+                                                                       reservedBytes(0), liveBytes(0),
+                                                                       liveSegments(0) {}
+
+    SwiftyListPool(const SwiftyListPool &) = delete;
+
+    SwiftyListPool &operator=(const SwiftyListPool &) = delete;
+
+    ~SwiftyListPool() {
+        for (size_t i = 0; i < this->slabsCount; i++)
+            free(this->slabs[i].memory);
+        free(this->slabs);
+    }
+
+    /**
+     * Takes a segment of at least bytes
+     * @param bytes - requested size
+     * @param actualBytes - usable size of the segment, may be nullptr
+     * @return segment or nullptr if there is no memory
+     */
+    void *allocate(size_t bytes, size_t *actualBytes = nullptr) {
+        size_t sizeClass = classOf(bytes);
+        if (sizeClass >= POOL_CLASSES)
+            return nullptr;
+        // a released segment up to twice as large is better than new memory, the rest is slack for growth
+        for (size_t larger = 1; larger <= 4 && this->freeSegments[sizeClass] == nullptr; larger++) {
+            if (sizeClass + larger < POOL_CLASSES && this->freeSegments[sizeClass + larger] != nullptr)
+                sizeClass += larger;
+        }
+        size_t segmentBytes = classBytes(sizeClass);
+        void *segment = this->freeSegments[sizeClass];
+        if (segment != nullptr) {
+            memcpy(&this->freeSegments[sizeClass], segment, sizeof(void *));
+        } else {
+            char *memory = this->carve(sizeof(SegmentHeader) + segmentBytes);
+            if (memory == nullptr)
+                return nullptr;
+            segment = memory + sizeof(SegmentHeader);
+        }
+        SegmentHeader *header = (SegmentHeader *) segment - 1;
+        header->sizeClass = (uint32_t) sizeClass;
+        header->released = 0;
+        this->liveBytes += segmentBytes;
+        this->liveSegments++;
+        if (actualBytes != nullptr)
+            *actualBytes = segmentBytes;
+        return segment;
+    }
+
+    /**
+     * Returns the segment to its class free list
+     */
+    void release(void *segment) {
+        if (segment == nullptr)
+            return;
+        SegmentHeader *header = (SegmentHeader *) segment - 1;
+        if (header->released)
+            return;
+        header->released = 1;
+        memcpy(segment, &this->freeSegments[header->sizeClass], sizeof(void *));
+        this->freeSegments[header->sizeClass] = segment;
+        this->liveBytes -= classBytes(header->sizeClass);
+        this->liveSegments--;
+    }
+
+    /**
+     * Drops all segments at once, slabs are kept and reused.
+     * Lists that took storage before must only be destroyed afterwards.
+     */
+    void reset() {
+        memset(this->freeSegments, 0, sizeof(this->freeSegments));
+        this->currentSlab = 0;
+        this->slabOffset = 0;
+        this->liveBytes = 0;
+        this->liveSegments = 0;
+        this->generation++;
+    }
+
+    /**
+     * Changes on every reset, lists compare it to know that their segment is gone
+     */
+    size_t getGeneration() const {
+        return this->generation;
+    }
+
+    /**
+     * Bytes of all slabs
+     */
+    size_t getReservedBytes() const {
+        return this->reservedBytes;
+    }
+
+    /**
+     * Bytes of segments given out and not released
+     */
+    size_t getLiveBytes() const {
+        return this->liveBytes;
+    }
+
+    size_t getLiveSegments() const {
+        return this->liveSegments;
+    }
+
+    size_t getSlabsCount() const {
+        return this->slabsCount;
+    }
+
+    /**
+     * Share of reserved memory held by live segments
+     */
+    double occupancy() const {
+        if (this->reservedBytes == 0)
+            return 0;
+        return (double) this->liveBytes / (double) this->reservedBytes;
+    }
+};
+
+#endif /* SwiftyListPool_hpp */
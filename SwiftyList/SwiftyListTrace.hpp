@@ -0,0 +1,234 @@
+/**
+ * SwiftyListTrace - compact binary trace of list operations
+ *
+ * Trace is a header followed by records. Every record is one byte of operation,
+ * its position arguments as LEB128 varints and the raw value for operations
+ * that take one. SwiftyListTraceWriter records a list after list.setRecorder(&writer),
+ * SwiftyListTraceReader reads the trace back, e.g. for SwiftyListReplay. Mutations without
+ * their own record are written as "unrecorded" markers, replay stops at the first one.
+ */
+
+#ifndef SwiftyListTrace_hpp
+#define SwiftyListTrace_hpp
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "SwiftyList.hpp"
+
+const uint32_t SWIFTY_TRACE_FORMAT_VERSION = 2;
+const char     SWIFTY_TRACE_FORMAT_MAGIC[4] = {'S', 'W', 'T', 'R'};
+
+struct SwiftyListTraceHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t elemSize;
+};
+
+/**
+ * Arguments stored for every operation
+ */
+struct SwiftyListTraceOpInfo {
+    const char *name;
+    bool       hasFirst;
+    bool       hasSecond;
+    bool       hasValue;
+};
+
+inline const SwiftyListTraceOpInfo &traceOpInfo(SwiftyListTraceOp op) {
+    static const SwiftyListTraceOpInfo info[TRACE_OP_COUNT] = {
+            {"unknown",           false, false, false},
+            {"initial",           true,  true,  true},
+            {"insertAfter",       true,  true,  true},
+            {"insertAfterLogic",  true,  true,  true},
+            {"insertBefore",      true,  true,  true},
+            {"insertBeforeLogic", true,  true,  true},
+            {"pushFront",         false, true,  true},
+            {"pushBack",          false, true,  true},
+            {"set",               true,  false, true},
+            {"setLogic",          true,  false, true},
+            {"get",               true,  false, false},
+            {"getLogic",          true,  false, false},
+            {"pop",               true,  false, false},
+            {"popFront",          false, false, false},
+            {"popBack",           false, false, false},
+            {"popLogic",          true,  false, false},
+            {"remove",            true,  false, false},
+            {"removeLogic",       true,  false, false},
+            {"swap",              true,  true,  false},
+            {"swapLogic",         true,  true,  false},
+            {"clear",             false, false, false},
+            {"optimize",          false, false, false},
+            {"search",            false, false, true},
+            {"searchLogic",       false, false, true},
+            {"moveAfter",         true,  true,  false},
+            {"unrecorded",        false, false, false},
+    };
+    return info[(op > 0 && op < TRACE_OP_COUNT) ? op : 0];
+}
+
+/**
+ * Recorder writing the trace to a stream
+ */
+struct SwiftyListTraceWriter : SwiftyListRecorder {
+private:
+    FILE   *file;
+    size_t elemSize;
+    size_t records;
+    bool   failed;
+
+    void writeVarint(size_t number) {
+        unsigned char bytes[10];
+        size_t count = 0;
+        do {
+            bytes[count] = number & 0x7F;
+            number >>= 7;
+            if (number != 0)
+                bytes[count] |= 0x80;
+            count++;
+        } while (number != 0);
+        this->write(bytes, count);
+    }
+
+    void write(const void *data, size_t len) {
+        if (!this->failed && fwrite(data, 1, len, this->file) != len)
+            this->failed = true;
+    }
+
+public:
+    /**
+     * Writes the trace header
+     * @param file - output stream
+     * @param elemSize - sizeof(ListElem) of the recorded list
+     */
+    SwiftyListTraceWriter(FILE *file, size_t elemSize) : file(file), elemSize(elemSize), records(0),
+                                                         failed(file == nullptr) {
+        SwiftyListTraceHeader header = {};
+        memcpy(header.magic, SWIFTY_TRACE_FORMAT_MAGIC, sizeof(header.magic));
+        header.version = SWIFTY_TRACE_FORMAT_VERSION;
+        header.elemSize = (uint32_t) elemSize;
+        this->write(&header, sizeof(header));
+    }
+
+    void record(SwiftyListTraceOp op, size_t first, size_t second, const void *value) override {
+        const SwiftyListTraceOpInfo &info = traceOpInfo(op);
+        unsigned char opByte = (unsigned char) op;
+        this->write(&opByte, 1);
+        if (info.hasFirst)
+            this->writeVarint(first);
+        if (info.hasSecond)
+            this->writeVarint(second);
+        if (info.hasValue)
+            this->write(value, this->elemSize);
+        this->records++;
+    }
+
+    /**
+     * Flushes buffered records
+     * @return operation result
+     */
+    ListOpResult flush() {
+        if (this->failed || fflush(this->file) != 0)
+            return LIST_OP_IOERROR;
+        return LIST_OP_OK;
+    }
+
+    size_t getRecordsCount() const {
+        return this->records;
+    }
+};
+
+/**
+ * One operation read from the trace
+ */
+struct SwiftyListTraceRecord {
+    SwiftyListTraceOp op;
+    size_t            first;
+    size_t            second;
+    const void        *value;
+};
+
+/**
+ * Sequential reader of the trace
+ */
+struct SwiftyListTraceReader {
+private:
+    FILE          *file;
+    unsigned char *value;
+    size_t        elemSize;
+
+    bool readVarint(size_t *number) {
+        *number = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            int byte = fgetc(this->file);
+            if (byte == EOF)
+                return false;
+            *number |= (size_t) (byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+public:
+    explicit SwiftyListTraceReader(FILE *file) : file(file), value(nullptr), elemSize(0) {}
+
+    SwiftyListTraceReader(const SwiftyListTraceReader &) = delete;
+
+    SwiftyListTraceReader &operator=(const SwiftyListTraceReader &) = delete;
+
+    ~SwiftyListTraceReader() {
+        free(this->value);
+    }
+
+    /**
+     * Reads and checks the header
+     * @return operation result
+     */
+    ListOpResult open() {
+        SwiftyListTraceHeader header = {};
+        if (this->file == nullptr || fread(&header, sizeof(header), 1, this->file) != 1)
+            return LIST_OP_IOERROR;
+        if (memcmp(header.magic, SWIFTY_TRACE_FORMAT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version == 0 || header.version > SWIFTY_TRACE_FORMAT_VERSION || header.elemSize == 0)
+            return LIST_OP_CORRUPTED;
+        this->elemSize = header.elemSize;
+        free(this->value);
+        this->value = (unsigned char *) malloc(this->elemSize);
+        return (this->value == nullptr) ? LIST_OP_NOMEM : LIST_OP_OK;
+    }
+
+    /**
+     * Reads the next record. Record value is valid until the next call.
+     * @param record - retrieved record
+     * @return operation result, LIST_OP_UNDERFLOW at the end of the trace
+     */
+    ListOpResult next(SwiftyListTraceRecord *record) {
+        int opByte = fgetc(this->file);
+        if (opByte == EOF)
+            return LIST_OP_UNDERFLOW;
+        if (opByte <= 0 || opByte >= TRACE_OP_COUNT)
+            return LIST_OP_CORRUPTED;
+        record->op = (SwiftyListTraceOp) opByte;
+        record->first = 0;
+        record->second = 0;
+        record->value = nullptr;
+        const SwiftyListTraceOpInfo &info = traceOpInfo(record->op);
+        if (info.hasFirst && !this->readVarint(&record->first))
+            return LIST_OP_CORRUPTED;
+        if (info.hasSecond && !this->readVarint(&record->second))
+            return LIST_OP_CORRUPTED;
+        if (info.hasValue) {
+            if (fread(this->value, 1, this->elemSize, this->file) != this->elemSize)
+                return LIST_OP_CORRUPTED;
+            record->value = this->value;
+        }
+        return LIST_OP_OK;
+    }
+
+    size_t getElemSize() const {
+        return this->elemSize;
+    }
+};
+
+#endif /* SwiftyListTrace_hpp */
@@ -0,0 +1,359 @@
+/**
+ * SwiftyParallel - parallel algorithms over SwiftyList
+ *
+ * Optimized lists are split into contiguous chunks of storage.
+ * De-optimized lists are split by sampled splitter nodes: every task starts at
+ * its splitter and walks the chain until it meets the next splitter, so tasks
+ * cover disjoint segments. Segment results are combined in logical order.
+ *
+ * The list must not be modified concurrently.
+ */
+
+#ifndef SwiftyParallel_hpp
+#define SwiftyParallel_hpp
+
+#include <algorithm>
+#include <vector>
+#include "SwiftyList.hpp"
+#include "SwiftyThreadPool.hpp"
+
+const size_t PARALLEL_MIN_CHUNK = 4096;
+const size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+
+struct SwiftyListAlgorithms {
+    /**
+     * Part of the list processed by one task
+     */
+    struct Segment {
+        size_t first;
+        size_t count;
+        size_t end;
+    };
+
+    /**
+     * Splits the list into segments. In de-optimized mode count is unknown
+     * until the segment is walked and splitter marks are filled.
+     */
+    template<typename ListElem>
+    static std::vector<Segment> split(const SwiftyList<ListElem> &list, size_t threads,
+                                      std::vector<uint64_t> &marks) {
+        std::vector<Segment> segments;
+        size_t size = list.size;
+        if (size == 0)
+            return segments;
+        size_t parts = threads * PARALLEL_CHUNKS_PER_THREAD;
+        if (parts > size / PARALLEL_MIN_CHUNK)
+            parts = size / PARALLEL_MIN_CHUNK;
+        if (parts == 0)
+            parts = 1;
+
+        if (list.optimized) {
+            size_t chunk = (size + parts - 1) / parts;
+            for (size_t first = 1; first <= size; first += chunk)
+                segments.push_back({first, std::min(chunk, size + 1 - first), 0});
+            return segments;
+        }
+
+        size_t sumSize = list.sumSize();
+        marks.assign(sumSize / 64 + 1, 0);
+        auto mark = [&](size_t pos) {
+            if (marks[pos / 64] & (uint64_t(1) << (pos % 64)))
+                return;
+            marks[pos / 64] |= uint64_t(1) << (pos % 64);
+            segments.push_back({pos, 0, 0});
+        };
+        mark(list.storage[0].next);
+        size_t step = sumSize / parts + 1;
+        for (size_t pos = 1; pos <= sumSize; pos += step) {
+            if (list.storage[pos].valid)
+                mark(pos);
+        }
+        return segments;
+    }
+
+    /**
+     * Gives the list its own storage if it is shared with snapshots
+     */
+    template<typename ListElem>
+    static ListOpResult detach(SwiftyList<ListElem> &list) {
+        return list.detach();
+    }
+
+    /**
+     * Values of lists with handles must not be moved between nodes
+     */
+    template<typename ListElem>
+    static bool hasHandles(const SwiftyList<ListElem> &list) {
+        return list.handlesActive();
+    }
+
+    static bool marked(const std::vector<uint64_t> &marks, size_t pos) {
+        return (marks[pos / 64] >> (pos % 64)) & 1;
+    }
+
+    /**
+     * Calls visit(value) for every value of the segment. Fills segment count and end.
+     */
+    template<typename ListElem, typename Visit>
+    static void walk(SwiftyList<ListElem> &list, const std::vector<uint64_t> &marks, Segment &segment,
+                     Visit visit) {
+        auto *storage = list.storage;
+        if (list.optimized) {
+            for (size_t i = 0; i < segment.count; i++)
+                visit(storage[segment.first + i].value);
+            return;
+        }
+        size_t pos = segment.first;
+        size_t count = 0;
+        do {
+            visit(storage[pos].value);
+            count++;
+            pos = storage[pos].next;
+        } while (pos != 0 && !marked(marks, pos));
+        segment.count = count;
+        segment.end = pos;
+    }
+
+    /**
+     * Logical order of segments. Optimized segments are already in order,
+     * de-optimized ones are chained by their end splitters.
+     */
+    template<typename ListElem>
+    static std::vector<size_t> order(const SwiftyList<ListElem> &list, const std::vector<Segment> &segments) {
+        std::vector<size_t> result;
+        if (list.optimized || segments.empty()) {
+            for (size_t i = 0; i < segments.size(); i++)
+                result.push_back(i);
+            return result;
+        }
+        std::vector<std::pair<size_t, size_t>> byFirst;
+        for (size_t i = 0; i < segments.size(); i++)
+            byFirst.emplace_back(segments[i].first, i);
+        std::sort(byFirst.begin(), byFirst.end());
+        size_t pos = list.storage[0].next;
+        while (pos != 0) {
+            auto found = std::lower_bound(byFirst.begin(), byFirst.end(), std::make_pair(pos, size_t(0)));
+            result.push_back(found->second);
+            pos = segments[found->second].end;
+        }
+        return result;
+    }
+
+    /**
+     * Runs segmentTask(index, each) for every segment on the pool, each(visit) calls
+     * visit(value) for every value of the segment. prepare(segmentsCount) is called before.
+     * @return segments in logical order
+     */
+    template<typename ListElem, typename Prepare, typename SegmentTask>
+    static std::vector<size_t> run(SwiftyList<ListElem> &list, SwiftyThreadPool &pool, Prepare prepare,
+                                   SegmentTask segmentTask) {
+        std::vector<uint64_t> marks;
+        std::vector<Segment> segments = split(list, pool.getThreadsCount(), marks);
+        prepare(segments.size());
+        auto task = [&](size_t i) {
+            segmentTask(i, [&](auto visit) { walk(list, marks, segments[i], visit); });
+        };
+        {
+            SwiftyThreadPool::TaskGroup group(pool);
+            for (size_t i = 1; i < segments.size(); i++)
+                group.run([&task, i]() { task(i); });
+            if (!segments.empty())
+                task(0);
+            group.wait();
+        }
+        return order(list, segments);
+    }
+
+    /**
+     * SwiftyList::validate() with the storage scan split into chunks run by separate tasks.
+     * The first failing cell of the lowest chunk is reported, as the sequential scan would.
+     */
+    template<typename ListElem>
+    static SwiftyListValidation validate(const SwiftyList<ListElem> &list, SwiftyThreadPool &pool) {
+        if (list.sumSize() > list.capacity)
+            return {LIST_INVARIANT_CAPACITY, 0};
+        size_t cells = list.sumSize() + 1;
+        size_t parts = pool.getThreadsCount() * PARALLEL_CHUNKS_PER_THREAD;
+        if (parts > cells / PARALLEL_MIN_CHUNK)
+            parts = cells / PARALLEL_MIN_CHUNK;
+        if (parts == 0)
+            parts = 1;
+        size_t chunk = (cells + parts - 1) / parts;
+        std::vector<size_t> validCounts(parts, 0);
+        std::vector<SwiftyListValidation> failures(parts, {LIST_INVARIANT_NONE, 0});
+        auto task = [&](size_t i) {
+            size_t from = std::min(i * chunk, cells);
+            failures[i].invariant = list.scanSlots(from, std::min(from + chunk, cells), &validCounts[i],
+                                                   &failures[i].pos);
+        };
+        {
+            SwiftyThreadPool::TaskGroup group(pool);
+            for (size_t i = 1; i < parts; i++)
+                group.run([&task, i]() { task(i); });
+            task(0);
+            group.wait();
+        }
+        size_t validCount = 0;
+        for (size_t i = 0; i < parts; i++) {
+            if (failures[i].invariant != LIST_INVARIANT_NONE)
+                return failures[i];
+            validCount += validCounts[i];
+        }
+        return list.validateWalks(validCount);
+    }
+
+    /**
+     * Parallel stable merge sort of optimized list values. Chunks are sorted by separate tasks,
+     * then neighbouring runs are merged pairwise, every merge of a round being a separate task.
+     */
+    template<typename ListElem, typename Compare>
+    static void sort(SwiftyList<ListElem> &list, Compare &comp, SwiftyThreadPool &pool) {
+        auto first = list.valuesBegin();
+        size_t size = list.size;
+        size_t parts = pool.getThreadsCount() * PARALLEL_CHUNKS_PER_THREAD;
+        if (parts > size / PARALLEL_MIN_CHUNK)
+            parts = size / PARALLEL_MIN_CHUNK;
+        if (parts < 2) {
+            std::stable_sort(first, first + size, comp);
+            return;
+        }
+        std::vector<size_t> bounds(parts + 1);
+        for (size_t i = 0; i <= parts; i++)
+            bounds[i] = size / parts * i + std::min(i, size % parts);
+        {
+            SwiftyThreadPool::TaskGroup group(pool);
+            for (size_t i = 0; i < parts; i++)
+                group.run([&, i]() { std::stable_sort(first + bounds[i], first + bounds[i + 1], comp); });
+            group.wait();
+        }
+        for (size_t width = 1; width < parts; width *= 2) {
+            SwiftyThreadPool::TaskGroup group(pool);
+            for (size_t i = 0; i + width < parts; i += 2 * width) {
+                size_t last = std::min(i + 2 * width, parts);
+                group.run([&, i, width, last]() {
+                    std::inplace_merge(first + bounds[i], first + bounds[i + width], first + bounds[last], comp);
+                });
+            }
+            group.wait();
+        }
+    }
+};
+
+/**
+ * Calls func(value) for every element in parallel. Value is passed by reference and can be modified.
+ * @return operation result
+ */
+template<typename ListElem, typename Func>
+ListOpResult parallelForEach(SwiftyList<ListElem> &list, Func func,
+                             SwiftyThreadPool &pool = SwiftyThreadPool::shared()) {
+    ListOpResult res = SwiftyListAlgorithms::detach(list);
+    if (res != LIST_OP_OK)
+        return res;
+    SwiftyListAlgorithms::run(list, pool, [](size_t) {}, [&](size_t, auto each) {
+        each([&](ListElem &value) { func(value); });
+    });
+    return LIST_OP_OK;
+}
+
+/**
+ * Replaces every element with func(element) in parallel
+ * @return operation result
+ */
+template<typename ListElem, typename Func>
+ListOpResult parallelTransform(SwiftyList<ListElem> &list, Func func,
+                               SwiftyThreadPool &pool = SwiftyThreadPool::shared()) {
+    ListOpResult res = SwiftyListAlgorithms::detach(list);
+    if (res != LIST_OP_OK)
+        return res;
+    SwiftyListAlgorithms::run(list, pool, [](size_t) {}, [&](size_t, auto each) {
+        each([&](ListElem &value) { value = func(value); });
+    });
+    return LIST_OP_OK;
+}
+
+/**
+ * Folds elements with associative combine in parallel. Partial results are combined in logical order,
+ * so combine does not have to be commutative. combine is called both as
+ * combine(Result, ListElem) and combine(Result, Result).
+ * @param result - combine(...combine(combine(identity, e0), e1)..., en)
+ * @param identity - neutral element of combine
+ * @return operation result
+ */
+template<typename ListElem, typename Result, typename Combine>
+ListOpResult parallelReduce(SwiftyList<ListElem> &list, Result *result, Result identity, Combine combine,
+                            SwiftyThreadPool &pool = SwiftyThreadPool::shared()) {
+    if (result == nullptr)
+        return LIST_OP_SEGFAULT;
+    std::vector<Result> partial;
+    std::vector<size_t> order = SwiftyListAlgorithms::run(list, pool, [&](size_t segments) {
+        partial.assign(segments, identity);
+    }, [&](size_t segment, auto each) {
+        Result accumulated = identity;
+        each([&](ListElem &value) { accumulated = combine(accumulated, value); });
+        partial[segment] = accumulated;
+    });
+    Result total = identity;
+    for (size_t segment : order)
+        total = combine(total, partial[segment]);
+    *result = total;
+    return LIST_OP_OK;
+}
+
+/**
+ * Counts elements satisfying pred in parallel
+ * @param count - number of matching elements
+ * @return operation result
+ */
+template<typename ListElem, typename Pred>
+ListOpResult parallelCountIf(SwiftyList<ListElem> &list, size_t *count, Pred pred,
+                             SwiftyThreadPool &pool = SwiftyThreadPool::shared()) {
+    if (count == nullptr)
+        return LIST_OP_SEGFAULT;
+    std::vector<size_t> partial;
+    SwiftyListAlgorithms::run(list, pool, [&](size_t segments) {
+        partial.assign(segments, 0);
+    }, [&](size_t segment, auto each) {
+        size_t matched = 0;
+        each([&](ListElem &value) { matched += pred(value) ? 1 : 0; });
+        partial[segment] = matched;
+    });
+    *count = 0;
+    for (size_t matched : partial)
+        *count += matched;
+    return LIST_OP_OK;
+}
+
+/**
+ * Validates the list structure like SwiftyList::validate(), scanning storage in parallel
+ * @param report - first violated invariant, may be nullptr
+ * @return operation result
+ */
+template<typename ListElem>
+ListOpResult parallelValidate(const SwiftyList<ListElem> &list, SwiftyListValidation *report = nullptr,
+                              SwiftyThreadPool &pool = SwiftyThreadPool::shared()) {
+    SwiftyListValidation found = SwiftyListAlgorithms::validate(list, pool);
+    if (report != nullptr)
+        *report = found;
+    return found.invariant == LIST_INVARIANT_NONE ? LIST_OP_OK : LIST_OP_CORRUPTED;
+}
+
+/**
+ * Stable sort of the list in parallel. De-optimized list is optimized first,
+ * so the sort always works on contiguous values. List is optimized afterwards.
+ * Lists with handles are sorted by relinking nodes with SwiftyList::sort, so handles follow their elements.
+ * @param comp - strict weak ordering of values
+ * @return operation result
+ */
+template<typename ListElem, typename Compare = std::less<ListElem>>
+ListOpResult parallelSort(SwiftyList<ListElem> &list, Compare comp = Compare(),
+                          SwiftyThreadPool &pool = SwiftyThreadPool::shared()) {
+    if (SwiftyListAlgorithms::hasHandles(list))
+        return list.sort(comp);
+    ListOpResult res = list.isOptimized() ? SwiftyListAlgorithms::detach(list) : list.optimize();
+    if (res != LIST_OP_OK)
+        return res;
+    SwiftyListAlgorithms::sort(list, comp, pool);
+    return LIST_OP_OK;
+}
+
+#endif /* SwiftyParallel_hpp */
@@ -0,0 +1,455 @@
+/**
+ * SwiftyParallelList - SwiftyList that several threads can mutate at once
+ *
+ * Free cells are kept in a lock-free stack (Treiber stack with tagged head, so
+ * it is ABA-safe) and every thread works through its own Worker that caches
+ * a batch of free cells. Links are updated under per-node spin locks taken with
+ * try-lock only, so threads inserting and popping in disjoint regions do not
+ * wait for each other and lock order can never deadlock.
+ *
+ * Storage consists of geometrically growing segments that are never moved,
+ * so growth does not invalidate cells other threads are working with.
+ * Physical positions are limited to 32 bits.
+ */
+
+#ifndef SwiftyParallelList_hpp
+#define SwiftyParallelList_hpp
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "SwiftyList.hpp"
+
+const size_t   PARALLEL_SEGMENT_BITS = 10;
+const size_t   PARALLEL_SEGMENTS = 40;
+const size_t   PARALLEL_CACHE_BATCH = 64;
+const uint32_t PARALLEL_NIL = 0xFFFFFFFFu;
+
+template<typename ListElem>
+struct SwiftyParallelList {
+private:
+    struct Node {
+        ListElem              value;
+        std::atomic<size_t>   next;
+        std::atomic<size_t>   previous;
+        std::atomic<uint32_t> freeNext;
+        std::atomic<bool>     locked;
+        std::atomic<bool>     valid;
+    };
+
+    std::atomic<Node *>   segments[PARALLEL_SEGMENTS];
+    std::mutex            growthMutex;
+    std::atomic<size_t>   highWater;
+    std::atomic<uint64_t> freeHead;
+    std::atomic<size_t>   size;
+
+    static uint64_t packFree(uint32_t index, uint32_t tag) {
+        return ((uint64_t) tag << 32) | index;
+    }
+
+    static size_t segmentOf(size_t pos) {
+        return 63 - __builtin_clzll((pos >> PARALLEL_SEGMENT_BITS) + 1);
+    }
+
+    static size_t segmentStart(size_t segment) {
+        return ((size_t(1) << segment) - 1) << PARALLEL_SEGMENT_BITS;
+    }
+
+    Node &node(size_t pos) const {
+        size_t segment = segmentOf(pos);
+        return this->segments[segment].load(std::memory_order_acquire)[pos - segmentStart(segment)];
+    }
+
+    /**
+     * Makes sure cells up to pos are allocated. Segments are never moved.
+     */
+    bool ensureAllocated(size_t pos) {
+        size_t segment = segmentOf(pos);
+        if (segment >= PARALLEL_SEGMENTS || pos >= PARALLEL_NIL)
+            return false;
+        if (this->segments[segment].load(std::memory_order_acquire) != nullptr)
+            return true;
+        std::lock_guard<std::mutex> guard(this->growthMutex);
+        for (size_t i = 0; i <= segment; i++) {
+            if (this->segments[i].load(std::memory_order_relaxed) != nullptr)
+                continue;
+            Node *cells = new(std::nothrow) Node[(size_t(1) << i) << PARALLEL_SEGMENT_BITS]();
+            if (cells == nullptr)
+                return false;
+            this->segments[i].store(cells, std::memory_order_release);
+        }
+        return true;
+    }
+
+    /**
+     * Pops one cell from the shared free stack
+     * @return cell or PARALLEL_NIL if the stack is empty
+     */
+    uint32_t popFree() {
+        uint64_t head = this->freeHead.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t index = (uint32_t) head;
+            if (index == PARALLEL_NIL)
+                return PARALLEL_NIL;
+            uint32_t next = this->node(index).freeNext.load(std::memory_order_relaxed);
+            if (this->freeHead.compare_exchange_weak(head, packFree(next, (uint32_t) (head >> 32) + 1),
+                                                     std::memory_order_acquire, std::memory_order_acquire))
+                return index;
+        }
+    }
+
+    /**
+     * Pushes a chain of cells linked through freeNext with a single CAS
+     */
+    void pushFreeChain(uint32_t first, uint32_t last) {
+        uint64_t head = this->freeHead.load(std::memory_order_relaxed);
+        do {
+            this->node(last).freeNext.store((uint32_t) head, std::memory_order_relaxed);
+        } while (!this->freeHead.compare_exchange_weak(head, packFree(first, (uint32_t) (head >> 32) + 1),
+                                                       std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    bool tryLock(size_t pos) {
+        return !this->node(pos).locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock(size_t pos) {
+        this->node(pos).locked.store(false, std::memory_order_release);
+    }
+
+public:
+    /**
+     * Per-thread access point. Keeps a local batch of free cells, so most
+     * inserts and pops do not touch shared allocation state at all.
+     * Must be used by one thread at a time.
+     */
+    struct Worker {
+    private:
+        SwiftyParallelList<ListElem> *list;
+        uint32_t cache[2 * PARALLEL_CACHE_BATCH];
+        size_t   cached;
+
+        ListOpResult refill() {
+            while (this->cached < PARALLEL_CACHE_BATCH) {
+                uint32_t pos = this->list->popFree();
+                if (pos == PARALLEL_NIL)
+                    break;
+                this->cache[this->cached++] = pos;
+            }
+            if (this->cached != 0)
+                return LIST_OP_OK;
+            size_t first = this->list->highWater.fetch_add(PARALLEL_CACHE_BATCH, std::memory_order_relaxed);
+            if (!this->list->ensureAllocated(first + PARALLEL_CACHE_BATCH - 1))
+                return LIST_OP_NOMEM;
+            for (size_t i = 0; i < PARALLEL_CACHE_BATCH; i++)
+                this->cache[this->cached++] = (uint32_t) (first + PARALLEL_CACHE_BATCH - 1 - i);
+            return LIST_OP_OK;
+        }
+
+        void release(size_t pos) {
+            if (this->cached == 2 * PARALLEL_CACHE_BATCH)
+                this->flush(PARALLEL_CACHE_BATCH);
+            this->cache[this->cached++] = (uint32_t) pos;
+        }
+
+        void flush(size_t count) {
+            if (count == 0)
+                return;
+            size_t from = this->cached - count;
+            for (size_t i = from; i + 1 < this->cached; i++)
+                this->list->node(this->cache[i]).freeNext.store(this->cache[i + 1], std::memory_order_relaxed);
+            this->list->pushFreeChain(this->cache[from], this->cache[this->cached - 1]);
+            this->cached = from;
+        }
+
+    public:
+        explicit Worker(SwiftyParallelList<ListElem> *list) : list(list), cache(), cached(0) {}
+
+        Worker(const Worker &) = delete;
+
+        Worker &operator=(const Worker &) = delete;
+
+        ~Worker() {
+            this->flush(this->cached);
+        }
+
+        /**
+         * Insert an element after pos
+         * @param pos - physical pos of considered element
+         * @param value - value to be inserted
+         * @param physPos - physical position of inserted element
+         * @return operation result
+         */
+        ListOpResult insertAfter(size_t pos, const ListElem value, size_t *physPos = nullptr) {
+            if (!this->list->addressValid(pos) && pos != 0)
+                return LIST_OP_SEGFAULT;
+            return this->link(pos, false, value, physPos);
+        }
+
+        /**
+         * Insert an element at the first position
+         * @param value - value to be inserted
+         * @param physPos - physical position of inserted element
+         * @return operation result
+         */
+        ListOpResult pushFront(const ListElem value, size_t *physPos = nullptr) {
+            return this->insertAfter(0, value, physPos);
+        }
+
+        /**
+         * Insert an element at the last position
+         * @param value - value to be inserted
+         * @param physPos - physical position of inserted element
+         * @return operation result
+         */
+        ListOpResult pushBack(const ListElem value, size_t *physPos = nullptr) {
+            while (true) {
+                size_t tail = this->list->node(0).previous.load(std::memory_order_relaxed);
+                ListOpResult res = this->link(tail, true, value, physPos);
+                if (res != LIST_OP_NOTFOUND)
+                    return res;
+            }
+        }
+
+        /**
+         * Retrieve an element at the physical position pos and remove it
+         * @param pos - physical pos of considered element
+         * @param value - retrieved value
+         * @return operation result
+         */
+        ListOpResult pop(size_t pos, ListElem *value = nullptr) {
+            if (pos == 0 || !this->list->addressValid(pos))
+                return LIST_OP_SEGFAULT;
+            while (true) {
+                size_t prev = this->list->node(pos).previous.load(std::memory_order_relaxed);
+                if (!this->list->tryLock(prev)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (!this->list->tryLock(pos)) {
+                    this->list->unlock(prev);
+                    std::this_thread::yield();
+                    continue;
+                }
+                Node &popped = this->list->node(pos);
+                if (!popped.valid.load(std::memory_order_relaxed)) {
+                    this->list->unlock(pos);
+                    this->list->unlock(prev);
+                    return LIST_OP_SEGFAULT;
+                }
+                if (popped.previous.load(std::memory_order_relaxed) != prev) {
+                    this->list->unlock(pos);
+                    this->list->unlock(prev);
+                    continue;
+                }
+                size_t next = popped.next.load(std::memory_order_relaxed);
+                if (next != prev && !this->list->tryLock(next)) {
+                    this->list->unlock(pos);
+                    this->list->unlock(prev);
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (value != nullptr)
+                    *value = popped.value;
+                this->list->node(prev).next.store(next, std::memory_order_relaxed);
+                this->list->node(next).previous.store(prev, std::memory_order_relaxed);
+                popped.valid.store(false, std::memory_order_relaxed);
+                if (next != prev)
+                    this->list->unlock(next);
+                this->list->unlock(pos);
+                this->list->unlock(prev);
+                break;
+            }
+            this->list->size.fetch_sub(1, std::memory_order_relaxed);
+            this->release(pos);
+            return LIST_OP_OK;
+        }
+
+        /**
+         * Retrieve an element at the beginning and remove it
+         * @param value - retrieved value
+         * @return operation result
+         */
+        ListOpResult popFront(ListElem *value) {
+            while (true) {
+                size_t head = this->list->node(0).next.load(std::memory_order_relaxed);
+                if (head == 0)
+                    return LIST_OP_UNDERFLOW;
+                ListOpResult res = this->pop(head, value);
+                if (res != LIST_OP_SEGFAULT)
+                    return res;
+            }
+        }
+
+    private:
+        /**
+         * Links a cached cell after pos under locks of pos and its successor
+         * @param asTail - insert only if pos is still the last element
+         * @return LIST_OP_NOTFOUND if pos stopped being the last element
+         */
+        ListOpResult link(size_t pos, bool asTail, const ListElem value, size_t *physPos) {
+            if (this->cached == 0 && this->refill() != LIST_OP_OK)
+                return LIST_OP_NOMEM;
+            while (true) {
+                if (!this->list->tryLock(pos)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                Node &after = this->list->node(pos);
+                size_t next = after.next.load(std::memory_order_relaxed);
+                bool gone = pos != 0 && !after.valid.load(std::memory_order_relaxed);
+                if (gone || (asTail && next != 0)) {
+                    this->list->unlock(pos);
+                    return asTail ? LIST_OP_NOTFOUND : LIST_OP_SEGFAULT;
+                }
+                if (next != pos && !this->list->tryLock(next)) {
+                    this->list->unlock(pos);
+                    std::this_thread::yield();
+                    continue;
+                }
+                size_t newPos = this->cache[--this->cached];
+                Node &inserted = this->list->node(newPos);
+                inserted.value = value;
+                inserted.previous.store(pos, std::memory_order_relaxed);
+                inserted.next.store(next, std::memory_order_relaxed);
+                inserted.valid.store(true, std::memory_order_relaxed);
+                this->list->node(next).previous.store(newPos, std::memory_order_relaxed);
+                after.next.store(newPos, std::memory_order_relaxed);
+                if (next != pos)
+                    this->list->unlock(next);
+                this->list->unlock(pos);
+                this->list->size.fetch_add(1, std::memory_order_relaxed);
+                if (physPos != nullptr)
+                    *physPos = newPos;
+                return LIST_OP_OK;
+            }
+        }
+    };
+
+    SwiftyParallelList() : highWater(1), freeHead(packFree(PARALLEL_NIL, 0)), size(0) {
+        for (auto &segment : this->segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+        this->ensureAllocated(0);
+    }
+
+    SwiftyParallelList(const SwiftyParallelList &) = delete;
+
+    SwiftyParallelList &operator=(const SwiftyParallelList &) = delete;
+
+    ~SwiftyParallelList() {
+        for (auto &segment : this->segments)
+            delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Creates access point for the calling thread
+     */
+    Worker worker() {
+        return Worker(this);
+    }
+
+    /**
+     * Get an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult get(size_t pos, ListElem *value) {
+        if (value == nullptr || pos == 0 || !this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        while (!this->tryLock(pos))
+            std::this_thread::yield();
+        ListOpResult res = LIST_OP_SEGFAULT;
+        if (this->node(pos).valid.load(std::memory_order_relaxed)) {
+            *value = this->node(pos).value;
+            res = LIST_OP_OK;
+        }
+        this->unlock(pos);
+        return res;
+    }
+
+    /**
+     * Set an element at the physical position pos to the new value
+     * @param pos - physical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult set(size_t pos, const ListElem value) {
+        if (pos == 0 || !this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        while (!this->tryLock(pos))
+            std::this_thread::yield();
+        ListOpResult res = LIST_OP_SEGFAULT;
+        if (this->node(pos).valid.load(std::memory_order_relaxed)) {
+            this->node(pos).value = value;
+            res = LIST_OP_OK;
+        }
+        this->unlock(pos);
+        return res;
+    }
+
+    /**
+     * Moves iterator to the next physical position. Not synchronized with writers.
+     */
+    size_t nextIterator(size_t pos) const {
+        return this->node(pos).next.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Moves iterator to the previous physical position. Not synchronized with writers.
+     */
+    size_t prevIterator(size_t pos) const {
+        return this->node(pos).previous.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Check up list's integrity. Must not run concurrently with writers.
+     * @return operation result
+     */
+    ListOpResult checkUp() const {
+        size_t pos = 0;
+        size_t count = this->size.load(std::memory_order_acquire);
+        for (size_t i = 0; i <= count; i++) {
+            size_t next = this->node(pos).next.load(std::memory_order_relaxed);
+            if (next >= this->highWater.load(std::memory_order_relaxed) ||
+                this->node(next).previous.load(std::memory_order_relaxed) != pos)
+                return LIST_OP_CORRUPTED;
+            if (next != 0 && !this->node(next).valid.load(std::memory_order_relaxed))
+                return LIST_OP_CORRUPTED;
+            pos = next;
+        }
+        return (pos == 0) ? LIST_OP_OK : LIST_OP_CORRUPTED;
+    }
+
+    bool addressValid(size_t pos) const {
+        return pos < this->highWater.load(std::memory_order_acquire) &&
+               segmentOf(pos) < PARALLEL_SEGMENTS &&
+               this->segments[segmentOf(pos)].load(std::memory_order_acquire) != nullptr &&
+               this->node(pos).valid.load(std::memory_order_relaxed);
+    }
+
+    size_t begin() const {
+        return this->nextIterator(0);
+    }
+
+    size_t end() const {
+        return this->prevIterator(0);
+    }
+
+    size_t getSize() const {
+        return this->size.load(std::memory_order_relaxed);
+    }
+
+    size_t getCapacity() const {
+        size_t capacity = 0;
+        for (size_t i = 0; i < PARALLEL_SEGMENTS && this->segments[i].load(std::memory_order_acquire); i++)
+            capacity += (size_t(1) << i) << PARALLEL_SEGMENT_BITS;
+        return capacity - 1;
+    }
+
+    bool isEmpty() const {
+        return this->getSize() == 0;
+    }
+};
+
+#endif /* SwiftyParallelList_hpp */
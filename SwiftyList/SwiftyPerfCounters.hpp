@@ -0,0 +1,219 @@
+/**
+ * SwiftyPerfCounters - hardware performance counters around any scope
+ *
+ * Counters are opened with Linux perf_event_open for the calling thread and
+ * count user space only. Every counter is opened separately: counters the
+ * kernel, the CPU or the container do not provide are simply unavailable,
+ * and values of multiplexed counters are scaled by their running time.
+ * On other systems all counters are unavailable.
+ *
+ *     SwiftyPerfCounters counters;
+ *     SwiftyPerfTotals totals;
+ *     {
+ *         SwiftyPerfScope scope(counters, totals, operationsCount);
+ *         ... measured code ...
+ *     }
+ *     totals.perOperation(PERF_COUNTER_LLC_MISSES);
+ */
+
+#ifndef SwiftyPerfCounters_hpp
+#define SwiftyPerfCounters_hpp
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum SwiftyPerfCounter {
+    PERF_COUNTER_CYCLES        = 0,
+    PERF_COUNTER_INSTRUCTIONS  = 1,
+    PERF_COUNTER_L1D_MISSES    = 2,
+    PERF_COUNTER_LLC_MISSES    = 3,
+    PERF_COUNTER_DTLB_MISSES   = 4,
+    PERF_COUNTER_BRANCH_MISSES = 5,
+    PERF_COUNTERS_COUNT        = 6,
+};
+
+inline const char *perfCounterName(SwiftyPerfCounter counter) {
+    static const char *names[PERF_COUNTERS_COUNT] = {
+            "cycles", "instructions", "L1D-misses", "LLC-misses", "dTLB-misses", "branch-misses",
+    };
+    return (counter >= 0 && counter < PERF_COUNTERS_COUNT) ? names[counter] : "unknown";
+}
+
+/**
+ * Raw counter values at some moment
+ */
+struct SwiftyPerfSample {
+    uint64_t value[PERF_COUNTERS_COUNT];
+    uint64_t enabled[PERF_COUNTERS_COUNT];
+    uint64_t running[PERF_COUNTERS_COUNT];
+};
+
+/**
+ * Counter values accumulated over measured scopes
+ */
+struct SwiftyPerfTotals {
+    double value[PERF_COUNTERS_COUNT];
+    bool   valid[PERF_COUNTERS_COUNT];
+    size_t operations;
+
+    SwiftyPerfTotals() : value(), valid(), operations(0) {}
+
+    /**
+     * Adds the difference of two samples, scaled if the counter was multiplexed
+     * @param operations - number of operations done between samples
+     */
+    void add(const SwiftyPerfSample &begin, const SwiftyPerfSample &end, size_t operations = 1) {
+        for (size_t i = 0; i < PERF_COUNTERS_COUNT; i++) {
+            uint64_t enabled = end.enabled[i] - begin.enabled[i];
+            uint64_t running = end.running[i] - begin.running[i];
+            if (running == 0)
+                continue;
+            double delta = (double) (end.value[i] - begin.value[i]);
+            if (running < enabled)
+                delta = delta * (double) enabled / (double) running;
+            this->value[i] += delta;
+            this->valid[i] = true;
+        }
+        this->operations += operations;
+    }
+
+    /**
+     * Counter value per operation, negative if the counter is unavailable
+     */
+    double perOperation(SwiftyPerfCounter counter) const {
+        if (!this->valid[counter] || this->operations == 0)
+            return -1;
+        return this->value[counter] / (double) this->operations;
+    }
+
+    void reset() {
+        *this = SwiftyPerfTotals();
+    }
+};
+
+struct SwiftyPerfCounters {
+private:
+    int fds[PERF_COUNTERS_COUNT];
+
+#ifdef __linux__
+    static int openCounter(uint32_t type, uint64_t config) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    static uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+        return cache | (op << 8) | (result << 16);
+    }
+#endif
+
+public:
+    /**
+     * Opens all counters for the calling thread. Counters start immediately.
+     */
+    SwiftyPerfCounters() {
+        for (int &fd : this->fds)
+            fd = -1;
+#ifdef __linux__
+        this->fds[PERF_COUNTER_CYCLES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        this->fds[PERF_COUNTER_INSTRUCTIONS] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        this->fds[PERF_COUNTER_L1D_MISSES] = openCounter(PERF_TYPE_HW_CACHE, cacheConfig(
+                PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        this->fds[PERF_COUNTER_LLC_MISSES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        this->fds[PERF_COUNTER_DTLB_MISSES] = openCounter(PERF_TYPE_HW_CACHE, cacheConfig(
+                PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        this->fds[PERF_COUNTER_BRANCH_MISSES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    SwiftyPerfCounters(const SwiftyPerfCounters &) = delete;
+
+    SwiftyPerfCounters &operator=(const SwiftyPerfCounters &) = delete;
+
+    ~SwiftyPerfCounters() {
+#ifdef __linux__
+        for (int fd : this->fds) {
+            if (fd >= 0)
+                close(fd);
+        }
+#endif
+    }
+
+    bool isAvailable(SwiftyPerfCounter counter) const {
+        return this->fds[counter] >= 0;
+    }
+
+    /**
+     * @return true if at least one counter is available
+     */
+    bool anyAvailable() const {
+        for (int fd : this->fds) {
+            if (fd >= 0)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Reads current values. Unavailable counters have zero running time.
+     */
+    void sample(SwiftyPerfSample *result) const {
+        memset(result, 0, sizeof(*result));
+#ifdef __linux__
+        for (size_t i = 0; i < PERF_COUNTERS_COUNT; i++) {
+            if (this->fds[i] < 0)
+                continue;
+            uint64_t data[3] = {};
+            if (read(this->fds[i], data, sizeof(data)) != (ssize_t) sizeof(data))
+                continue;
+            result->value[i] = data[0];
+            result->enabled[i] = data[1];
+            result->running[i] = data[2];
+        }
+#endif
+    }
+};
+
+/**
+ * Measures its lifetime and adds it to totals
+ */
+struct SwiftyPerfScope {
+private:
+    const SwiftyPerfCounters &counters;
+    SwiftyPerfTotals         &totals;
+    SwiftyPerfSample         begin;
+    size_t                   operations;
+
+public:
+    /**
+     * @param operations - number of operations done in the scope
+     */
+    SwiftyPerfScope(const SwiftyPerfCounters &counters, SwiftyPerfTotals &totals, size_t operations = 1) :
+            counters(counters), totals(totals), begin(), operations(operations) {
+        this->counters.sample(&this->begin);
+    }
+
+    SwiftyPerfScope(const SwiftyPerfScope &) = delete;
+
+    SwiftyPerfScope &operator=(const SwiftyPerfScope &) = delete;
+
+    ~SwiftyPerfScope() {
+        SwiftyPerfSample end;
+        this->counters.sample(&end);
+        this->totals.add(this->begin, end, this->operations);
+    }
+};
+
+#endif /* SwiftyPerfCounters_hpp */
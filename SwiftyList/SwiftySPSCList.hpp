@@ -0,0 +1,204 @@
+/**
+ * SwiftySPSCList - single-producer/single-consumer SwiftyList mode
+ *
+ * One thread calls pushBack, another one calls popFront. Storage is preallocated
+ * once and used as a ring, so the list never de-optimizes and never reallocates.
+ * Head and tail are published with acquire/release atomics and every operation
+ * finishes in a bounded number of steps (wait-free).
+ *
+ * Storage is a preallocated ring of plain values rather than SwiftyList nodes. In the
+ * ring the physical position follows from the index alone, so next, previous and valid
+ * fields would never be read, and SwiftyList::popFront would break the optimized
+ * layout. Only ListOpResult codes are shared with SwiftyList.
+ */
+
+#ifndef SwiftySPSCList_hpp
+#define SwiftySPSCList_hpp
+
+#include <atomic>
+#include "SwiftyList.hpp"
+
+template<typename ListElem>
+struct SwiftySPSCList {
+private:
+    static_assert(std::is_trivially_copyable<ListElem>::value,
+                  "SPSC mode requires trivially copyable ListElem");
+
+    ListElem *storage;
+    size_t   capacity;
+    size_t   mask;
+
+    /**
+     * Consumer side: head is owned, tail is a cached copy of the producer's index
+     */
+    alignas(64) std::atomic<size_t> head;
+    size_t cachedTail;
+
+    /**
+     * Producer side: tail is owned, head is a cached copy of the consumer's index
+     */
+    alignas(64) std::atomic<size_t> tail;
+    size_t cachedHead;
+
+    /**
+     * Number of free cells as seen by the producer
+     */
+    size_t producerFree(size_t currentTail) {
+        size_t available = this->capacity - (currentTail - this->cachedHead);
+        if (available == 0) {
+            this->cachedHead = this->head.load(std::memory_order_acquire);
+            available = this->capacity - (currentTail - this->cachedHead);
+        }
+        return available;
+    }
+
+    /**
+     * Number of filled cells as seen by the consumer
+     */
+    size_t consumerFilled(size_t currentHead) {
+        size_t filled = this->cachedTail - currentHead;
+        if (filled == 0) {
+            this->cachedTail = this->tail.load(std::memory_order_acquire);
+            filled = this->cachedTail - currentHead;
+        }
+        return filled;
+    }
+
+public:
+    /**
+     * @param capacity - maximum number of elements, rounded up to the power of two
+     */
+    explicit SwiftySPSCList(size_t capacity) : storage(nullptr), capacity(1), mask(0), head(0), cachedTail(0),
+                                               tail(0), cachedHead(0) {
+        while (this->capacity < capacity)
+            this->capacity *= 2;
+        this->mask = this->capacity - 1;
+        this->storage = (ListElem *) malloc(this->capacity * sizeof(ListElem));
+        if (this->storage == nullptr) {
+            this->capacity = 0;
+            this->mask = 0;
+        }
+    }
+
+    SwiftySPSCList(const SwiftySPSCList &) = delete;
+
+    SwiftySPSCList &operator=(const SwiftySPSCList &) = delete;
+
+    ~SwiftySPSCList() {
+        free(this->storage);
+    }
+
+    /**
+     * Insert an element at the last position. Producer only.
+     * @param value - value to be inserted
+     * @return operation result, LIST_OP_OVERFLOW if the list is full
+     */
+    ListOpResult pushBack(const ListElem value) {
+        size_t currentTail = this->tail.load(std::memory_order_relaxed);
+        if (this->producerFree(currentTail) == 0)
+            return LIST_OP_OVERFLOW;
+        this->storage[currentTail & this->mask] = value;
+        this->tail.store(currentTail + 1, std::memory_order_release);
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Retrieve an element at the beginning and remove it. Consumer only.
+     * @param value - retrieved value
+     * @return operation result, LIST_OP_UNDERFLOW if the list is empty
+     */
+    ListOpResult popFront(ListElem *value) {
+        size_t currentHead = this->head.load(std::memory_order_relaxed);
+        if (this->consumerFilled(currentHead) == 0)
+            return LIST_OP_UNDERFLOW;
+        if (value != nullptr)
+            *value = this->storage[currentHead & this->mask];
+        this->head.store(currentHead + 1, std::memory_order_release);
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Insert as many elements as fit at the last positions. Producer only.
+     * Published to the consumer at once.
+     * @param values - values to be inserted
+     * @param count - number of values
+     * @param pushed - number of values inserted
+     * @return operation result, LIST_OP_OVERFLOW if not all values fit
+     */
+    ListOpResult pushBackBatch(const ListElem *values, size_t count, size_t *pushed = nullptr) {
+        if (pushed != nullptr)
+            *pushed = 0;
+        if (count == 0)
+            return LIST_OP_OK;
+        size_t currentTail = this->tail.load(std::memory_order_relaxed);
+        size_t available = this->capacity - (currentTail - this->cachedHead);
+        if (available < count) {
+            this->cachedHead = this->head.load(std::memory_order_acquire);
+            available = this->capacity - (currentTail - this->cachedHead);
+        }
+        size_t done = (count < available) ? count : available;
+        if (done == 0)
+            return LIST_OP_OVERFLOW;
+        size_t offset = currentTail & this->mask;
+        size_t firstPart = this->capacity - offset;
+        if (firstPart > done)
+            firstPart = done;
+        memcpy(this->storage + offset, values, firstPart * sizeof(ListElem));
+        memcpy(this->storage, values + firstPart, (done - firstPart) * sizeof(ListElem));
+        this->tail.store(currentTail + done, std::memory_order_release);
+        if (pushed != nullptr)
+            *pushed = done;
+        return (done == count) ? LIST_OP_OK : LIST_OP_OVERFLOW;
+    }
+
+    /**
+     * Retrieve and remove up to count elements from the beginning. Consumer only.
+     * @param values - retrieved values
+     * @param count - maximum number of values
+     * @param popped - number of values retrieved
+     * @return operation result, LIST_OP_UNDERFLOW if the list was empty
+     */
+    ListOpResult popFrontBatch(ListElem *values, size_t count, size_t *popped = nullptr) {
+        if (popped != nullptr)
+            *popped = 0;
+        if (count == 0)
+            return LIST_OP_OK;
+        size_t currentHead = this->head.load(std::memory_order_relaxed);
+        size_t filled = this->cachedTail - currentHead;
+        if (filled < count) {
+            this->cachedTail = this->tail.load(std::memory_order_acquire);
+            filled = this->cachedTail - currentHead;
+        }
+        size_t done = (count < filled) ? count : filled;
+        if (done == 0)
+            return LIST_OP_UNDERFLOW;
+        size_t offset = currentHead & this->mask;
+        size_t firstPart = this->capacity - offset;
+        if (firstPart > done)
+            firstPart = done;
+        memcpy(values, this->storage + offset, firstPart * sizeof(ListElem));
+        memcpy(values + firstPart, this->storage, (done - firstPart) * sizeof(ListElem));
+        this->head.store(currentHead + done, std::memory_order_release);
+        if (popped != nullptr)
+            *popped = done;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Number of elements. Exact only when called by producer or consumer in quiescent state.
+     */
+    size_t getSize() const {
+        size_t currentHead = this->head.load(std::memory_order_acquire);
+        return this->tail.load(std::memory_order_acquire) - currentHead;
+    }
+
+    size_t getCapacity() const {
+        return this->capacity;
+    }
+
+    bool isEmpty() const {
+        return this->getSize() == 0;
+    }
+};
+
+#endif /* SwiftySPSCList_hpp */
@@ -0,0 +1,384 @@
+/**
+ * SwiftyShardedList - one logical sequence spread over K SwiftyList shards
+ *
+ * Logical sequence is shard 0, then shard 1 and so on. Every shard has its own
+ * lock, so threads working with different shards do not contend. Shard sizes are
+ * kept in a Fenwick tree of atomic counters, so logical position is routed to
+ * its shard in O(log K) without taking any lock.
+ *
+ * Logical positions are exact as long as shards before the addressed one are not
+ * being changed at the same time. Otherwise routing retries on the fresh sizes and,
+ * after SHARDED_ROUTE_ATTEMPTS attempts, locks shards from the first one in order
+ * until the position is found.
+ */
+
+#ifndef SwiftyShardedList_hpp
+#define SwiftyShardedList_hpp
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SwiftyList.hpp"
+
+const size_t SHARDED_ROUTE_ATTEMPTS = 64;
+
+template<typename ListElem>
+struct SwiftyShardedList {
+private:
+    struct Shard {
+        std::mutex           mutex;
+        SwiftyList<ListElem> list;
+
+        Shard(size_t initialSize, short int verbose, FILE *logFile, bool useChecks) :
+                list(initialSize, verbose, logFile, useChecks) {}
+    };
+
+    std::vector<Shard *>  shards;
+    std::atomic<size_t>   *directory;
+    size_t                directoryStep;
+
+    void directoryAdd(size_t shard, size_t delta) {
+        for (size_t i = shard + 1; i <= this->shards.size(); i += i & (~i + 1))
+            this->directory[i].fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * Number of elements in shards [0, count)
+     */
+    size_t prefix(size_t count) const {
+        size_t sum = 0;
+        for (size_t i = count; i > 0; i -= i & (~i + 1))
+            sum += this->directory[i].load(std::memory_order_relaxed);
+        return sum;
+    }
+
+    /**
+     * Finds shard holding logical position pos by Fenwick tree descent
+     * @param local - position inside the shard
+     * @return shard index or shards count if pos is out of range
+     */
+    size_t locate(size_t pos, size_t *local) const {
+        size_t shard = 0;
+        for (size_t step = this->directoryStep; step != 0; step >>= 1) {
+            if (shard + step > this->shards.size())
+                continue;
+            size_t count = this->directory[shard + step].load(std::memory_order_relaxed);
+            if (count <= pos) {
+                shard += step;
+                pos -= count;
+            }
+        }
+        *local = pos;
+        return shard;
+    }
+
+    /**
+     * Runs op on the shard holding logical position pos with its lock held.
+     * Size change reported by op is applied to the directory before unlocking.
+     */
+    template<typename Op>
+    ListOpResult routed(size_t pos, Op op) {
+        for (size_t attempt = 0; attempt < SHARDED_ROUTE_ATTEMPTS; attempt++) {
+            size_t local = 0;
+            size_t shard = this->locate(pos, &local);
+            if (shard == this->shards.size())
+                return LIST_OP_OVERFLOW;
+            std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+            SwiftyList<ListElem> &list = this->shards[shard]->list;
+            if (local >= list.getSize() || this->prefix(shard) + local != pos)
+                continue;
+            return this->apply(shard, op, local);
+        }
+        return this->routedLocked(pos, op);
+    }
+
+    /**
+     * Routes pos exactly: shards are locked in order from the first one, so sizes
+     * of the shards before the addressed one cannot change until op is done.
+     * Shards are always locked in ascending order, so it does not deadlock.
+     */
+    template<typename Op>
+    ListOpResult routedLocked(size_t pos, Op op) {
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(this->shards.size());
+        for (size_t shard = 0; shard < this->shards.size(); shard++) {
+            locks.emplace_back(this->shards[shard]->mutex);
+            size_t shardSize = this->shards[shard]->list.getSize();
+            if (pos < shardSize)
+                return this->apply(shard, op, pos);
+            pos -= shardSize;
+        }
+        return LIST_OP_OVERFLOW;
+    }
+
+    /**
+     * Runs op on locked shard and updates the directory by the size difference
+     */
+    template<typename Op>
+    ListOpResult apply(size_t shard, Op op, size_t local) {
+        SwiftyList<ListElem> &list = this->shards[shard]->list;
+        size_t before = list.getSize();
+        ListOpResult res = op(list, local);
+        size_t after = list.getSize();
+        if (after != before)
+            this->directoryAdd(shard, after - before);
+        return res;
+    }
+
+    static size_t threadShard() {
+        static std::atomic<size_t> nextShard(0);
+        static thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+        return shard;
+    }
+
+public:
+    /**
+     * @param shardsCount - number of shards, at least one
+     */
+    SwiftyShardedList(size_t shardsCount, size_t initialSize, short int verbose, FILE *logFile, bool useChecks) :
+            directory(nullptr), directoryStep(1) {
+        if (shardsCount == 0)
+            shardsCount = 1;
+        for (size_t i = 0; i < shardsCount; i++)
+            this->shards.push_back(new Shard(initialSize / shardsCount, verbose, logFile, useChecks));
+        this->directory = new std::atomic<size_t>[shardsCount + 1];
+        for (size_t i = 0; i <= shardsCount; i++)
+            this->directory[i].store(0, std::memory_order_relaxed);
+        while (this->directoryStep * 2 <= shardsCount)
+            this->directoryStep *= 2;
+    }
+
+    SwiftyShardedList(const SwiftyShardedList &) = delete;
+
+    SwiftyShardedList &operator=(const SwiftyShardedList &) = delete;
+
+    ~SwiftyShardedList() {
+        for (Shard *shard : this->shards) {
+            shard->list.DestructList();
+            delete shard;
+        }
+        delete[] this->directory;
+    }
+
+    /**
+     * Insert an element at the end of the last shard, i.e. at the last logical position
+     * @param value - value to be inserted
+     * @return operation result
+     */
+    ListOpResult pushBack(const ListElem value) {
+        size_t shard = this->shards.size() - 1;
+        std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+        return this->apply(shard, [&](SwiftyList<ListElem> &list, size_t) { return list.pushBack(value); }, 0);
+    }
+
+    /**
+     * Insert an element at the first logical position
+     * @param value - value to be inserted
+     * @return operation result
+     */
+    ListOpResult pushFront(const ListElem value) {
+        std::lock_guard<std::mutex> guard(this->shards[0]->mutex);
+        return this->apply(0, [&](SwiftyList<ListElem> &list, size_t) { return list.pushFront(value); }, 0);
+    }
+
+    /**
+     * Append an element to the end of the calling thread's shard.
+     * Threads appending concurrently do not contend, the element lands
+     * at the end of that shard's part of the logical sequence.
+     * @param value - value to be inserted
+     * @return operation result
+     */
+    ListOpResult pushBackSpread(const ListElem value) {
+        size_t shard = threadShard() % this->shards.size();
+        std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+        return this->apply(shard, [&](SwiftyList<ListElem> &list, size_t) { return list.pushBack(value); }, 0);
+    }
+
+    /**
+     * Append an element to the end of the given shard
+     * @param shard - shard index
+     * @param value - value to be inserted
+     * @return operation result
+     */
+    ListOpResult pushBackShard(size_t shard, const ListElem value) {
+        if (shard >= this->shards.size())
+            return LIST_OP_OVERFLOW;
+        std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+        return this->apply(shard, [&](SwiftyList<ListElem> &list, size_t) { return list.pushBack(value); }, 0);
+    }
+
+    /**
+     * Insert an element after the logical position pos. The element at pos has to exist,
+     * so elements are added to an empty list with pushBack or pushFront.
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @return operation result
+     */
+    ListOpResult insertAfterLogic(size_t pos, const ListElem value) {
+        return this->routed(pos, [&](SwiftyList<ListElem> &list, size_t local) {
+            return list.insertAfter(list.logicToPhysic(local), value);
+        });
+    }
+
+    /**
+     * Get an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem *value) {
+        return this->routed(pos, [&](SwiftyList<ListElem> &list, size_t local) {
+            return list.getLogic(local, value);
+        });
+    }
+
+    /**
+     * Set an element at the logical position pos to the new value
+     * @param pos - logical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult setLogic(size_t pos, const ListElem value) {
+        return this->routed(pos, [&](SwiftyList<ListElem> &list, size_t local) {
+            return list.setLogic(local, value);
+        });
+    }
+
+    /**
+     * Retrieve an element at the logical position pos and remove it
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popLogic(size_t pos, ListElem *value) {
+        return this->routed(pos, [&](SwiftyList<ListElem> &list, size_t local) {
+            return list.popLogic(local, value);
+        });
+    }
+
+    /**
+     * Remove an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @return operation result
+     */
+    ListOpResult removeLogic(size_t pos) {
+        return this->popLogic(pos, nullptr);
+    }
+
+    /**
+     * Retrieve an element at the beginning and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popFront(ListElem *value) {
+        for (size_t shard = 0; shard < this->shards.size(); shard++) {
+            std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+            if (!this->shards[shard]->list.isEmpty())
+                return this->apply(shard, [&](SwiftyList<ListElem> &list, size_t) {
+                    return list.popFront(value);
+                }, 0);
+        }
+        return LIST_OP_UNDERFLOW;
+    }
+
+    /**
+     * Retrieve an element at the end and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popBack(ListElem *value) {
+        for (size_t shard = this->shards.size(); shard-- > 0;) {
+            std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+            if (!this->shards[shard]->list.isEmpty())
+                return this->apply(shard, [&](SwiftyList<ListElem> &list, size_t) {
+                    return list.popBack(value);
+                }, 0);
+        }
+        return LIST_OP_UNDERFLOW;
+    }
+
+    /**
+     * Optimizes every shard, shards are processed in parallel
+     * @param threads - maximum number of threads, 0 for hardware concurrency
+     * @return operation result
+     */
+    ListOpResult optimize(size_t threads = 0) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        std::atomic<size_t> nextShard(0);
+        std::atomic<int> failed(LIST_OP_OK);
+        auto worker = [&]() {
+            size_t shard;
+            while ((shard = nextShard.fetch_add(1)) < this->shards.size()) {
+                std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+                ListOpResult res = this->shards[shard]->list.optimize();
+                if (res != LIST_OP_OK)
+                    failed.store(res);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < threads && i < this->shards.size(); i++)
+            pool.emplace_back(worker);
+        worker();
+        for (auto &thread : pool)
+            thread.join();
+        return (ListOpResult) failed.load();
+    }
+
+    /**
+     * Calls func(value) for all elements in logical order. Shards are locked one at a time.
+     */
+    template<typename Func>
+    void forEach(Func func) {
+        for (Shard *shard : this->shards) {
+            std::lock_guard<std::mutex> guard(shard->mutex);
+            SwiftyList<ListElem> &list = shard->list;
+            size_t iterator = list.begin();
+            for (size_t i = 0; i < list.getSize(); i++) {
+                ListElem value = {};
+                list.get(iterator, &value);
+                func(value);
+                iterator = list.nextIterator(iterator);
+            }
+        }
+    }
+
+    /**
+     * Check up every shard and the directory. Shards are locked one at a time.
+     * @return operation result
+     */
+    ListOpResult checkUp() {
+        size_t total = 0;
+        for (size_t shard = 0; shard < this->shards.size(); shard++) {
+            std::lock_guard<std::mutex> guard(this->shards[shard]->mutex);
+            ListOpResult res = this->shards[shard]->list.checkUp();
+            if (res != LIST_OP_OK)
+                return res;
+            if (this->prefix(shard + 1) - this->prefix(shard) != this->shards[shard]->list.getSize())
+                return LIST_OP_CORRUPTED;
+            total += this->shards[shard]->list.getSize();
+        }
+        return (total == this->getSize()) ? LIST_OP_OK : LIST_OP_CORRUPTED;
+    }
+
+    size_t getShardsCount() const {
+        return this->shards.size();
+    }
+
+    size_t getShardSize(size_t shard) const {
+        return this->prefix(shard + 1) - this->prefix(shard);
+    }
+
+    size_t getSize() const {
+        return this->prefix(this->shards.size());
+    }
+
+    bool isEmpty() const {
+        return this->getSize() == 0;
+    }
+};
+
+#endif /* SwiftyShardedList_hpp */
@@ -0,0 +1,581 @@
+/**
+ * SwiftySharedList - SwiftyList one writer process shares with reader processes
+ *
+ * Storage of the writer's list lives in POSIX shared memory. Readers open it with
+ * SwiftySharedListView, map it read-only and read nodes in place, so lookups need
+ * neither IPC nor copies of the list.
+ *
+ * Shared memory objects: "<name>" holds SwiftySharedHeader and never grows,
+ * "<name>.<generation>" holds the storage. Every writer operation is a write section
+ * of a sequence lock: version is odd while the list changes, and readers retry reads
+ * that saw an odd version or a version that changed meanwhile.
+ *
+ * Growing the storage, always inside a write section:
+ *  1. the writer creates and maps "<name>.<g + 1>" and copies the nodes into it;
+ *  2. generation and storage size of the new object are published in the header;
+ *  3. the writer unlinks and unmaps "<name>.<g>". Readers keep their own mapping of it,
+ *     so reads in flight stay in bounds. They retry since the version changed and map
+ *     "<name>.<g + 1>" before the next attempt.
+ *
+ * Readers give up with LIST_OP_IOERROR after SHARED_READ_ATTEMPTS attempts, e.g. when
+ * the writer died inside a write section.
+ */
+
+#ifndef SwiftySharedList_hpp
+#define SwiftySharedList_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SwiftyList.hpp"
+
+const char   SWIFTY_SHARED_MAGIC[4] = {'S', 'W', 'L', 'M'};
+const size_t SHARED_NAME_MAX        = 240;
+const size_t SHARED_READ_ATTEMPTS   = 1 << 20;
+
+/**
+ * Control object of a shared list, written by the writer only
+ */
+struct SwiftySharedHeader {
+    char                  magic[4];
+    uint32_t              elemSize;
+    uint64_t              nodeSize;
+    std::atomic<uint64_t> version;
+    std::atomic<uint64_t> generation;
+    std::atomic<uint64_t> storageBytes;
+    std::atomic<uint64_t> size;
+    std::atomic<uint64_t> optimized;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared header needs address-free atomics");
+
+/**
+ * Writer side shared memory objects, storage source of the writer's list
+ */
+struct SwiftySharedSegments : SwiftyListStorageSource {
+private:
+    struct Mapping {
+        void     *memory;
+        size_t   bytes;
+        uint64_t generation;
+    };
+
+    char               name[SHARED_NAME_MAX];
+    SwiftySharedHeader *header;
+    Mapping            current;
+    Mapping            previous;
+
+    void segmentName(uint64_t generation, char *result) const {
+        snprintf(result, SHARED_NAME_MAX + 24, "%s.%llu", this->name, (unsigned long long) generation);
+    }
+
+    void drop(Mapping &mapping) {
+        if (mapping.memory == nullptr)
+            return;
+        char segment[SHARED_NAME_MAX + 24];
+        this->segmentName(mapping.generation, segment);
+        munmap(mapping.memory, mapping.bytes);
+        shm_unlink(segment);
+        mapping = {nullptr, 0, 0};
+    }
+
+    void publish() {
+        this->header->storageBytes.store(this->current.bytes, std::memory_order_relaxed);
+        this->header->generation.store(this->current.generation, std::memory_order_release);
+    }
+
+public:
+    SwiftySharedSegments() : name(), header(nullptr), current({nullptr, 0, 0}), previous({nullptr, 0, 0}) {}
+
+    SwiftySharedSegments(const SwiftySharedSegments &) = delete;
+
+    SwiftySharedSegments &operator=(const SwiftySharedSegments &) = delete;
+
+    ~SwiftySharedSegments() override {
+        this->close();
+    }
+
+    /**
+     * Creates the control object, an existing one of the same name is taken over
+     * @param newName - shared memory object name, starts with '/'
+     * @param elemSize - size of list values
+     * @param nodeSize - size of list nodes
+     * @return operation result
+     */
+    ListOpResult create(const char *newName, uint32_t elemSize, uint64_t nodeSize) {
+        if (newName == nullptr || strlen(newName) >= SHARED_NAME_MAX)
+            return LIST_OP_SEGFAULT;
+        this->close();
+        int fd = shm_open(newName, O_CREAT | O_TRUNC | O_RDWR, 0644);
+        if (fd < 0)
+            return LIST_OP_IOERROR;
+        void *memory = MAP_FAILED;
+        if (ftruncate(fd, sizeof(SwiftySharedHeader)) == 0)
+            memory = mmap(nullptr, sizeof(SwiftySharedHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(newName);
+            return LIST_OP_IOERROR;
+        }
+        strcpy(this->name, newName);
+        this->header = new(memory) SwiftySharedHeader();
+        memcpy(this->header->magic, SWIFTY_SHARED_MAGIC, sizeof(this->header->magic));
+        this->header->elemSize = elemSize;
+        this->header->nodeSize = nodeSize;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Unlinks and unmaps all objects. Readers keep what they mapped.
+     */
+    void close() {
+        this->drop(this->previous);
+        this->drop(this->current);
+        if (this->header != nullptr) {
+            munmap(this->header, sizeof(SwiftySharedHeader));
+            shm_unlink(this->name);
+            this->header = nullptr;
+        }
+    }
+
+    /**
+     * Creates the object of the next generation and publishes it
+     */
+    void *allocate(size_t bytes, size_t *actualBytes) override {
+        if (this->header == nullptr)
+            return nullptr;
+        size_t page = (size_t) sysconf(_SC_PAGESIZE);
+        bytes = (bytes + page - 1) / page * page;
+        uint64_t generation = this->header->generation.load(std::memory_order_relaxed) + 1;
+        char segment[SHARED_NAME_MAX + 24];
+        this->segmentName(generation, segment);
+        int fd = shm_open(segment, O_CREAT | O_TRUNC | O_RDWR, 0644);
+        if (fd < 0)
+            return nullptr;
+        void *memory = MAP_FAILED;
+        if (ftruncate(fd, (off_t) bytes) == 0)
+            memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(segment);
+            return nullptr;
+        }
+        this->drop(this->previous);
+        this->previous = this->current;
+        this->current = {memory, bytes, generation};
+        this->publish();
+        if (actualBytes != nullptr)
+            *actualBytes = bytes;
+        return memory;
+    }
+
+    /**
+     * Drops the object of the storage. When the current one is dropped while the previous one
+     * is still mapped, the previous one is published again, otherwise readers keep the last state.
+     */
+    void release(void *storage) override {
+        if (storage == this->previous.memory) {
+            this->drop(this->previous);
+        } else if (storage == this->current.memory) {
+            this->drop(this->current);
+            if (this->previous.memory == nullptr)
+                return;
+            this->current = this->previous;
+            this->previous = {nullptr, 0, 0};
+            this->publish();
+        }
+    }
+
+    SwiftySharedHeader *getHeader() const {
+        return this->header;
+    }
+};
+
+/**
+ * Writer of a shared list. Every operation is published to readers as a whole.
+ */
+template<typename ListElem>
+struct SwiftySharedList {
+private:
+    static_assert(std::is_trivially_copyable<ListElem>::value, "shared storage requires trivially copyable ListElem");
+
+    // segments must outlive the list that releases storage into them
+    SwiftySharedSegments segments;
+    SwiftyList<ListElem> list;
+
+    /**
+     * Runs op as a write section of the sequence lock and publishes size of the list.
+     * Before create() and after close() the list is private and op just runs.
+     */
+    template<typename Op>
+    ListOpResult write(Op op) {
+        SwiftySharedHeader *header = this->segments.getHeader();
+        if (header == nullptr)
+            return op();
+        uint64_t version = header->version.load(std::memory_order_relaxed);
+        header->version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ListOpResult res = op();
+        header->size.store(this->list.getSize(), std::memory_order_relaxed);
+        header->optimized.store(this->list.isOptimized(), std::memory_order_relaxed);
+        header->version.store(version + 2, std::memory_order_release);
+        return res;
+    }
+
+public:
+    explicit SwiftySharedList(size_t initialSize = 0) : segments(), list(initialSize, 0, nullptr, false) {}
+
+    SwiftySharedList(const SwiftySharedList &) = delete;
+
+    SwiftySharedList &operator=(const SwiftySharedList &) = delete;
+
+    ~SwiftySharedList() {
+        this->list.DestructList();
+        this->segments.close();
+    }
+
+    /**
+     * Publishes the list under the name, current elements are kept
+     * @param name - shared memory object name, starts with '/'
+     * @return operation result
+     */
+    ListOpResult create(const char *name) {
+        ListOpResult res = this->close();
+        if (res != LIST_OP_OK)
+            return res;
+        res = this->segments.create(name, sizeof(ListElem), SwiftySharedListView<ListElem>::nodeBytes());
+        if (res != LIST_OP_OK)
+            return res;
+        return this->write([this]() { return this->list.setStorageSource(&this->segments); });
+    }
+
+    /**
+     * Stops sharing, the list moves back to the heap. Readers that mapped the list keep
+     * its last published state, new readers cannot open it.
+     * @return operation result
+     */
+    ListOpResult close() {
+        if (this->list.getStorageSource() != nullptr && this->list.setStorageSource(nullptr) != LIST_OP_OK)
+            return LIST_OP_NOMEM;
+        this->segments.close();
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Runs func(list) as one write section, readers see all its changes at once.
+     * func must not take snapshots, set a pool or a storage source.
+     * @return result of func
+     */
+    template<typename Func>
+    ListOpResult batch(Func func) {
+        return this->write([this, &func]() { return func(this->list); });
+    }
+
+    ListOpResult pushBack(const ListElem value, size_t *physPos = nullptr) {
+        return this->write([&]() { return this->list.pushBack(value, physPos); });
+    }
+
+    ListOpResult pushFront(const ListElem value, size_t *physPos = nullptr) {
+        return this->write([&]() { return this->list.pushFront(value, physPos); });
+    }
+
+    ListOpResult insertAfter(size_t pos, const ListElem value, size_t *physPos = nullptr) {
+        return this->write([&]() { return this->list.insertAfter(pos, value, physPos); });
+    }
+
+    ListOpResult insertBefore(size_t pos, const ListElem value, size_t *physPos = nullptr) {
+        return this->write([&]() { return this->list.insertBefore(pos, value, physPos); });
+    }
+
+    ListOpResult pop(size_t pos, ListElem *value = nullptr) {
+        return this->write([&]() { return this->list.pop(pos, value); });
+    }
+
+    ListOpResult remove(size_t pos) {
+        return this->write([&]() { return this->list.remove(pos); });
+    }
+
+    ListOpResult removeLogic(size_t pos) {
+        return this->write([&]() { return this->list.removeLogic(pos); });
+    }
+
+    ListOpResult set(size_t pos, const ListElem value) {
+        return this->write([&]() { return this->list.set(pos, value); });
+    }
+
+    ListOpResult setLogic(size_t pos, const ListElem value) {
+        return this->write([&]() { return this->list.setLogic(pos, value); });
+    }
+
+    ListOpResult swap(size_t firstPos, size_t secondPos) {
+        return this->write([&]() { return this->list.swap(firstPos, secondPos); });
+    }
+
+    ListOpResult optimize() {
+        return this->write([&]() { return this->list.optimize(); });
+    }
+
+    ListOpResult clear() {
+        return this->write([&]() { return this->list.clear(); });
+    }
+
+    /**
+     * Writer's own view of the list, reading it needs no synchronization
+     */
+    const SwiftyList<ListElem> &getList() const {
+        return this->list;
+    }
+};
+
+/**
+ * Reader of a shared list. Values are copied out of the shared storage under the sequence lock.
+ */
+template<typename ListElem>
+struct SwiftySharedListView {
+private:
+    using Node = typename SwiftyList<ListElem>::SwiftyListNode;
+
+    const SwiftySharedHeader *header;
+    const char               *storage;
+    size_t                   storageBytes;
+    uint64_t                 generation;
+    char                     name[SHARED_NAME_MAX];
+
+    static void *mapReadOnly(const char *objectName, size_t minBytes, size_t *bytes) {
+        int fd = shm_open(objectName, O_RDONLY, 0);
+        if (fd < 0)
+            return nullptr;
+        struct stat info = {};
+        void *memory = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && (size_t) info.st_size >= minBytes && info.st_size > 0)
+            memory = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED)
+            return nullptr;
+        *bytes = (size_t) info.st_size;
+        return memory;
+    }
+
+    /**
+     * Maps the storage object of the published generation if it changed
+     */
+    bool remap() {
+        uint64_t published = this->header->generation.load(std::memory_order_acquire);
+        if (published == this->generation)
+            return true;
+        char segment[SHARED_NAME_MAX + 24];
+        snprintf(segment, sizeof(segment), "%s.%llu", this->name, (unsigned long long) published);
+        size_t bytes = 0;
+        void *memory = mapReadOnly(segment, sizeof(Node), &bytes);
+        if (memory == nullptr)
+            return false;
+        if (this->storage != nullptr)
+            munmap((void *) this->storage, this->storageBytes);
+        this->storage = (const char *) memory;
+        this->storageBytes = bytes;
+        this->generation = published;
+        return true;
+    }
+
+    /**
+     * Copies the node at pos, false if pos is outside of the mapping
+     */
+    bool node(size_t pos, Node *result) const {
+        if (this->storage == nullptr || pos >= this->storageBytes / sizeof(Node))
+            return false;
+        memcpy((void *) result, this->storage + pos * sizeof(Node), sizeof(Node));
+        return true;
+    }
+
+    /**
+     * Physical position of the element at the logical position pos, 0 if it is not reachable
+     */
+    size_t logicToPhysic(size_t pos, bool optimized) const {
+        if (optimized)
+            return pos + 1;
+        Node current;
+        if (!this->node(0, &current))
+            return 0;
+        size_t physPos = current.next;
+        for (size_t i = 0; i < pos; i++) {
+            if (!this->node(physPos, &current))
+                return 0;
+            physPos = current.next;
+        }
+        return physPos;
+    }
+
+    /**
+     * Runs read(size, optimized) until it sees a consistent state
+     */
+    template<typename Read>
+    ListOpResult consistent(Read read) {
+        if (this->header == nullptr)
+            return LIST_OP_IOERROR;
+        for (size_t attempt = 0; attempt < SHARED_READ_ATTEMPTS; attempt++) {
+            uint64_t version = this->header->version.load(std::memory_order_acquire);
+            if ((version & 1) != 0 || !this->remap()) {
+                sched_yield();
+                continue;
+            }
+            ListOpResult res = read(this->header->size.load(std::memory_order_relaxed),
+                                    this->header->optimized.load(std::memory_order_relaxed) != 0);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (this->header->version.load(std::memory_order_relaxed) == version)
+                return res;
+        }
+        return LIST_OP_IOERROR;
+    }
+
+public:
+    SwiftySharedListView() : header(nullptr), storage(nullptr), storageBytes(0), generation(0), name() {}
+
+    SwiftySharedListView(const SwiftySharedListView &) = delete;
+
+    SwiftySharedListView &operator=(const SwiftySharedListView &) = delete;
+
+    ~SwiftySharedListView() {
+        this->close();
+    }
+
+    static constexpr size_t nodeBytes() {
+        return sizeof(Node);
+    }
+
+    /**
+     * Maps the shared list published under the name
+     * @param newName - shared memory object name the writer used
+     * @return operation result, LIST_OP_CORRUPTED if the list holds other values
+     */
+    ListOpResult open(const char *newName) {
+        if (newName == nullptr || strlen(newName) >= SHARED_NAME_MAX)
+            return LIST_OP_SEGFAULT;
+        this->close();
+        size_t bytes = 0;
+        void *memory = mapReadOnly(newName, sizeof(SwiftySharedHeader), &bytes);
+        if (memory == nullptr)
+            return LIST_OP_IOERROR;
+        auto *newHeader = (const SwiftySharedHeader *) memory;
+        if (memcmp(newHeader->magic, SWIFTY_SHARED_MAGIC, sizeof(newHeader->magic)) != 0 ||
+            newHeader->elemSize != sizeof(ListElem) || newHeader->nodeSize != sizeof(Node)) {
+            munmap(memory, bytes);
+            return LIST_OP_CORRUPTED;
+        }
+        strcpy(this->name, newName);
+        this->header = newHeader;
+        return LIST_OP_OK;
+    }
+
+    void close() {
+        if (this->storage != nullptr)
+            munmap((void *) this->storage, this->storageBytes);
+        if (this->header != nullptr)
+            munmap((void *) this->header, sizeof(SwiftySharedHeader));
+        this->header = nullptr;
+        this->storage = nullptr;
+        this->storageBytes = 0;
+        this->generation = 0;
+    }
+
+    /**
+     * Get an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult get(size_t pos, ListElem *value) {
+        if (value == nullptr)
+            return LIST_OP_SEGFAULT;
+        return this->consistent([&](size_t, bool) {
+            Node current;
+            if (pos == 0 || !this->node(pos, &current) || !current.valid)
+                return LIST_OP_SEGFAULT;
+            *value = current.value;
+            return LIST_OP_OK;
+        });
+    }
+
+    /**
+     * Get an element at the logical position pos. O(1) while the writer's list is optimized.
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem *value) {
+        return this->getLogicRange(pos, 1, value);
+    }
+
+    /**
+     * Get count consecutive elements starting from the logical position from, all of the same version
+     * @param from - logical pos of the first element
+     * @param count - number of elements
+     * @param values - retrieved values
+     * @return operation result
+     */
+    ListOpResult getLogicRange(size_t from, size_t count, ListElem *values) {
+        if (values == nullptr && count != 0)
+            return LIST_OP_SEGFAULT;
+        return this->consistent([&](size_t size, bool optimized) {
+            if (from > size || count > size - from)
+                return LIST_OP_OVERFLOW;
+            size_t physPos = this->logicToPhysic(from, optimized);
+            Node current;
+            for (size_t i = 0; i < count; i++) {
+                if (!this->node(physPos, &current) || !current.valid)
+                    return LIST_OP_CORRUPTED;
+                values[i] = current.value;
+                physPos = optimized ? physPos + 1 : current.next;
+            }
+            return LIST_OP_OK;
+        });
+    }
+
+    /**
+     * Search an element in the list. Retrieves the logical position
+     * @param pos - logical pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult searchLogic(size_t *pos, const ListElem value) {
+        if (pos == nullptr)
+            return LIST_OP_SEGFAULT;
+        return this->consistent([&](size_t size, bool) {
+            Node current;
+            if (!this->node(0, &current))
+                return LIST_OP_CORRUPTED;
+            size_t physPos = current.next;
+            for (size_t i = 0; i < size; i++) {
+                if (!this->node(physPos, &current))
+                    return LIST_OP_CORRUPTED;
+                if (current.value == value) {
+                    *pos = i;
+                    return LIST_OP_OK;
+                }
+                physPos = current.next;
+            }
+            return LIST_OP_NOTFOUND;
+        });
+    }
+
+    /**
+     * Size of the list in the latest published version
+     */
+    size_t getSize() const {
+        return (this->header == nullptr) ? 0 : this->header->size.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Changes by two with every writer operation
+     */
+    uint64_t getVersion() const {
+        return (this->header == nullptr) ? 0 : this->header->version.load(std::memory_order_acquire);
+    }
+};
+
+#endif /* SwiftySharedList_hpp */
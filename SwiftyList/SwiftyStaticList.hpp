@@ -0,0 +1,531 @@
+/**
+ * SwiftyStaticList - fixed-capacity SwiftyList without heap allocations
+ *
+ * Nodes live in a std::array inside the object, links are the narrowest
+ * unsigned type that fits N, so the list can be built on the stack, as a
+ * global with static storage duration or entirely in constant expressions:
+ *
+ *     constexpr auto list = [] {
+ *         SwiftyStaticList<int, 8> result;
+ *         result.pushBack(1);
+ *         return result;
+ *     }();
+ *
+ * Layout and optimized mode are the same as in SwiftyList: slot 0 is the
+ * sentinel and logical position pos is stored at physical position pos + 1
+ * until the list is changed anywhere except its end. There are no checks,
+ * dumps or traces; inserting into a full list returns LIST_OP_NOMEM.
+ */
+
+#ifndef SwiftyStaticList_hpp
+#define SwiftyStaticList_hpp
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "SwiftyList.hpp"
+
+/**
+ * Narrowest unsigned type that holds positions 0..N and the free cell mark
+ */
+template<size_t N>
+using SwiftyStaticIndex = typename std::conditional<(N < UINT8_MAX), uint8_t,
+        typename std::conditional<(N < UINT16_MAX), uint16_t,
+                typename std::conditional<(N < UINT32_MAX), uint32_t, size_t>::type>::type>::type;
+
+template<typename ListElem, size_t N>
+struct SwiftyStaticList {
+    static_assert(N > 0, "SwiftyStaticList needs a positive capacity");
+
+    using Index = SwiftyStaticIndex<N>;
+
+private:
+    static constexpr Index FREE_MARK = std::numeric_limits<Index>::max();
+
+    struct SwiftyStaticNode {
+        ListElem value;
+        Index    next;
+        Index    previous;
+    };
+
+    std::array<SwiftyStaticNode, N + 1> storage;
+    Index                               size;
+    Index                               freePtr;
+    Index                               freeSize;
+    bool                                optimized;
+
+    /**
+     * Takes a free cell or the first unused one
+     * @return new cell or 0 if the list is full
+     */
+    constexpr size_t getFreePos() {
+        if (this->freeSize != 0) {
+            size_t pos = this->freePtr;
+            this->freePtr = this->storage[pos].next;
+            this->freeSize--;
+            return pos;
+        }
+        if (this->size >= N)
+            return 0;
+        return this->size + 1;
+    }
+
+    constexpr void addFreePos(size_t pos) {
+        this->storage[pos].next = this->freePtr;
+        this->storage[pos].previous = FREE_MARK;
+        this->freePtr = (Index) pos;
+        this->freeSize++;
+    }
+
+    /**
+     * Exchanges two occupied cells keeping the logical order
+     */
+    constexpr void swapCells(size_t first, size_t second) {
+        SwiftyStaticNode firstNode = this->storage[first];
+        SwiftyStaticNode secondNode = this->storage[second];
+        firstNode.next = swappedLink(firstNode.next, first, second);
+        firstNode.previous = swappedLink(firstNode.previous, first, second);
+        secondNode.next = swappedLink(secondNode.next, first, second);
+        secondNode.previous = swappedLink(secondNode.previous, first, second);
+        this->storage[second] = firstNode;
+        this->storage[first] = secondNode;
+        this->relink(first);
+        this->relink(second);
+    }
+
+    static constexpr Index swappedLink(Index link, size_t first, size_t second) {
+        if (link == first)
+            return (Index) second;
+        if (link == second)
+            return (Index) first;
+        return link;
+    }
+
+    /**
+     * Points neighbours of the cell back to it
+     */
+    constexpr void relink(size_t pos) {
+        this->storage[this->storage[pos].previous].next = (Index) pos;
+        this->storage[this->storage[pos].next].previous = (Index) pos;
+    }
+
+public:
+    constexpr SwiftyStaticList() : storage(), size(0), freePtr(0), freeSize(0), optimized(true) {}
+
+    /**
+     * Convert logic position to the physic one
+     */
+    constexpr size_t logicToPhysic(size_t pos) const {
+        if (this->optimized)
+            return pos + 1;
+        size_t iterator = 0;
+        if (pos < this->size / 2) {
+            for (size_t i = 0; i <= pos; i++)
+                iterator = this->storage[iterator].next;
+        } else {
+            for (size_t i = this->size; i > pos; i--)
+                iterator = this->storage[iterator].previous;
+        }
+        return iterator;
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - physical pos of considered element, 0 to insert at the beginning
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    constexpr ListOpResult insertAfter(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (pos > this->sumSize())
+            return LIST_OP_OVERFLOW;
+        if (pos != 0 && !this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        size_t newPos = this->getFreePos();
+        if (newPos == 0)
+            return LIST_OP_NOMEM;
+        if (pos != this->storage[0].previous)
+            this->optimized = false;
+
+        this->storage[newPos].value = value;
+        this->storage[newPos].previous = (Index) pos;
+        this->storage[newPos].next = this->storage[pos].next;
+        this->storage[this->storage[pos].next].previous = (Index) newPos;
+        this->storage[pos].next = (Index) newPos;
+        this->size++;
+
+        if (physPos != nullptr)
+            *physPos = newPos;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    constexpr ListOpResult insertAfterLogic(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->insertAfter(this->logicToPhysic(pos), value, physPos);
+    }
+
+    /**
+     * Insert an element before pos
+     * @param pos - physical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    constexpr ListOpResult insertBefore(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (pos > this->sumSize())
+            return LIST_OP_OVERFLOW;
+        if (!this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        return this->insertAfter(this->storage[pos].previous, value, physPos);
+    }
+
+    /**
+     * Insert an element before pos
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    constexpr ListOpResult insertBeforeLogic(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->insertBefore(this->logicToPhysic(pos), value, physPos);
+    }
+
+    /**
+     * Insert an element at the first position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    constexpr ListOpResult pushFront(const ListElem value, size_t* physPos=nullptr) {
+        return this->insertAfter(0, value, physPos);
+    }
+
+    /**
+     * Insert an element at the last position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    constexpr ListOpResult pushBack(const ListElem value, size_t* physPos=nullptr) {
+        return this->insertAfter(this->storage[0].previous, value, physPos);
+    }
+
+    /**
+     * Set an element at the physical position pos to the new value
+     * @param pos - physical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    constexpr ListOpResult set(size_t pos, const ListElem value) {
+        if (!this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        this->storage[pos].value = value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Set an element at the logical position pos to the new value
+     * @param pos - logical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    constexpr ListOpResult setLogic(size_t pos, const ListElem value) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->set(this->logicToPhysic(pos), value);
+    }
+
+    /**
+     * Get an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    constexpr ListOpResult get(size_t pos, ListElem* value) const {
+        if (!this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        if (value != nullptr)
+            *value = this->storage[pos].value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    constexpr ListOpResult getLogic(size_t pos, ListElem* value=nullptr) const {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->get(this->logicToPhysic(pos), value);
+    }
+
+    /**
+     * Retrieve an element at the physical position pos and remove it
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    constexpr ListOpResult pop(size_t pos, ListElem *value=nullptr) {
+        if (this->size == 0)
+            return LIST_OP_UNDERFLOW;
+        if (!this->addressValid(pos))
+            return LIST_OP_SEGFAULT;
+        if (pos != this->storage[0].previous)
+            this->optimized = false;
+
+        if (value != nullptr)
+            *value = this->storage[pos].value;
+        this->storage[this->storage[pos].next].previous = this->storage[pos].previous;
+        this->storage[this->storage[pos].previous].next = this->storage[pos].next;
+        this->addFreePos(pos);
+        this->size--;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Retrieve an element at the beginning and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    constexpr ListOpResult popFront(ListElem *value) {
+        return this->pop(this->storage[0].next, value);
+    }
+
+    /**
+     * Retrieve an element at the end and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    constexpr ListOpResult popBack(ListElem *value) {
+        return this->pop(this->storage[0].previous, value);
+    }
+
+    /**
+     * Retrieve an element at the logical position pos and remove it
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    constexpr ListOpResult popLogic(size_t pos, ListElem *value) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->pop(this->logicToPhysic(pos), value);
+    }
+
+    /**
+     * Remove an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @return operation result
+     */
+    constexpr ListOpResult remove(size_t pos) {
+        return this->pop(pos, nullptr);
+    }
+
+    /**
+     * Remove an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @return operation result
+     */
+    constexpr ListOpResult removeLogic(size_t pos) {
+        return this->popLogic(pos, nullptr);
+    }
+
+    /**
+     * Swap two elements at the physical positions
+     * @param firstPos - physical pos of the first element
+     * @param secondPos - physical pos of the second element
+     * @return operation result
+     */
+    constexpr ListOpResult swap(size_t firstPos, size_t secondPos) {
+        if (!this->addressValid(firstPos) || !this->addressValid(secondPos))
+            return LIST_OP_SEGFAULT;
+        ListElem tmp = this->storage[firstPos].value;
+        this->storage[firstPos].value = this->storage[secondPos].value;
+        this->storage[secondPos].value = tmp;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Swap two elements at the logical positions
+     * @param firstPos - logical pos of the first element
+     * @param secondPos - logical pos of the second element
+     * @return operation result
+     */
+    constexpr ListOpResult swapLogic(size_t firstPos, size_t secondPos) {
+        if (firstPos >= this->size || secondPos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->swap(this->logicToPhysic(firstPos), this->logicToPhysic(secondPos));
+    }
+
+    /**
+     * Search an element in the list. Retrieves the logical position
+     * @param pos - logical pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    constexpr ListOpResult searchLogic(size_t *pos, const ListElem value) const {
+        size_t iterator = this->storage[0].next;
+        for (size_t i = 0; i < this->size; i++) {
+            if (this->storage[iterator].value == value) {
+                *pos = i;
+                return LIST_OP_OK;
+            }
+            iterator = this->storage[iterator].next;
+        }
+        return LIST_OP_NOTFOUND;
+    }
+
+    /**
+     * Search an element in the list. Retrieves the physic position
+     * @param pos - physic pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    constexpr ListOpResult search(size_t *pos, const ListElem value) const {
+        for (size_t iterator = this->storage[0].next; iterator != 0; iterator = this->storage[iterator].next) {
+            if (this->storage[iterator].value == value) {
+                *pos = iterator;
+                return LIST_OP_OK;
+            }
+        }
+        return LIST_OP_NOTFOUND;
+    }
+
+    /**
+     * Clears the list
+     * @return operation result
+     */
+    constexpr ListOpResult clear() {
+        this->storage[0].next = 0;
+        this->storage[0].previous = 0;
+        this->size = 0;
+        this->freePtr = 0;
+        this->freeSize = 0;
+        this->optimized = true;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Optimizes the list in place: the element at logical position i is moved
+     * to the physical position i + 1, free cells are dropped
+     * @return operation result
+     */
+    constexpr ListOpResult optimize() {
+        size_t iterator = this->storage[0].next;
+        for (size_t i = 1; i <= this->size; i++) {
+            if (iterator != i) {
+                if (this->storage[i].previous == FREE_MARK) {
+                    this->storage[i] = this->storage[iterator];
+                    this->relink(i);
+                    this->storage[iterator].previous = FREE_MARK;
+                } else {
+                    this->swapCells(iterator, i);
+                }
+            }
+            iterator = this->storage[i].next;
+        }
+        this->freePtr = 0;
+        this->freeSize = 0;
+        this->optimized = true;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Moves iterator to the next physical position
+     * @param pos
+     * @return next position or 0 after the last element
+     */
+    constexpr size_t nextIterator(size_t pos) const {
+        if (!this->addressValid(pos))
+            return 0;
+        return this->storage[pos].next;
+    }
+
+    /**
+     * Moves iterator to the previous physical position
+     * @param pos
+     * @return previous position or 0 before the first element
+     */
+    constexpr size_t prevIterator(size_t pos) const {
+        if (!this->addressValid(pos))
+            return 0;
+        return this->storage[pos].previous;
+    }
+
+    /**
+     * Check up list's integrity
+     * @return operation result
+     */
+    constexpr ListOpResult checkUp() const {
+        if (this->sumSize() > N)
+            return LIST_OP_CORRUPTED;
+        size_t iterator = 0;
+        for (size_t i = 0; i < this->size; i++) {
+            size_t next = this->storage[iterator].next;
+            if (!this->addressValid(next) || this->storage[next].previous != iterator ||
+                (this->optimized && next != i + 1))
+                return LIST_OP_CORRUPTED;
+            iterator = next;
+        }
+        if (this->storage[iterator].next != 0 || this->storage[0].previous != iterator)
+            return LIST_OP_CORRUPTED;
+        size_t freePos = this->freePtr;
+        for (size_t i = 0; i < this->freeSize; i++) {
+            if (freePos == 0 || freePos > this->sumSize() || this->storage[freePos].previous != FREE_MARK)
+                return LIST_OP_CORRUPTED;
+            freePos = this->storage[freePos].next;
+        }
+        return LIST_OP_OK;
+    }
+
+    constexpr size_t begin() const {
+        return this->storage[0].next;
+    }
+
+    constexpr size_t end() const {
+        return this->storage[0].previous;
+    }
+
+    constexpr size_t getSize() const {
+        return this->size;
+    }
+
+    static constexpr size_t getCapacity() {
+        return N;
+    }
+
+    constexpr bool isOptimized() const {
+        return this->optimized;
+    }
+
+    constexpr bool isEmpty() const {
+        return this->size == 0;
+    }
+
+    constexpr bool isFull() const {
+        return this->size == N;
+    }
+
+    constexpr size_t sumSize() const {
+        return (size_t) this->size + this->freeSize;
+    }
+
+    constexpr bool addressValid(size_t pos) const {
+        return pos != 0 && pos <= this->sumSize() && this->storage[pos].previous != FREE_MARK;
+    }
+};
+
+#endif /* SwiftyStaticList_hpp */
@@ -0,0 +1,206 @@
+/**
+ * SwiftyThreadPool - work-stealing thread pool used by parallel list algorithms
+ *
+ * Every worker owns a task deque: it takes its own tasks from the back and
+ * steals from the front of the others' deques when it runs out of work.
+ * Thread waiting for a task group executes pending tasks itself instead of
+ * blocking, so nested parallel calls can not starve the pool.
+ */
+
+#ifndef SwiftyThreadPool_hpp
+#define SwiftyThreadPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct SwiftyThreadPool {
+private:
+    struct TaskQueue {
+        std::mutex                        mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    TaskQueue                *queues;
+    size_t                   queuesCount;
+    std::atomic<size_t>      pending;
+    std::atomic<size_t>      nextQueue;
+    std::mutex               sleepMutex;
+    std::condition_variable  wakeUp;
+    bool                     stopping;
+
+    /**
+     * Index of the queue owned by the calling thread, queuesCount for foreign threads
+     */
+    size_t ownQueue() const {
+        return (currentPool() == this) ? currentWorker() : this->queuesCount;
+    }
+
+    static const SwiftyThreadPool *&currentPool() {
+        static thread_local const SwiftyThreadPool *pool = nullptr;
+        return pool;
+    }
+
+    static size_t &currentWorker() {
+        static thread_local size_t worker = 0;
+        return worker;
+    }
+
+    bool takeTask(size_t self, std::function<void()> &task) {
+        if (self < this->queuesCount) {
+            TaskQueue &own = this->queues[self];
+            std::lock_guard<std::mutex> guard(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        size_t start = (self < this->queuesCount) ? self + 1 : 0;
+        for (size_t i = 0; i < this->queuesCount; i++) {
+            TaskQueue &victim = this->queues[(start + i) % this->queuesCount];
+            std::lock_guard<std::mutex> guard(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t self) {
+        currentPool() = this;
+        currentWorker() = self;
+        while (true) {
+            if (this->runPending())
+                continue;
+            std::unique_lock<std::mutex> lock(this->sleepMutex);
+            this->wakeUp.wait(lock, [this]() {
+                return this->stopping || this->pending.load(std::memory_order_acquire) != 0;
+            });
+            if (this->stopping)
+                return;
+        }
+    }
+
+public:
+    /**
+     * Group of tasks that can be waited for
+     */
+    struct TaskGroup {
+    private:
+        SwiftyThreadPool    *pool;
+        std::atomic<size_t> remaining;
+
+    public:
+        explicit TaskGroup(SwiftyThreadPool &pool) : pool(&pool), remaining(0) {}
+
+        TaskGroup(const TaskGroup &) = delete;
+
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        ~TaskGroup() {
+            this->wait();
+        }
+
+        template<typename Task>
+        void run(Task task) {
+            this->remaining.fetch_add(1, std::memory_order_relaxed);
+            this->pool->submit([this, task]() {
+                task();
+                this->remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        /**
+         * Executes pending tasks until all tasks of the group are finished
+         */
+        void wait() {
+            while (this->remaining.load(std::memory_order_acquire) != 0) {
+                if (!this->pool->runPending())
+                    std::this_thread::yield();
+            }
+        }
+    };
+
+    /**
+     * @param threads - number of worker threads, 0 for hardware concurrency
+     */
+    explicit SwiftyThreadPool(size_t threads = 0) : queues(nullptr), queuesCount(0), pending(0), nextQueue(0),
+                                                    stopping(false) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        this->queuesCount = threads;
+        this->queues = new TaskQueue[threads];
+        for (size_t i = 0; i < threads; i++)
+            this->workers.emplace_back(&SwiftyThreadPool::workerLoop, this, i);
+    }
+
+    SwiftyThreadPool(const SwiftyThreadPool &) = delete;
+
+    SwiftyThreadPool &operator=(const SwiftyThreadPool &) = delete;
+
+    ~SwiftyThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(this->sleepMutex);
+            this->stopping = true;
+        }
+        this->wakeUp.notify_all();
+        for (auto &worker : this->workers)
+            worker.join();
+        delete[] this->queues;
+    }
+
+    /**
+     * Pool shared by parallel algorithms by default
+     */
+    static SwiftyThreadPool &shared() {
+        static SwiftyThreadPool pool;
+        return pool;
+    }
+
+    /**
+     * Queues a task. Workers push to their own deque, other threads spread tasks round-robin.
+     */
+    void submit(std::function<void()> task) {
+        size_t queue = this->ownQueue();
+        if (queue == this->queuesCount)
+            queue = this->nextQueue.fetch_add(1, std::memory_order_relaxed) % this->queuesCount;
+        {
+            std::lock_guard<std::mutex> guard(this->queues[queue].mutex);
+            this->queues[queue].tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> guard(this->sleepMutex);
+            this->pending.fetch_add(1, std::memory_order_release);
+        }
+        this->wakeUp.notify_one();
+    }
+
+    /**
+     * Runs one pending task in the calling thread
+     * @return true if a task was executed
+     */
+    bool runPending() {
+        std::function<void()> task;
+        if (!this->takeTask(this->ownQueue(), task))
+            return false;
+        this->pending.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+        return true;
+    }
+
+    size_t getThreadsCount() const {
+        return this->queuesCount;
+    }
+};
+
+#endif /* SwiftyThreadPool_hpp */
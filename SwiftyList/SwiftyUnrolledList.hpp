@@ -0,0 +1,712 @@
+/**
+ * SwiftyUnrolledList - unrolled SwiftyList for workloads that stay de-optimized
+ *
+ * Every node is a block holding up to K elements in an array, so a logical walk
+ * touches size / K blocks instead of size nodes. Inserting into a full block
+ * splits it in two halves, removing from a block that became sparse merges it
+ * with a neighbour, so middle inserts and removes stay cheap without optimize().
+ *
+ * Physical position of an element is its (block, slot) pair packed as
+ * block * K + slot, 0 is the position before the first element as in SwiftyList.
+ * Elements are moved inside their block by inserts and removes, so physical
+ * positions of elements in the changed block and its neighbours are valid
+ * until the next insert or remove.
+ *
+ * After optimize() blocks are full and laid out in logical order, logical
+ * positions are then converted to physical ones in O(1) until the list is
+ * changed anywhere except its end.
+ */
+
+#ifndef SwiftyUnrolledList_hpp
+#define SwiftyUnrolledList_hpp
+
+#include <cstdlib>
+#include <cstring>
+#include "SwiftyList.hpp"
+
+template<typename ListElem, size_t K = 16>
+struct SwiftyUnrolledList {
+private:
+    static_assert(K >= 2, "Unrolled block must hold at least two elements");
+
+    struct Block {
+        size_t   next;
+        size_t   previous;
+        size_t   count;
+        ListElem values[K];
+    };
+
+    Block  *blocks;
+    size_t blocksCapacity;
+    size_t blocksUsed;
+    size_t freeBlock;
+    size_t size;
+    bool   optimized;
+    bool   useChecks;
+
+    /**
+     * Takes a free block, reallocating blocks if there is none
+     * @return block index or 0 if there is no memory
+     */
+    size_t allocBlock() {
+        size_t block = this->freeBlock;
+        if (block != 0) {
+            this->freeBlock = this->blocks[block].next;
+        } else {
+            if (this->blocksUsed + 1 >= this->blocksCapacity) {
+                size_t newCapacity = this->blocksCapacity * 2;
+                Block *newBlocks = (Block *) realloc(this->blocks, newCapacity * sizeof(Block));
+                if (newBlocks == nullptr)
+                    return 0;
+                this->blocks = newBlocks;
+                this->blocksCapacity = newCapacity;
+            }
+            block = ++this->blocksUsed;
+        }
+        this->blocks[block].count = 0;
+        return block;
+    }
+
+    void freeBlockAt(size_t block) {
+        this->blocks[block].count = 0;
+        this->blocks[block].next = this->freeBlock;
+        this->freeBlock = block;
+    }
+
+    /**
+     * Allocates an empty block and links it after the given one
+     * @return new block or 0 if there is no memory
+     */
+    size_t linkBlockAfter(size_t block) {
+        size_t newBlock = this->allocBlock();
+        if (newBlock == 0)
+            return 0;
+        Block &created = this->blocks[newBlock];
+        created.previous = block;
+        created.next = this->blocks[block].next;
+        this->blocks[created.next].previous = newBlock;
+        this->blocks[block].next = newBlock;
+        return newBlock;
+    }
+
+    void unlinkBlock(size_t block) {
+        Block &removed = this->blocks[block];
+        this->blocks[removed.previous].next = removed.next;
+        this->blocks[removed.next].previous = removed.previous;
+        this->freeBlockAt(block);
+    }
+
+    /**
+     * Finds block and slot of the logical position, walking from the nearer end
+     */
+    void locate(size_t pos, size_t *block, size_t *slot) const {
+        if (this->optimized) {
+            *block = pos / K + 1;
+            *slot = pos % K;
+            return;
+        }
+        if (pos < this->size / 2) {
+            size_t current = this->blocks[0].next;
+            while (pos >= this->blocks[current].count) {
+                pos -= this->blocks[current].count;
+                current = this->blocks[current].next;
+            }
+            *block = current;
+            *slot = pos;
+            return;
+        }
+        size_t fromEnd = this->size - pos;
+        size_t current = this->blocks[0].previous;
+        while (fromEnd > this->blocks[current].count) {
+            fromEnd -= this->blocks[current].count;
+            current = this->blocks[current].previous;
+        }
+        *block = current;
+        *slot = this->blocks[current].count - fromEnd;
+    }
+
+    /**
+     * Inserts value so that it takes the slot of the block
+     * @param slot - slot in [0, count]
+     * @return operation result
+     */
+    ListOpResult insertAt(size_t block, size_t slot, const ListElem &value, size_t *physPos) {
+        bool atEnd = (block == this->blocks[0].previous && slot == this->blocks[block].count);
+        if (this->blocks[block].count == K) {
+            size_t previous = this->blocks[block].previous;
+            if (slot == 0 && previous != 0 && this->blocks[previous].count < K) {
+                block = previous;
+                slot = this->blocks[previous].count;
+            } else if (slot == 0 || slot == K) {
+                size_t newBlock = this->linkBlockAfter(slot == 0 ? previous : block);
+                if (newBlock == 0)
+                    return LIST_OP_NOMEM;
+                if (!(atEnd && newBlock == block + 1))
+                    this->optimized = false;
+                block = newBlock;
+                slot = 0;
+                atEnd = true;
+            } else {
+                size_t newBlock = this->linkBlockAfter(block);
+                if (newBlock == 0)
+                    return LIST_OP_NOMEM;
+                const size_t half = K / 2;
+                memcpy(this->blocks[newBlock].values, this->blocks[block].values + half,
+                       (K - half) * sizeof(ListElem));
+                this->blocks[newBlock].count = K - half;
+                this->blocks[block].count = half;
+                if (slot > half) {
+                    block = newBlock;
+                    slot -= half;
+                }
+            }
+        }
+        if (!atEnd)
+            this->optimized = false;
+        Block &target = this->blocks[block];
+        memmove(target.values + slot + 1, target.values + slot, (target.count - slot) * sizeof(ListElem));
+        target.values[slot] = value;
+        target.count++;
+        this->size++;
+        if (physPos != nullptr)
+            *physPos = block * K + slot;
+        return this->checked();
+    }
+
+    /**
+     * Removes the element, merging sparse block with a neighbour
+     */
+    ListOpResult removeAt(size_t block, size_t slot, ListElem *value) {
+        Block &target = this->blocks[block];
+        if (!(block == this->blocks[0].previous && slot + 1 == target.count))
+            this->optimized = false;
+        if (value != nullptr)
+            *value = target.values[slot];
+        memmove(target.values + slot, target.values + slot + 1, (target.count - slot - 1) * sizeof(ListElem));
+        target.count--;
+        this->size--;
+        if (target.count == 0) {
+            this->unlinkBlock(block);
+        } else if (target.count < K / 4) {
+            size_t next = target.next;
+            size_t previous = target.previous;
+            if (next != 0 && target.count + this->blocks[next].count <= K) {
+                this->appendBlock(block, next);
+                this->optimized = false;
+            } else if (previous != 0 && this->blocks[previous].count + target.count <= K) {
+                this->appendBlock(previous, block);
+                this->optimized = false;
+            }
+        }
+        return this->checked();
+    }
+
+    /**
+     * Moves all elements of source to the end of target and frees source
+     */
+    void appendBlock(size_t target, size_t source) {
+        Block &to = this->blocks[target];
+        Block &from = this->blocks[source];
+        memcpy(to.values + to.count, from.values, from.count * sizeof(ListElem));
+        to.count += from.count;
+        this->unlinkBlock(source);
+    }
+
+    bool unpack(size_t pos, size_t *block, size_t *slot) const {
+        *block = pos / K;
+        *slot = pos % K;
+        return this->addressValid(pos);
+    }
+
+    ListOpResult checked() const {
+        if (this->useChecks)
+            return this->checkUp();
+        return LIST_OP_OK;
+    }
+
+public:
+    /**
+     * @param initialSize - number of elements to reserve space for
+     * @param useChecks - check integrity after every modification
+     */
+    SwiftyUnrolledList(size_t initialSize, bool useChecks) : blocks(nullptr), blocksCapacity(0), blocksUsed(0),
+                                                            freeBlock(0), size(0), optimized(true),
+                                                            useChecks(useChecks) {
+        this->blocksCapacity = initialSize / K + 2;
+        this->blocks = (Block *) calloc(this->blocksCapacity, sizeof(Block));
+        if (this->blocks == nullptr)
+            this->blocksCapacity = 0;
+    }
+
+    SwiftyUnrolledList(const SwiftyUnrolledList &) = delete;
+
+    SwiftyUnrolledList &operator=(const SwiftyUnrolledList &) = delete;
+
+    ~SwiftyUnrolledList() {
+        free(this->blocks);
+    }
+
+    /**
+     * Convert logic position to the physic one
+     */
+    size_t logicToPhysic(size_t pos) const {
+        size_t block = 0, slot = 0;
+        this->locate(pos, &block, &slot);
+        return block * K + slot;
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - physical pos of considered element, 0 to insert at the beginning
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertAfter(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        if (pos == 0)
+            return this->pushFront(value, physPos);
+        size_t block = 0, slot = 0;
+        if (!this->unpack(pos, &block, &slot))
+            return LIST_OP_SEGFAULT;
+        return this->insertAt(block, slot + 1, value, physPos);
+    }
+
+    /**
+     * Insert an element after pos
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertAfterLogic(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        size_t block = 0, slot = 0;
+        this->locate(pos, &block, &slot);
+        return this->insertAt(block, slot + 1, value, physPos);
+    }
+
+    /**
+     * Insert an element before pos
+     * @param pos - physical pos of considered element, 0 to insert at the end
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertBefore(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        if (pos == 0)
+            return this->pushBack(value, physPos);
+        size_t block = 0, slot = 0;
+        if (!this->unpack(pos, &block, &slot))
+            return LIST_OP_SEGFAULT;
+        return this->insertAt(block, slot, value, physPos);
+    }
+
+    /**
+     * Insert an element before pos
+     * @param pos - logical pos of considered element
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult insertBeforeLogic(size_t pos, ListElem value, size_t* physPos=nullptr) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        size_t block = 0, slot = 0;
+        this->locate(pos, &block, &slot);
+        return this->insertAt(block, slot, value, physPos);
+    }
+
+    /**
+     * Insert an element at the first position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult pushFront(const ListElem value, size_t* physPos=nullptr) {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        if (this->size == 0)
+            return this->pushBack(value, physPos);
+        return this->insertAt(this->blocks[0].next, 0, value, physPos);
+    }
+
+    /**
+     * Insert an element at the last position
+     * @param value - value to be inserted
+     * @param physPos - physical position of inserted element
+     * @return operation result
+     */
+    ListOpResult pushBack(const ListElem value, size_t* physPos=nullptr) {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        if (this->size == 0) {
+            size_t block = this->linkBlockAfter(0);
+            if (block == 0)
+                return LIST_OP_NOMEM;
+            this->optimized = (block == 1);
+            return this->insertAt(block, 0, value, physPos);
+        }
+        size_t tail = this->blocks[0].previous;
+        return this->insertAt(tail, this->blocks[tail].count, value, physPos);
+    }
+
+    /**
+     * Set an element at the physical position pos to the new value
+     * @param pos - physical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult set(size_t pos, const ListElem value) {
+        size_t block = 0, slot = 0;
+        if (!this->unpack(pos, &block, &slot))
+            return LIST_OP_SEGFAULT;
+        this->blocks[block].values[slot] = value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Set an element at the logical position pos to the new value
+     * @param pos - logical pos of considered element
+     * @param value - new value
+     * @return operation result
+     */
+    ListOpResult setLogic(size_t pos, const ListElem value) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        size_t block = 0, slot = 0;
+        this->locate(pos, &block, &slot);
+        this->blocks[block].values[slot] = value;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult get(size_t pos, ListElem* value) const {
+        size_t block = 0, slot = 0;
+        if (!this->unpack(pos, &block, &slot))
+            return LIST_OP_SEGFAULT;
+        if (value != nullptr)
+            *value = this->blocks[block].values[slot];
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Get an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult getLogic(size_t pos, ListElem* value=nullptr) const {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        size_t block = 0, slot = 0;
+        this->locate(pos, &block, &slot);
+        if (value != nullptr)
+            *value = this->blocks[block].values[slot];
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Retrieve an element at the physical position pos and remove it
+     * @param pos - physical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult pop(size_t pos, ListElem *value=nullptr) {
+        if (this->size == 0)
+            return LIST_OP_UNDERFLOW;
+        size_t block = 0, slot = 0;
+        if (!this->unpack(pos, &block, &slot))
+            return LIST_OP_SEGFAULT;
+        return this->removeAt(block, slot, value);
+    }
+
+    /**
+     * Retrieve an element at the beginning and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popFront(ListElem *value) {
+        if (this->size == 0)
+            return LIST_OP_UNDERFLOW;
+        return this->removeAt(this->blocks[0].next, 0, value);
+    }
+
+    /**
+     * Retrieve an element at the end and remove it
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popBack(ListElem *value) {
+        if (this->size == 0)
+            return LIST_OP_UNDERFLOW;
+        size_t tail = this->blocks[0].previous;
+        return this->removeAt(tail, this->blocks[tail].count - 1, value);
+    }
+
+    /**
+     * Retrieve an element at the logical position pos and remove it
+     * @param pos - logical pos of considered element
+     * @param value - retrieved value
+     * @return operation result
+     */
+    ListOpResult popLogic(size_t pos, ListElem *value) {
+        if (pos >= this->size)
+            return LIST_OP_OVERFLOW;
+        size_t block = 0, slot = 0;
+        this->locate(pos, &block, &slot);
+        return this->removeAt(block, slot, value);
+    }
+
+    /**
+     * Remove an element at the physical position pos
+     * @param pos - physical pos of considered element
+     * @return operation result
+     */
+    ListOpResult remove(size_t pos) {
+        return this->pop(pos, nullptr);
+    }
+
+    /**
+     * Remove an element at the logical position pos
+     * @param pos - logical pos of considered element
+     * @return operation result
+     */
+    ListOpResult removeLogic(size_t pos) {
+        return this->popLogic(pos, nullptr);
+    }
+
+    /**
+     * Swap two elements at the physical positions
+     * @param firstPos - physical pos of the first element
+     * @param secondPos - physical pos of the second element
+     * @return operation result
+     */
+    ListOpResult swap(size_t firstPos, size_t secondPos) {
+        if (!this->addressValid(firstPos) || !this->addressValid(secondPos))
+            return LIST_OP_SEGFAULT;
+        ListElem &first = this->blocks[firstPos / K].values[firstPos % K];
+        ListElem &second = this->blocks[secondPos / K].values[secondPos % K];
+        ListElem tmp = first;
+        first = second;
+        second = tmp;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Swap two elements at the logical positions
+     * @param firstPos - logical pos of the first element
+     * @param secondPos - logical pos of the second element
+     * @return operation result
+     */
+    ListOpResult swapLogic(size_t firstPos, size_t secondPos) {
+        if (firstPos >= this->size || secondPos >= this->size)
+            return LIST_OP_OVERFLOW;
+        return this->swap(this->logicToPhysic(firstPos), this->logicToPhysic(secondPos));
+    }
+
+    /**
+     * Search an element in the list. Retrieves the logical position
+     * @param pos - logical pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult searchLogic(size_t *pos, const ListElem value) const {
+        size_t passed = 0;
+        for (size_t block = this->blocks[0].next; block != 0; block = this->blocks[block].next) {
+            const Block &current = this->blocks[block];
+            for (size_t slot = 0; slot < current.count; slot++) {
+                if (current.values[slot] == value) {
+                    *pos = passed + slot;
+                    return LIST_OP_OK;
+                }
+            }
+            passed += current.count;
+        }
+        return LIST_OP_NOTFOUND;
+    }
+
+    /**
+     * Search an element in the list. Retrieves the physic position
+     * @param pos - physic pos of considered element
+     * @param value - searched value
+     * @return operation result
+     */
+    ListOpResult search(size_t *pos, const ListElem value) const {
+        for (size_t block = this->blocks[0].next; block != 0; block = this->blocks[block].next) {
+            const Block &current = this->blocks[block];
+            for (size_t slot = 0; slot < current.count; slot++) {
+                if (current.values[slot] == value) {
+                    *pos = block * K + slot;
+                    return LIST_OP_OK;
+                }
+            }
+        }
+        return LIST_OP_NOTFOUND;
+    }
+
+    /**
+     * Clears the list, allocated blocks are kept
+     * @return operation result
+     */
+    ListOpResult clear() {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        this->blocks[0].next = 0;
+        this->blocks[0].previous = 0;
+        this->blocksUsed = 0;
+        this->freeBlock = 0;
+        this->size = 0;
+        this->optimized = true;
+        return LIST_OP_OK;
+    }
+
+    /**
+     * Packs elements into full blocks laid out in logical order
+     * @return operation result
+     */
+    ListOpResult optimize() {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        size_t used = (this->size + K - 1) / K;
+        size_t newCapacity = used + 2;
+        if (newCapacity < this->blocksCapacity)
+            newCapacity = this->blocksCapacity;
+        Block *newBlocks = (Block *) calloc(newCapacity, sizeof(Block));
+        if (newBlocks == nullptr)
+            return LIST_OP_NOMEM;
+        size_t written = 0;
+        for (size_t block = this->blocks[0].next; block != 0; block = this->blocks[block].next) {
+            const Block &current = this->blocks[block];
+            for (size_t slot = 0; slot < current.count; slot++, written++)
+                newBlocks[written / K + 1].values[written % K] = current.values[slot];
+        }
+        for (size_t block = 1; block <= used; block++) {
+            newBlocks[block].previous = block - 1;
+            newBlocks[block].next = (block == used) ? 0 : block + 1;
+            newBlocks[block].count = (block == used) ? this->size - (used - 1) * K : K;
+        }
+        newBlocks[0].next = (used == 0) ? 0 : 1;
+        newBlocks[0].previous = used;
+        free(this->blocks);
+        this->blocks = newBlocks;
+        this->blocksCapacity = newCapacity;
+        this->blocksUsed = used;
+        this->freeBlock = 0;
+        this->optimized = true;
+        return this->checked();
+    }
+
+    /**
+     * Moves iterator to the next physical position
+     * @param pos
+     * @return next position or 0 after the last element
+     */
+    size_t nextIterator(size_t pos) const {
+        if (!this->addressValid(pos))
+            return 0;
+        size_t block = pos / K;
+        size_t slot = pos % K;
+        if (slot + 1 < this->blocks[block].count)
+            return pos + 1;
+        return this->blocks[block].next * K;
+    }
+
+    /**
+     * Moves iterator to the previous physical position
+     * @param pos
+     * @return previous position or 0 before the first element
+     */
+    size_t prevIterator(size_t pos) const {
+        if (!this->addressValid(pos))
+            return 0;
+        size_t block = pos / K;
+        size_t slot = pos % K;
+        if (slot > 0)
+            return pos - 1;
+        size_t previous = this->blocks[block].previous;
+        if (previous == 0)
+            return 0;
+        return previous * K + this->blocks[previous].count - 1;
+    }
+
+    /**
+     * Check up list's integrity
+     * @return operation result
+     */
+    ListOpResult checkUp() const {
+        if (this->blocks == nullptr)
+            return LIST_OP_NOMEM;
+        size_t counted = 0;
+        size_t visited = 0;
+        size_t previous = 0;
+        for (size_t block = this->blocks[0].next; block != 0; block = this->blocks[block].next) {
+            if (block > this->blocksUsed || ++visited > this->blocksUsed)
+                return LIST_OP_CORRUPTED;
+            const Block &current = this->blocks[block];
+            if (current.previous != previous || current.count == 0 || current.count > K)
+                return LIST_OP_CORRUPTED;
+            if (this->optimized && (block != visited || (current.next != 0 && current.count != K)))
+                return LIST_OP_CORRUPTED;
+            counted += current.count;
+            previous = block;
+        }
+        if (previous != this->blocks[0].previous || counted != this->size)
+            return LIST_OP_CORRUPTED;
+        return LIST_OP_OK;
+    }
+
+    size_t begin() const {
+        return this->blocks[0].next * K;
+    }
+
+    size_t end() const {
+        size_t tail = this->blocks[0].previous;
+        return (tail == 0) ? 0 : tail * K + this->blocks[tail].count - 1;
+    }
+
+    size_t getSize() const {
+        return this->size;
+    }
+
+    /**
+     * Number of elements that fit into allocated blocks
+     */
+    size_t getCapacity() const {
+        return (this->blocksCapacity == 0) ? 0 : (this->blocksCapacity - 1) * K;
+    }
+
+    /**
+     * Number of blocks holding elements
+     */
+    size_t getBlocksCount() const {
+        size_t count = 0;
+        for (size_t block = this->blocks[0].next; block != 0; block = this->blocks[block].next)
+            count++;
+        return count;
+    }
+
+    bool isOptimized() const {
+        return this->optimized;
+    }
+
+    bool isEmpty() const {
+        return this->size == 0;
+    }
+
+    bool addressValid(size_t pos) const {
+        size_t block = pos / K;
+        return block != 0 && block <= this->blocksUsed && pos % K < this->blocks[block].count;
+    }
+};
+
+#endif /* SwiftyUnrolledList_hpp */
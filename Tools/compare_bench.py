@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""
+Compares two SwiftyListBench JSON results and flags regressions.
+
+    ./SwiftyListBench --benchmark_out=baseline.json
+    ./SwiftyListBench --benchmark_out=current.json
+    Tools/compare_bench.py baseline.json current.json --threshold 10
+
+Exit code is 1 if any benchmark got slower by more than threshold percent.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path, metric):
+    with open(path) as file:
+        data = json.load(file)
+    results = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "median":
+            continue
+        name = bench.get("run_name", bench["name"])
+        results[name] = bench[metric]
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag SwiftyListBench regressions")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="cpu_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+
+    regressions = 0
+    width = max([len(name) for name in current] + [9])
+    print("%-*s %14s %14s %9s" % (width, "benchmark", "baseline", "current", "change"))
+    for name, time in current.items():
+        if name not in baseline:
+            print("%-*s %14s %14.1f %9s" % (width, name, "-", time, "new"))
+            continue
+        change = (time / baseline[name] - 1.0) * 100.0 if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%-*s %14.1f %14.1f %+8.1f%%%s" % (width, name, baseline[name], time, change, flag))
+    for name in baseline:
+        if name not in current:
+            print("%-*s %14.1f %14s %9s" % (width, name, baseline[name], "-", "removed"))
+
+    if regressions != 0:
+        print("\n%d benchmark(s) regressed by more than %.1f%%" % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())